@@ -23,6 +23,14 @@ UNIFYFS_DEF(open64, int, (const char* path, int flags, ...));
 UNIFYFS_DEF(__open_2, int, (const char* path, int flags, ...));
 UNIFYFS_DEF(lio_listio, int, (int mode, struct aiocb* const aiocb_list[],
                               int nitems, struct sigevent* sevp));
+UNIFYFS_DEF(aio_read, int, (struct aiocb* cbp));
+UNIFYFS_DEF(aio_write, int, (struct aiocb* cbp));
+UNIFYFS_DEF(aio_error, int, (const struct aiocb* cbp));
+UNIFYFS_DEF(aio_return, ssize_t, (struct aiocb* cbp));
+UNIFYFS_DEF(aio_cancel, int, (int fd, struct aiocb* cbp));
+UNIFYFS_DEF(aio_fsync, int, (int op, struct aiocb* cbp));
+UNIFYFS_DEF(aio_suspend, int, (const struct aiocb* const aiocb_list[],
+                               int nitems, const struct timespec* timeout));
 UNIFYFS_DEF(lseek, off_t, (int fd, off_t offset, int whence));
 UNIFYFS_DEF(lseek64, off64_t, (int fd, off64_t offset, int whence));
 UNIFYFS_DEF(posix_fadvise, int, (int fd, off_t offset, off_t len, int advice));
@@ -30,6 +38,14 @@ UNIFYFS_DEF(read, ssize_t, (int fd, void* buf, size_t count));
 UNIFYFS_DEF(write, ssize_t, (int fd, const void* buf, size_t count));
 UNIFYFS_DEF(readv, ssize_t, (int fd, const struct iovec* iov, int iovcnt));
 UNIFYFS_DEF(writev, ssize_t, (int fd, const struct iovec* iov, int iovcnt));
+UNIFYFS_DEF(preadv, ssize_t, (int fd, const struct iovec* iov, int iovcnt,
+                              off_t offset));
+UNIFYFS_DEF(preadv64, ssize_t, (int fd, const struct iovec* iov, int iovcnt,
+                                off64_t offset));
+UNIFYFS_DEF(pwritev, ssize_t, (int fd, const struct iovec* iov, int iovcnt,
+                               off_t offset));
+UNIFYFS_DEF(pwritev64, ssize_t, (int fd, const struct iovec* iov, int iovcnt,
+                                 off64_t offset));
 UNIFYFS_DEF(pread, ssize_t, (int fd, void* buf, size_t count, off_t offset));
 UNIFYFS_DEF(pread64, ssize_t, (int fd, void* buf, size_t count,
                                off64_t offset));
@@ -127,6 +143,13 @@ struct gotcha_binding_t wrap_unifyfs_list[] = {
     { "open64", UNIFYFS_WRAP(open64), &UNIFYFS_REAL(open64) },
     { "__open_2", UNIFYFS_WRAP(__open_2), &UNIFYFS_REAL(__open_2) },
     { "lio_listio", UNIFYFS_WRAP(lio_listio), &UNIFYFS_REAL(lio_listio) },
+    { "aio_read", UNIFYFS_WRAP(aio_read), &UNIFYFS_REAL(aio_read) },
+    { "aio_write", UNIFYFS_WRAP(aio_write), &UNIFYFS_REAL(aio_write) },
+    { "aio_error", UNIFYFS_WRAP(aio_error), &UNIFYFS_REAL(aio_error) },
+    { "aio_return", UNIFYFS_WRAP(aio_return), &UNIFYFS_REAL(aio_return) },
+    { "aio_cancel", UNIFYFS_WRAP(aio_cancel), &UNIFYFS_REAL(aio_cancel) },
+    { "aio_fsync", UNIFYFS_WRAP(aio_fsync), &UNIFYFS_REAL(aio_fsync) },
+    { "aio_suspend", UNIFYFS_WRAP(aio_suspend), &UNIFYFS_REAL(aio_suspend) },
     { "lseek", UNIFYFS_WRAP(lseek), &UNIFYFS_REAL(lseek) },
     { "lseek64", UNIFYFS_WRAP(lseek64), &UNIFYFS_REAL(lseek64) },
     { "posix_fadvise", UNIFYFS_WRAP(posix_fadvise), &UNIFYFS_REAL(posix_fadvise) },
@@ -134,6 +157,10 @@ struct gotcha_binding_t wrap_unifyfs_list[] = {
     { "write", UNIFYFS_WRAP(write), &UNIFYFS_REAL(write) },
     { "readv", UNIFYFS_WRAP(readv), &UNIFYFS_REAL(readv) },
     { "writev", UNIFYFS_WRAP(writev), &UNIFYFS_REAL(writev) },
+    { "preadv", UNIFYFS_WRAP(preadv), &UNIFYFS_REAL(preadv) },
+    { "preadv64", UNIFYFS_WRAP(preadv64), &UNIFYFS_REAL(preadv64) },
+    { "pwritev", UNIFYFS_WRAP(pwritev), &UNIFYFS_REAL(pwritev) },
+    { "pwritev64", UNIFYFS_WRAP(pwritev64), &UNIFYFS_REAL(pwritev64) },
     { "pread", UNIFYFS_WRAP(pread), &UNIFYFS_REAL(pread) },
     { "pread64", UNIFYFS_WRAP(pread64), &UNIFYFS_REAL(pread64) },
     { "pwrite", UNIFYFS_WRAP(pwrite), &UNIFYFS_REAL(pwrite) },
@@ -14,18 +14,6 @@ static void register_client_rpcs(void)
 {
     margo_instance_id mid = client_rpc_context->mid;
 
-    client_rpc_context->rpcs.read_id =
-        MARGO_REGISTER(mid, "unifyfs_read_rpc",
-                       unifyfs_read_in_t,
-                       unifyfs_read_out_t,
-                       NULL);
-
-    client_rpc_context->rpcs.mread_id =
-        MARGO_REGISTER(mid, "unifyfs_mread_rpc",
-                       unifyfs_mread_in_t,
-                       unifyfs_mread_out_t,
-                       NULL);
-
     client_rpc_context->rpcs.mount_id   =
         MARGO_REGISTER(mid, "unifyfs_mount_rpc",
                        unifyfs_mount_in_t,
@@ -193,6 +181,8 @@ int invoke_client_mount_rpc(void)
     unifyfs_key_slice_range = out.max_recs_per_slice;
     LOGDBG("set unifyfs_key_slice_range=%zu", unifyfs_key_slice_range);
 
+    shm_bell_id = (int) out.bell_id;
+
     margo_free_output(handle, &out);
     margo_destroy(handle);
     return ret;
@@ -284,7 +274,7 @@ int invoke_client_metaset_rpc(unifyfs_file_attr_t* f_meta)
 }
 
 /* invokes the client metaget rpc function */
-int invoke_client_metaget_rpc(int gfid,
+int invoke_client_metaget_rpc(uint64_t gfid,
                               unifyfs_file_attr_t* file_meta)
 {
     hg_handle_t handle;
@@ -304,7 +294,7 @@ int invoke_client_metaget_rpc(int gfid,
     assert(hret == HG_SUCCESS);
 
     /* fill in input struct */
-    in.gfid = (int32_t)gfid;
+    in.gfid = gfid;
     LOGDBG("invoking the metaget rpc function in client");
     hret = margo_forward(handle, &in);
     assert(hret == HG_SUCCESS);
@@ -336,7 +326,7 @@ int invoke_client_metaget_rpc(int gfid,
 }
 
 /* invokes the client fsync rpc function */
-int invoke_client_fsync_rpc(int gfid)
+int invoke_client_fsync_rpc(uint64_t gfid)
 {
     hg_handle_t handle;
     unifyfs_fsync_in_t in;
@@ -357,7 +347,8 @@ int invoke_client_fsync_rpc(int gfid)
     /* fill in input struct */
     in.app_id         = (int32_t)app_id;
     in.local_rank_idx = (int32_t)local_rank_idx;
-    in.gfid           = (int32_t)gfid;
+    in.gfid           = gfid;
+    in.async          = (int32_t)unifyfs_async_fsync;
 
     LOGDBG("invoking the fsync rpc function in client");
     hret = margo_forward(handle, &in);
@@ -375,7 +366,7 @@ int invoke_client_fsync_rpc(int gfid)
 }
 
 /* invokes the client filesize rpc function */
-int invoke_client_filesize_rpc(int gfid,
+int invoke_client_filesize_rpc(uint64_t gfid,
                                size_t* outsize)
 {
     int32_t ret;
@@ -396,7 +387,7 @@ int invoke_client_filesize_rpc(int gfid,
     unifyfs_filesize_in_t in;
     in.app_id         = (int32_t)app_id;
     in.local_rank_idx = (int32_t)local_rank_idx;
-    in.gfid           = (int32_t)gfid;
+    in.gfid           = gfid;
 
     /* call rpc function */
     LOGDBG("invoking the filesize rpc function in client");
@@ -418,95 +409,3 @@ int invoke_client_filesize_rpc(int gfid,
     margo_destroy(handle);
     return (int)ret;
 }
-
-/* invokes the client read rpc function */
-int invoke_client_read_rpc(int gfid,
-                           size_t offset,
-                           size_t length)
-{
-    hg_handle_t handle;
-    unifyfs_read_in_t in;
-    unifyfs_read_out_t out;
-    hg_return_t hret;
-    int32_t ret;
-
-    if (NULL == client_rpc_context) {
-        return UNIFYFS_FAILURE;
-    }
-
-    /* fill in input struct */
-    hret = margo_create(client_rpc_context->mid,
-                        client_rpc_context->svr_addr,
-                        client_rpc_context->rpcs.read_id,
-                        &handle);
-    assert(hret == HG_SUCCESS);
-
-    /* fill in input struct */
-    in.app_id         = (int32_t)app_id;
-    in.local_rank_idx = (int32_t)local_rank_idx;
-    in.gfid           = (int32_t)gfid;
-    in.offset         = (hg_size_t)offset;
-    in.length         = (hg_size_t)length;
-
-    LOGDBG("invoking the read rpc function in client");
-    hret = margo_forward(handle, &in);
-    assert(hret == HG_SUCCESS);
-
-    /* decode response */
-    hret = margo_get_output(handle, &out);
-    assert(hret == HG_SUCCESS);
-    ret = out.ret;
-    LOGDBG("Got response ret=%" PRIi32, ret);
-
-    margo_free_output(handle, &out);
-    margo_destroy(handle);
-    return (int)ret;
-}
-
-/* invokes the client mread rpc function */
-int invoke_client_mread_rpc(int read_count,
-                            size_t size,
-                            void* buffer)
-{
-    hg_handle_t handle;
-    unifyfs_mread_in_t in;
-    unifyfs_mread_out_t out;
-    hg_return_t hret;
-    int32_t ret;
-
-    if (NULL == client_rpc_context) {
-        return UNIFYFS_FAILURE;
-    }
-
-    /* fill in input struct */
-    hret = margo_create(client_rpc_context->mid,
-                        client_rpc_context->svr_addr,
-                        client_rpc_context->rpcs.mread_id,
-                        &handle);
-    assert(hret == HG_SUCCESS);
-
-    hret = margo_bulk_create(client_rpc_context->mid, 1, &buffer, &size,
-                             HG_BULK_READ_ONLY, &in.bulk_handle);
-    assert(hret == HG_SUCCESS);
-
-    /* fill in input struct */
-    in.app_id         = (int32_t)app_id;
-    in.local_rank_idx = (int32_t)local_rank_idx;
-    in.read_count     = (int32_t)read_count;
-    in.bulk_size      = (hg_size_t)size;
-
-    LOGDBG("invoking the read rpc function in client");
-    hret = margo_forward(handle, &in);
-    assert(hret == HG_SUCCESS);
-
-    /* decode response */
-    hret = margo_get_output(handle, &out);
-    assert(hret == HG_SUCCESS);
-    ret = out.ret;
-    LOGDBG("Got response ret=%" PRIi32, ret);
-
-    margo_bulk_free(in.bulk_handle);
-    margo_free_output(handle, &out);
-    margo_destroy(handle);
-    return (int)ret;
-}
@@ -100,7 +100,7 @@ DIR* UNIFYFS_WRAP(opendir)(const char* name)
      */
 
     int fid  = unifyfs_get_fid_from_path(name);
-    int gfid = unifyfs_generate_gfid(name);
+    uint64_t gfid = unifyfs_gfid_from_path(name, fid);
 
     unifyfs_file_attr_t gfattr = { 0, };
     int ret = unifyfs_get_global_file_meta(fid, gfid, &gfattr);
@@ -460,6 +460,496 @@ static int unifyfs_split_index(
     return UNIFYFS_SUCCESS;
 }
 
+/* drop index entries that the server has synced, moving any
+ * entries written since then to the front of the index array */
+void unifyfs_compact_index(void)
+{
+    size_t num_entries = *(unifyfs_indices.ptr_num_entries);
+    size_t num_synced  = *(unifyfs_indices.ptr_num_synced);
+    if (num_synced > num_entries) {
+        num_synced = num_entries;
+    }
+
+    if (num_synced > 0) {
+        unifyfs_index_t* idxs = unifyfs_indices.index_entry;
+        size_t remaining = num_entries - num_synced;
+        if (remaining > 0) {
+            memmove(idxs, &idxs[num_synced],
+                    remaining * sizeof(unifyfs_index_t));
+        }
+        *(unifyfs_indices.ptr_num_entries) = remaining;
+    }
+    *(unifyfs_indices.ptr_num_synced) = 0;
+}
+
+/* Writes are first recorded in a list of extents for each file, kept in
+ * private memory and sorted by file offset. Adjacent writes that are also
+ * contiguous in the log are merged, and ranges that are overwritten are
+ * trimmed from older extents, so that only the live extents of a file are
+ * copied into the shared index region (and inserted into the key-value
+ * store) when it is synced.
+ *
+ * Extents move to the shared index region when a file is closed, synced
+ * or laminated, or when its list reaches the size of the region. The
+ * server only picks them up at fsync, which laminate also does first,
+ * so other processes do not see the data before that. */
+typedef struct {
+    size_t count;          /* number of extents in list */
+    size_t capacity;       /* allocated length of exts */
+    unifyfs_index_t* exts; /* extents sorted by file_pos */
+} unifyfs_extent_list_t;
+
+/* extent lists indexed by local file id */
+static unifyfs_extent_list_t* unifyfs_extent_lists;
+
+/* A second list per file records all extents this process has written,
+ * synced or not, so that reads of its own data can be served from the
+ * log without asking the server (see unifyfs_local_extents).  The list
+ * is trimmed when the file is truncated and dropped when log chunks of
+ * the file are freed, and it is cleared if it grows past the size of
+ * the shared index region, in which case reads of earlier data go to
+ * the server again.  The lists are read by the aio thread as well as
+ * application threads, so they are protected by unifyfs_local_lock. */
+static unifyfs_extent_list_t* unifyfs_local_lists;
+static pthread_mutex_t unifyfs_local_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* get extent list for given file id, allocating lists on first use */
+static unifyfs_extent_list_t* unifyfs_get_extent_list(int fid)
+{
+    if (NULL == unifyfs_extent_lists) {
+        unifyfs_extent_lists = (unifyfs_extent_list_t*)
+            calloc(unifyfs_max_files, sizeof(unifyfs_extent_list_t));
+        if (NULL == unifyfs_extent_lists) {
+            return NULL;
+        }
+    }
+    return &unifyfs_extent_lists[fid];
+}
+
+/* get local extent list for given file id, allocating on first use */
+static unifyfs_extent_list_t* unifyfs_get_local_list(int fid)
+{
+    if (NULL == unifyfs_local_lists) {
+        unifyfs_local_lists = (unifyfs_extent_list_t*)
+            calloc(unifyfs_max_files, sizeof(unifyfs_extent_list_t));
+        if (NULL == unifyfs_local_lists) {
+            return NULL;
+        }
+    }
+    return &unifyfs_local_lists[fid];
+}
+
+/* free extents of an extent list */
+static void unifyfs_extent_list_clear(unifyfs_extent_list_t* list)
+{
+    if (NULL != list->exts) {
+        free(list->exts);
+    }
+    list->exts     = NULL;
+    list->count    = 0;
+    list->capacity = 0;
+}
+
+/* append an index entry to the shared index region, coalescing with
+ * the last entry and splitting at boundaries of the key-value slices */
+static int unifyfs_index_append(unifyfs_index_t* idx)
+{
+    unifyfs_index_t cur_idx = *idx;
+
+    /* lookup number of existing index entries */
+    off_t num_entries = *(unifyfs_indices.ptr_num_entries);
+
+    /* get pointer to index array */
+    unifyfs_index_t* idxs = unifyfs_indices.index_entry;
+
+    /* attempt to coalesce contiguous index entries if we
+     * have an existing index in the buffer, entries the server
+     * has already synced must be left alone */
+    if (num_entries > (off_t)*(unifyfs_indices.ptr_num_synced)) {
+        /* get pointer to last element in index array */
+        unifyfs_index_t* prev_idx = &idxs[num_entries - 1];
+
+        /* attempt to coalesce current index with last index,
+         * updates fields in last index and current index
+         * accordingly */
+        unifyfs_coalesce_index(prev_idx, &cur_idx,
+            unifyfs_key_slice_range);
+    }
+
+    /* add new index entries if needed */
+    if (cur_idx.length > 0) {
+        /* remaining entries we can fit in the shared memory region */
+        off_t remaining_entries = unifyfs_max_index_entries - num_entries;
+        if (remaining_entries > 0) {
+            /* split any remaining write index at boundaries of
+             * unifyfs_key_slice_range */
+            off_t used_entries = 0;
+            int split_rc = unifyfs_split_index(&cur_idx,
+                unifyfs_key_slice_range, &idxs[num_entries],
+                remaining_entries, &used_entries);
+            if (split_rc != UNIFYFS_SUCCESS) {
+                /* we failed to generate index entries for data
+                 * already in the log, return with an error */
+                LOGERR("exhausted space when splitting write index");
+                return UNIFYFS_ERROR_IO;
+            }
+
+            /* account for entries we just added */
+            num_entries += used_entries;
+        } else {
+            /* we failed to generate index entries for data
+             * already in the log, return with an error */
+            LOGERR("exhausted space when splitting write index");
+            return UNIFYFS_ERROR_IO;
+        }
+    }
+
+    /* update number of entries in index array */
+    (*unifyfs_indices.ptr_num_entries) = num_entries;
+
+    return UNIFYFS_SUCCESS;
+}
+
+/* copy extents of given file into the shared index region, extents
+ * that do not fit are left in the list */
+static int unifyfs_extent_flush(int fid)
+{
+    unifyfs_extent_list_t* list = unifyfs_get_extent_list(fid);
+    if ((NULL == list) || (0 == list->count)) {
+        return UNIFYFS_SUCCESS;
+    }
+
+    int rc = UNIFYFS_SUCCESS;
+    size_t i;
+    for (i = 0; i < list->count; i++) {
+        size_t num_entries = *(unifyfs_indices.ptr_num_entries);
+        rc = unifyfs_index_append(&list->exts[i]);
+        if (rc != UNIFYFS_SUCCESS) {
+            /* drop any partial split of this extent */
+            *(unifyfs_indices.ptr_num_entries) = num_entries;
+            break;
+        }
+    }
+
+    /* keep extents we failed to copy */
+    size_t remaining = list->count - i;
+    if ((remaining > 0) && (i > 0)) {
+        memmove(list->exts, &list->exts[i],
+                remaining * sizeof(unifyfs_index_t));
+    }
+    list->count = remaining;
+
+    return rc;
+}
+
+/* insert extent into list, merging with and trimming existing
+ * extents of the list */
+static int unifyfs_extent_list_insert(unifyfs_extent_list_t* list,
+                                      unifyfs_index_t* idx)
+{
+    /* make room for up to two more extents, which we need when
+     * the new extent splits an existing one */
+    if (list->count + 2 > list->capacity) {
+        size_t new_cap = (list->capacity == 0) ? 64 : (list->capacity * 2);
+        unifyfs_index_t* exts = (unifyfs_index_t*)
+            realloc(list->exts, new_cap * sizeof(unifyfs_index_t));
+        if (NULL == exts) {
+            LOGERR("failed to allocate extent list");
+            return UNIFYFS_ERROR_NOMEM;
+        }
+        list->exts     = exts;
+        list->capacity = new_cap;
+    }
+
+    unifyfs_index_t* exts = list->exts;
+    off_t start = idx->file_pos;
+    off_t end   = idx->file_pos + (off_t)idx->length;
+
+    /* binary search for first extent that ends at or after start,
+     * which is the first that may overlap or adjoin new extent */
+    size_t lo = 0;
+    size_t hi = list->count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if ((exts[mid].file_pos + (off_t)exts[mid].length) < start) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    /* find end of run of extents that overlap or adjoin new extent */
+    size_t first = lo;
+    size_t last = first;
+    while ((last < list->count) && (exts[last].file_pos <= end)) {
+        last++;
+    }
+
+    /* build replacement for extents in [first, last): the part of the
+     * first extent before start, the new extent, and the part of the
+     * last extent after end, merging pieces contiguous in the log */
+    unifyfs_index_t repl[3];
+    int nrepl = 0;
+    unifyfs_index_t cur = *idx;
+
+    if (first < last) {
+        unifyfs_index_t* ext = &exts[first];
+        if (ext->file_pos < start) {
+            unifyfs_index_t left = *ext;
+            left.length = (size_t)(start - ext->file_pos);
+            if ((left.log_pos + (off_t)left.length) == cur.log_pos) {
+                /* left piece is contiguous in log, extend it */
+                cur.file_pos = left.file_pos;
+                cur.log_pos  = left.log_pos;
+                cur.length  += left.length;
+            } else {
+                repl[nrepl++] = left;
+            }
+        }
+    }
+
+    repl[nrepl++] = cur;
+
+    if (first < last) {
+        unifyfs_index_t* ext = &exts[last - 1];
+        off_t ext_end = ext->file_pos + (off_t)ext->length;
+        if (ext_end > end) {
+            unifyfs_index_t right = *ext;
+            off_t skip = end - ext->file_pos;
+            right.file_pos = end;
+            right.log_pos  = ext->log_pos + skip;
+            right.length   = (size_t)(ext_end - end);
+
+            unifyfs_index_t* prev = &repl[nrepl - 1];
+            if ((prev->log_pos + (off_t)prev->length) == right.log_pos) {
+                /* right piece is contiguous in log, merge it */
+                prev->length += right.length;
+            } else {
+                repl[nrepl++] = right;
+            }
+        }
+    }
+
+    /* replace [first, last) with replacement extents */
+    size_t nold = last - first;
+    size_t tail = list->count - last;
+    if ((size_t)nrepl != nold) {
+        memmove(&exts[first + nrepl], &exts[last],
+                tail * sizeof(unifyfs_index_t));
+    }
+    memcpy(&exts[first], repl, nrepl * sizeof(unifyfs_index_t));
+    list->count = list->count - nold + nrepl;
+
+    return UNIFYFS_SUCCESS;
+}
+
+/* record extent written to file in the extent list for this file,
+ * and in its local extent list */
+static int unifyfs_extent_insert(int fid, unifyfs_index_t* idx)
+{
+    if (0 == idx->length) {
+        return UNIFYFS_SUCCESS;
+    }
+
+    unifyfs_extent_list_t* list = unifyfs_get_extent_list(fid);
+    if (NULL == list) {
+        LOGERR("failed to allocate extent list");
+        return UNIFYFS_ERROR_NOMEM;
+    }
+
+    /* the list can not hold more extents than will fit in the shared
+     * index region, so copy them over if we reach that size */
+    if (list->count + 2 >= unifyfs_max_index_entries) {
+        int rc = unifyfs_extent_flush(fid);
+        if (rc != UNIFYFS_SUCCESS) {
+            return rc;
+        }
+    }
+
+    int rc = unifyfs_extent_list_insert(list, idx);
+    if (rc != UNIFYFS_SUCCESS) {
+        return rc;
+    }
+
+    if (unifyfs_local_reads) {
+        /* failing to track local data only costs us server reads */
+        pthread_mutex_lock(&unifyfs_local_lock);
+        unifyfs_extent_list_t* local = unifyfs_get_local_list(fid);
+        if (NULL != local) {
+            if (local->count + 2 >= unifyfs_max_index_entries) {
+                unifyfs_extent_list_clear(local);
+            }
+            if (unifyfs_extent_list_insert(local, idx) != UNIFYFS_SUCCESS) {
+                unifyfs_extent_list_clear(local);
+            }
+        }
+        pthread_mutex_unlock(&unifyfs_local_lock);
+    }
+
+    return UNIFYFS_SUCCESS;
+}
+
+/* returns a copy of the extents this process wrote that overlap the
+ * given range of a file, sorted by file offset, and sets count to their
+ * number, the extents may start before pos and end after pos + len,
+ * the caller frees the returned array */
+unifyfs_index_t* unifyfs_local_extents(int fid, off_t pos,
+                                       size_t len, size_t* count)
+{
+    *count = 0;
+    if (0 == len) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&unifyfs_local_lock);
+    if (NULL == unifyfs_local_lists) {
+        pthread_mutex_unlock(&unifyfs_local_lock);
+        return NULL;
+    }
+
+    unifyfs_extent_list_t* list = &unifyfs_local_lists[fid];
+    unifyfs_index_t* exts = list->exts;
+    off_t end = pos + (off_t)len;
+
+    /* binary search for first extent that ends after pos */
+    size_t lo = 0;
+    size_t hi = list->count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if ((exts[mid].file_pos + (off_t)exts[mid].length) <= pos) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    size_t last = lo;
+    while ((last < list->count) && (exts[last].file_pos < end)) {
+        last++;
+    }
+
+    /* copy them out, since writers may reallocate the list */
+    unifyfs_index_t* copy = NULL;
+    if (last > lo) {
+        copy = (unifyfs_index_t*) malloc((last - lo) * sizeof(*copy));
+        if (NULL != copy) {
+            memcpy(copy, &exts[lo], (last - lo) * sizeof(*copy));
+            *count = last - lo;
+        }
+    }
+    pthread_mutex_unlock(&unifyfs_local_lock);
+
+    return copy;
+}
+
+/* forget local extents of given file, its log data may be reused */
+void unifyfs_drop_local_extents(int fid)
+{
+    pthread_mutex_lock(&unifyfs_local_lock);
+    if (NULL != unifyfs_local_lists) {
+        unifyfs_extent_list_clear(&unifyfs_local_lists[fid]);
+    }
+    pthread_mutex_unlock(&unifyfs_local_lock);
+}
+
+/* forget local extents of given file past length, the file has been
+ * truncated so reads there must not see our old data */
+void unifyfs_trim_local_extents(int fid, off_t length)
+{
+    pthread_mutex_lock(&unifyfs_local_lock);
+    if (NULL != unifyfs_local_lists) {
+        unifyfs_extent_list_t* list = &unifyfs_local_lists[fid];
+
+        /* extents are sorted and do not overlap, so drop them from
+         * the end until the last one ends at or before length */
+        while (list->count > 0) {
+            unifyfs_index_t* last = &list->exts[list->count - 1];
+            if (last->file_pos >= length) {
+                list->count--;
+            } else {
+                off_t last_end = last->file_pos + (off_t)last->length;
+                if (last_end > length) {
+                    last->length = (size_t)(length - last->file_pos);
+                }
+                break;
+            }
+        }
+    }
+    pthread_mutex_unlock(&unifyfs_local_lock);
+}
+
+/* copy count bytes starting at log_pos of our log into buf */
+int unifyfs_log_read(off_t log_pos, void* buf, size_t count)
+{
+    char* ptr = (char*) buf;
+
+    /* data in shared memory chunks comes before spill over data */
+    off_t mem_size = (off_t)unifyfs_max_chunks << unifyfs_chunk_bits;
+    if (log_pos < mem_size) {
+        size_t num = count;
+        if ((off_t)num > (mem_size - log_pos)) {
+            num = (size_t)(mem_size - log_pos);
+        }
+        memcpy(ptr, unifyfs_chunks + log_pos, num);
+        ptr += num;
+        log_pos += (off_t)num;
+        count -= num;
+    }
+
+    /* read the rest from the spill over file */
+    off_t spill_offset = log_pos - mem_size;
+    while (count > 0) {
+        ssize_t rc = pread(unifyfs_spilloverblock, ptr, count,
+                           spill_offset);
+        if (rc <= 0) {
+            LOGERR("pread of spill over data failed: errno=%d (%s)",
+                   errno, strerror(errno));
+            return UNIFYFS_ERROR_IO;
+        }
+        ptr += rc;
+        spill_offset += (off_t)rc;
+        count -= (size_t)rc;
+    }
+
+    return UNIFYFS_SUCCESS;
+}
+
+/* copy the extents of all files into the shared index region,
+ * called before asking the server to sync our index */
+int unifyfs_flush_extents(void)
+{
+    int ret = UNIFYFS_SUCCESS;
+    if (NULL != unifyfs_extent_lists) {
+        int fid;
+        for (fid = 0; fid < unifyfs_max_files; fid++) {
+            int rc = unifyfs_extent_flush(fid);
+            if (rc != UNIFYFS_SUCCESS) {
+                ret = rc;
+            }
+        }
+    }
+    return ret;
+}
+
+/* copy the extents of given file into the shared index region,
+ * called when the file is closed */
+int unifyfs_flush_file_extents(int fid)
+{
+    if (NULL == unifyfs_extent_lists) {
+        return UNIFYFS_SUCCESS;
+    }
+    return unifyfs_extent_flush(fid);
+}
+
+/* discard extents recorded for given file, e.g., when it is deleted */
+void unifyfs_drop_extents(int fid)
+{
+    if (NULL != unifyfs_extent_lists) {
+        unifyfs_extent_list_clear(&unifyfs_extent_lists[fid]);
+    }
+    unifyfs_drop_local_extents(fid);
+}
+
 /* write count bytes from user buffer into specified chunk id at chunk offset,
  * count should fit within chunk starting from specified offset */
 static int unifyfs_logio_chunk_write(
@@ -529,80 +1019,16 @@ static int unifyfs_logio_chunk_write(
         log_offset = spill_offset + unifyfs_max_chunks * (1 << unifyfs_chunk_bits);
     }
 
-    /* TODO: pass in gfid for this file or call function to look it up? */
-    /* find the corresponding file attr entry and update attr*/
-    unifyfs_file_attr_t tmp_meta_entry;
-    tmp_meta_entry.fid = fid;
-    unifyfs_file_attr_t* ptr_meta_entry
-        = (unifyfs_file_attr_t*)bsearch(&tmp_meta_entry,
-                                        unifyfs_fattrs.meta_entry,
-                                        *unifyfs_fattrs.ptr_num_entries,
-                                        sizeof(unifyfs_file_attr_t),
-                                        compare_fattr);
-
     /* define an new index entry for this write operation */
     unifyfs_index_t cur_idx;
-    cur_idx.fid      = ptr_meta_entry->gfid;
+    cur_idx.fid      = unifyfs_gfid_from_fid(fid);
     cur_idx.file_pos = pos;
     cur_idx.log_pos  = log_offset;
     cur_idx.length   = count;
 
-    /* lookup number of existing index entries */
-    off_t num_entries = *(unifyfs_indices.ptr_num_entries);
-
-    /* get pointer to index array */
-    unifyfs_index_t* idxs = unifyfs_indices.index_entry;
-
-    /* attempt to coalesce contiguous index entries if we
-     * have an existing index in the buffer */
-    if (num_entries > 0) {
-        /* get pointer to last element in index array */
-        unifyfs_index_t* prev_idx = &idxs[num_entries - 1];
-
-        /* attempt to coalesce current index with last index,
-         * updates fields in last index and current index
-         * accordingly */
-        unifyfs_coalesce_index(prev_idx, &cur_idx,
-            unifyfs_key_slice_range);
-    }
-
-    /* add new index entries if needed */
-    if (cur_idx.length > 0) {
-        /* remaining entries we can fit in the shared memory region */
-        off_t remaining_entries = unifyfs_max_index_entries - num_entries;
-        if (remaining_entries > 0) {
-            /* split any remaining write index at boundaries of
-             * unifyfs_key_slice_range */
-            off_t used_entries = 0;
-            int split_rc = unifyfs_split_index(&cur_idx,
-                unifyfs_key_slice_range, &idxs[num_entries],
-                remaining_entries, &used_entries);
-            if (split_rc != UNIFYFS_SUCCESS) {
-                /* in this case, we have copied data to the log,
-                 * but we failed to generate index entries,
-                 * we're returning with an error and leaving the data
-                 * in the log */
-                LOGERR("exhausted space when splitting write index");
-                return UNIFYFS_ERROR_IO;
-            }
-
-            /* account for entries we just added */
-            num_entries += used_entries;
-        } else {
-            /* in this case, we have copied data to the log,
-             * but we failed to generate index entries,
-             * we're returning with an error and leaving the data
-             * in the log */
-            LOGERR("exhausted space when splitting write index");
-            return UNIFYFS_ERROR_IO;
-        }
-    }
-
-    /* update number of entries in index array */
-    (*unifyfs_indices.ptr_num_entries) = num_entries;
-
-    /* assume write was successful if we get to here */
-    return UNIFYFS_SUCCESS;
+    /* record extent in the list for this file, it is copied
+     * to the shared index region when the file is synced */
+    return unifyfs_extent_insert(fid, &cur_idx);
 }
 
 /* write count bytes from user buffer into specified chunk id at chunk offset,
@@ -686,6 +1112,11 @@ int unifyfs_fid_store_fixed_shrink(int fid, unifyfs_filemeta_t* meta,
         num_chunks = (length >> unifyfs_chunk_bits) + 1;
     }
 
+    /* freed chunks may be reused, so stop serving reads from them */
+    if (meta->chunks > num_chunks) {
+        unifyfs_drop_local_extents(fid);
+    }
+
     /* clear off any extra chunks */
     while (meta->chunks > num_chunks) {
         meta->chunks--;
@@ -81,4 +81,33 @@ int unifyfs_fid_store_fixed_write(
     size_t count             /* number of bytes to write */
 );
 
+/* drop index entries the server has synced from the index array */
+void unifyfs_compact_index(void);
+
+/* copy extents recorded by writes into the shared index region */
+int unifyfs_flush_extents(void);
+
+/* copy extents recorded by writes to given file into the shared
+ * index region */
+int unifyfs_flush_file_extents(int fid);
+
+/* discard extents recorded by writes to given file */
+void unifyfs_drop_extents(int fid);
+
+/* returns a copy of the extents written by this process overlapping
+ * the given range of a file, sorted by offset, and sets count to their
+ * number, the caller frees the returned array */
+unifyfs_index_t* unifyfs_local_extents(int fid, off_t pos,
+                                       size_t len, size_t* count);
+
+/* discard extents written by this process to given file */
+void unifyfs_drop_local_extents(int fid);
+
+/* discard data written by this process to given file past length */
+void unifyfs_trim_local_extents(int fid, off_t length);
+
+/* copy count bytes starting at log_pos of our log into buf,
+ * returns UNIFYFS error code */
+int unifyfs_log_read(off_t log_pos, void* buf, size_t count);
+
 #endif /* UNIFYFS_FIXED_H */
@@ -62,6 +62,7 @@
 #include <assert.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <inttypes.h>
 #include <libgen.h>
 #include <limits.h>
 #include <poll.h>
@@ -282,6 +283,8 @@ typedef struct {
     uint32_t mode;                  /* st_mode bits.  This has file
                                      * permission info and will tell you if this
                                      * is a regular file or directory. */
+    uint64_t gfid;                  /* global file id, hash of the path
+                                     * the file was created with */
 } unifyfs_filemeta_t;
 
 /* struct used to map a full path to its local file id,
@@ -297,7 +300,7 @@ typedef struct {
 
 /*unifyfs structures*/
 typedef struct {
-    int fid;
+    uint64_t fid; /* local file id, replaced by gfid when sent to server */
     int errcode;
     size_t offset;
     size_t length;
@@ -306,6 +309,7 @@ typedef struct {
 
 typedef struct {
     size_t* ptr_num_entries;
+    size_t* ptr_num_synced;
     unifyfs_index_t* index_entry;
 } unifyfs_index_buf_t;
 
@@ -329,7 +333,12 @@ extern int local_del_cnt;
 extern int client_sockfd;
 extern struct pollfd cmd_fd;
 extern void* shm_req_buf;
+extern size_t shm_req_size;
+extern int shm_bell_id;
+extern shm_header_t* shm_bell;
 extern void* shm_recv_buf;
+extern size_t shm_recv_size;
+extern int shm_recv_slots;
 extern unifyfs_fattr_buf_t unifyfs_fattrs;
 
 extern int app_id;
@@ -384,6 +393,8 @@ extern void* unifyfs_dirstream_stack;
 
 extern int unifyfs_use_memfs;
 extern int unifyfs_use_spillover;
+extern int unifyfs_async_fsync;
+extern int unifyfs_local_reads;
 
 extern int    unifyfs_max_files;  /* maximum number of files to store */
 extern size_t
@@ -443,6 +454,9 @@ int unifyfs_intercept_dirstream(DIR* dirp);
 /* given a path, return the file id */
 int unifyfs_get_fid_from_path(const char* path);
 
+/* change the path of file id fid */
+void unifyfs_fid_set_path(int fid, const char* path);
+
 /* given a file descriptor, return the file id */
 int unifyfs_get_fid_from_fd(int fd);
 
@@ -474,7 +488,10 @@ int unifyfs_fd_is_laminated(int fd);
 const char* unifyfs_path_from_fid(int fid);
 
 /* Given a fid, return a gfid */
-int unifyfs_gfid_from_fid(const int fid);
+uint64_t unifyfs_gfid_from_fid(const int fid);
+
+/* Given a path and its fid (or -1), return a gfid */
+uint64_t unifyfs_gfid_from_path(const char* path, int fid);
 
 /* given an UNIFYFS error code, return corresponding errno code */
 int unifyfs_err_map_to_errno(int rc);
@@ -511,7 +528,7 @@ off_t unifyfs_fid_log_size(int fid);
 off_t unifyfs_fid_logical_size(int fid);
 
 /* fill in limited amount of stat information for global file id */
-int unifyfs_gfid_stat(int gfid, struct stat* buf);
+int unifyfs_gfid_stat(uint64_t gfid, struct stat* buf);
 
 /* fill in limited amount of stat information */
 int unifyfs_fid_stat(int fid, struct stat* buf);
@@ -569,13 +586,24 @@ int unifyfs_fid_unlink(int fid);
 
 /* functions used in UnifyFS */
 
-int unifyfs_generate_gfid(const char* path);
+uint64_t unifyfs_generate_gfid(const char* path);
 
-int unifyfs_set_global_file_meta(int fid, int gfid);
+int unifyfs_set_global_file_meta(int fid, uint64_t gfid);
 
-int unifyfs_get_global_file_meta(int fid, int gfid,
+int unifyfs_get_global_file_meta(int fid, uint64_t gfid,
                                  unifyfs_file_attr_t* gfattr);
 
+/* returns pointer to length bytes at offset within superblock of
+ * the given local client and the generation of its mapping,
+ * or NULL on failure */
+char* unifyfs_peer_superblock_ptr(int peer_app, int peer_id,
+                                  size_t offset, size_t length,
+                                  uint64_t* gen);
+
+/* returns 1 if the superblock of the given local client is still
+ * mapped with generation gen, 0 otherwise */
+int unifyfs_peer_superblock_valid(int peer_id, uint64_t gen);
+
 // These require types/structures defined above
 #include "unifyfs-fixed.h"
 #include "unifyfs-stdio.h"
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+ * Produced at the Lawrence Livermore National Laboratory.
+ *
+ * Copyright 2017-2019, UT-Battelle, LLC.
+ *
+ * LLNL-CODE-741539
+ * All rights reserved.
+ *
+ * This is the license for UnifyFS.
+ * For details, see https://github.com/LLNL/UnifyFS.
+ * Please read https://github.com/LLNL/UnifyFS/LICENSE for full license text.
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unifyfs_log.h"
+#include "unifyfs-pagecache.h"
+#include "uthash.h"
+#include "utlist.h"
+
+/* hash key of a cached block */
+typedef struct {
+    uint64_t gfid;  /* global file id */
+    size_t blk;     /* block index within file */
+} pagecache_key_t;
+
+/* cached block, the block data follows the structure */
+typedef struct pagecache_entry {
+    pagecache_key_t key;
+    size_t len;                    /* bytes of data in block */
+    struct pagecache_entry* prev;  /* LRU list links */
+    struct pagecache_entry* next;
+    UT_hash_handle hh;
+} pagecache_entry_t;
+
+typedef struct {
+    pthread_mutex_t lock;
+    pagecache_entry_t* table; /* hash table of cached blocks */
+    pagecache_entry_t* lru;   /* blocks, most recently used first */
+    size_t block_size;
+    size_t max_blocks;
+    size_t num_blocks;
+
+    /* lookup counters, logged when cache is finalized */
+    uint64_t hits;
+    uint64_t misses;
+} pagecache_t;
+
+static pagecache_t pagecache = {
+    .lock = PTHREAD_MUTEX_INITIALIZER
+};
+
+int unifyfs_pagecache_init(size_t cache_size, size_t block_size)
+{
+    pthread_mutex_lock(&pagecache.lock);
+    pagecache.table = NULL;
+    pagecache.lru = NULL;
+    pagecache.num_blocks = 0;
+    pagecache.hits = 0;
+    pagecache.misses = 0;
+    pagecache.block_size = block_size;
+    pagecache.max_blocks = 0;
+    if ((cache_size > 0) && (block_size > 0)) {
+        pagecache.max_blocks = cache_size / block_size;
+    }
+    LOGDBG("laminated file cache: %zu blocks of %zu bytes",
+           pagecache.max_blocks, block_size);
+    pthread_mutex_unlock(&pagecache.lock);
+    return 0;
+}
+
+void unifyfs_pagecache_fini(void)
+{
+    pagecache_entry_t* entry;
+    pagecache_entry_t* tmp;
+
+    pthread_mutex_lock(&pagecache.lock);
+    if ((pagecache.hits + pagecache.misses) > 0) {
+        LOGDBG("laminated file cache: hits=%llu misses=%llu",
+               (unsigned long long) pagecache.hits,
+               (unsigned long long) pagecache.misses);
+    }
+    HASH_ITER(hh, pagecache.table, entry, tmp) {
+        HASH_DEL(pagecache.table, entry);
+        free(entry);
+    }
+    pagecache.lru = NULL;
+    pagecache.num_blocks = 0;
+    pagecache.max_blocks = 0;
+    pthread_mutex_unlock(&pagecache.lock);
+}
+
+int unifyfs_pagecache_enabled(void)
+{
+    return (pagecache.max_blocks > 0);
+}
+
+size_t unifyfs_pagecache_block_size(void)
+{
+    return pagecache.block_size;
+}
+
+size_t unifyfs_pagecache_max_blocks(void)
+{
+    return pagecache.max_blocks;
+}
+
+/* look up cached block, call with cache locked */
+static pagecache_entry_t* pagecache_find(uint64_t gfid, size_t blk)
+{
+    pagecache_key_t key;
+    memset(&key, 0, sizeof(key));
+    key.gfid = gfid;
+    key.blk  = blk;
+
+    pagecache_entry_t* entry = NULL;
+    HASH_FIND(hh, pagecache.table, &key, sizeof(key), entry);
+    return entry;
+}
+
+int unifyfs_pagecache_read(uint64_t gfid, size_t blk, size_t blk_off,
+                           size_t len, char* buf)
+{
+    int found = 0;
+
+    pthread_mutex_lock(&pagecache.lock);
+    pagecache_entry_t* entry = pagecache_find(gfid, blk);
+    if (NULL != entry) {
+        /* move block to front of LRU list */
+        DL_DELETE(pagecache.lru, entry);
+        DL_PREPEND(pagecache.lru, entry);
+
+        /* copy data up to the end of the cached data */
+        if (blk_off < entry->len) {
+            size_t avail = entry->len - blk_off;
+            if (len > avail) {
+                len = avail;
+            }
+            char* data = (char*)(entry + 1);
+            memcpy(buf, data + blk_off, len);
+        }
+        pagecache.hits++;
+        found = 1;
+    } else {
+        pagecache.misses++;
+    }
+    pthread_mutex_unlock(&pagecache.lock);
+
+    return found;
+}
+
+void unifyfs_pagecache_insert(uint64_t gfid, size_t blk,
+                              const char* data, size_t len)
+{
+    if (len > pagecache.block_size) {
+        len = pagecache.block_size;
+    }
+
+    pthread_mutex_lock(&pagecache.lock);
+    if ((0 == pagecache.max_blocks) || (NULL != pagecache_find(gfid, blk))) {
+        /* cache disabled or block already cached */
+        pthread_mutex_unlock(&pagecache.lock);
+        return;
+    }
+
+    pagecache_entry_t* entry = NULL;
+    if (pagecache.num_blocks >= pagecache.max_blocks) {
+        /* reuse least recently used block, at the tail of the list */
+        entry = pagecache.lru->prev;
+        DL_DELETE(pagecache.lru, entry);
+        HASH_DEL(pagecache.table, entry);
+    } else {
+        entry = (pagecache_entry_t*)
+            malloc(sizeof(pagecache_entry_t) + pagecache.block_size);
+        if (NULL == entry) {
+            pthread_mutex_unlock(&pagecache.lock);
+            return;
+        }
+        pagecache.num_blocks++;
+    }
+
+    memset(&(entry->key), 0, sizeof(entry->key));
+    entry->key.gfid = gfid;
+    entry->key.blk  = blk;
+    entry->len = len;
+    memcpy((char*)(entry + 1), data, len);
+    HASH_ADD(hh, pagecache.table, key, sizeof(pagecache_key_t), entry);
+    DL_PREPEND(pagecache.lru, entry);
+    pthread_mutex_unlock(&pagecache.lock);
+}
+
+void unifyfs_pagecache_invalidate(uint64_t gfid)
+{
+    pagecache_entry_t* entry;
+    pagecache_entry_t* tmp;
+
+    pthread_mutex_lock(&pagecache.lock);
+    HASH_ITER(hh, pagecache.table, entry, tmp) {
+        if (entry->key.gfid == gfid) {
+            HASH_DEL(pagecache.table, entry);
+            DL_DELETE(pagecache.lru, entry);
+            free(entry);
+            pagecache.num_blocks--;
+        }
+    }
+    pthread_mutex_unlock(&pagecache.lock);
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+ * Produced at the Lawrence Livermore National Laboratory.
+ *
+ * Copyright 2017-2019, UT-Battelle, LLC.
+ *
+ * LLNL-CODE-741539
+ * All rights reserved.
+ *
+ * This is the license for UnifyFS.
+ * For details, see https://github.com/LLNL/UnifyFS.
+ * Please read https://github.com/LLNL/UnifyFS/LICENSE for full license text.
+ */
+
+#ifndef UNIFYFS_PAGECACHE_H
+#define UNIFYFS_PAGECACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Per-process cache of the contents of laminated files. Since a
+ * laminated file can no longer change, its data is cached in blocks
+ * of a fixed size keyed by global file id and block index, and the
+ * least recently used blocks are evicted when the cache is full.
+ * A block holds the file data from the block offset up to the end
+ * of the block or the end of the file, whichever comes first. */
+
+/* set up cache of cache_size bytes in blocks of block_size bytes,
+ * a cache_size of zero leaves the cache disabled */
+int unifyfs_pagecache_init(size_t cache_size, size_t block_size);
+
+/* free all cached blocks and disable the cache */
+void unifyfs_pagecache_fini(void);
+
+/* returns 1 if the cache is enabled, 0 otherwise */
+int unifyfs_pagecache_enabled(void);
+
+/* returns size of cache blocks */
+size_t unifyfs_pagecache_block_size(void);
+
+/* returns maximum number of blocks held in the cache */
+size_t unifyfs_pagecache_max_blocks(void);
+
+/* copy up to len bytes starting at offset blk_off within the given
+ * block to buf, no more than the cached length of the block is
+ * copied. Returns 1 if the block was cached, 0 otherwise. */
+int unifyfs_pagecache_read(uint64_t gfid, size_t blk, size_t blk_off,
+                           size_t len, char* buf);
+
+/* add a copy of len bytes of data of the given block to the cache */
+void unifyfs_pagecache_insert(uint64_t gfid, size_t blk,
+                              const char* data, size_t len);
+
+/* drop all cached blocks of the given file */
+void unifyfs_pagecache_invalidate(uint64_t gfid);
+
+#endif /* UNIFYFS_PAGECACHE_H */
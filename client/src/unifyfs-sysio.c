@@ -40,10 +40,13 @@
  * Please also read this file LICENSE.CRUISE
  */
 
+#include <signal.h>
+
 #include "unifyfs-internal.h"
 #include "unifyfs-sysio.h"
+#include "unifyfs-fixed.h"
+#include "unifyfs-pagecache.h"
 #include "margo_client.h"
-#include "ucr_read_builder.h"
 
 /* -------------------
  * define external variables
@@ -210,7 +213,7 @@ int UNIFYFS_WRAP(rename)(const char* oldpath, const char* newpath)
         /* finally overwrite the old name with the new name */
         LOGDBG("Changing %s to %s",
                (char*)&unifyfs_filelist[fid].filename, newpath);
-        strcpy((void*)&unifyfs_filelist[fid].filename, newpath);
+        unifyfs_fid_set_path(fid, newpath);
 
         /* success */
         return 0;
@@ -338,12 +341,13 @@ int UNIFYFS_WRAP(remove)(const char* path)
 /* The main stat call for all the *stat() functions */
 static int __stat(const char* path, struct stat* buf)
 {
-    int gfid, fid;
+    int fid;
+    uint64_t gfid;
     unifyfs_file_attr_t fattr;
     int ret;
 
-    gfid = unifyfs_generate_gfid(path);
     fid = unifyfs_get_fid_from_path(path);
+    gfid = unifyfs_gfid_from_path(path, fid);
 
     /* check that caller gave us a buffer to write to */
     if (!buf) {
@@ -569,6 +573,135 @@ ssize_t unifyfs_fd_read(int fd, off_t pos, void* buf, size_t count)
     return count;
 }
 
+/* returns total length of an iovec array, or -1 with errno set if
+ * the array is invalid */
+static ssize_t unifyfs_iov_length(const struct iovec* iov, int iovcnt)
+{
+    if ((iovcnt < 0) || (iovcnt > IOV_MAX)) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    size_t total = 0;
+    int i;
+    for (i = 0; i < iovcnt; i++) {
+        if (iov[i].iov_len > (size_t)SSIZE_MAX - total) {
+            errno = EINVAL;
+            return -1;
+        }
+        total += iov[i].iov_len;
+    }
+    return (ssize_t) total;
+}
+
+/*
+ * Read into the 'iovcnt' buffers of 'iov' from file starting at offset
+ * 'pos', filling each buffer in turn.  All buffers are read with a
+ * single request list to the server.  Does not change the file position.
+ *
+ * Returns number of bytes actually read, or -1 on error, in which
+ * case errno will be set.
+ */
+ssize_t unifyfs_fd_readv(int fd, off_t pos, const struct iovec* iov,
+                         int iovcnt)
+{
+    /* get the file id for this file descriptor */
+    int fid = unifyfs_get_fid_from_fd(fd);
+    if (fid < 0) {
+        errno = EBADF;
+        return -1;
+    }
+
+    /* it's an error to read from a directory */
+    if (unifyfs_fid_is_dir(fid)) {
+        errno = EISDIR;
+        return -1;
+    }
+
+    /* check that file descriptor is open for read */
+    unifyfs_fd_t* filedesc = unifyfs_get_filedesc_from_fd(fd);
+    if (!filedesc->read) {
+        errno = EBADF;
+        return -1;
+    }
+
+    ssize_t total = unifyfs_iov_length(iov, iovcnt);
+    if (total < 0) {
+        return -1;
+    }
+    size_t count = (size_t) total;
+
+    /* check that we don't overflow the file length */
+    if (unifyfs_would_overflow_offt(pos, (off_t) count)) {
+        errno = EOVERFLOW;
+        return -1;
+    }
+
+    /* check that we don't try to read past the end of the file */
+    off_t lastread = pos + (off_t) count;
+    off_t filesize = unifyfs_fid_logical_size(fid);
+    if (filesize < lastread) {
+        if (filesize > pos) {
+            count = (size_t)(filesize - pos);
+        } else {
+            count = 0;
+        }
+    }
+
+    /* if we don't read any bytes, return success */
+    if (count == 0) {
+        return 0;
+    }
+
+    /* build one read request for each non-empty buffer
+     * up to the end of the file */
+    read_req_t* reqs = (read_req_t*) calloc(iovcnt, sizeof(read_req_t));
+    if (NULL == reqs) {
+        errno = ENOMEM;
+        return -1;
+    }
+    int i;
+    int num = 0;
+    size_t left = count;
+    off_t off = pos;
+    for (i = 0; (i < iovcnt) && (left > 0); i++) {
+        size_t len = iov[i].iov_len;
+        if (len == 0) {
+            continue;
+        }
+        if (len > left) {
+            len = left;
+        }
+        reqs[num].fid     = fid;
+        reqs[num].offset  = (size_t) off;
+        reqs[num].length  = len;
+        reqs[num].errcode = UNIFYFS_SUCCESS;
+        reqs[num].buf     = (char*) iov[i].iov_base;
+        num++;
+        off  += (off_t) len;
+        left -= len;
+    }
+
+    int ret = unifyfs_fd_logreadlist(reqs, num);
+
+    /* as in unifyfs_fd_read(), a failed read without a request
+     * error may just be a read past the end of the file */
+    ssize_t retcount = (ssize_t) count;
+    if (ret != UNIFYFS_SUCCESS) {
+        retcount = 0;
+        for (i = 0; i < num; i++) {
+            if (reqs[i].errcode != UNIFYFS_SUCCESS) {
+                errno = EIO;
+                retcount = -1;
+                break;
+            }
+        }
+    }
+    free(reqs);
+
+    return retcount;
+}
+
 /*
  * Write 'count' bytes from 'buf' into file starting at offset' pos'.
  * Allocates new bytes and updates file size as necessary.  It is assumed
@@ -624,6 +757,88 @@ int unifyfs_fd_write(int fd, off_t pos, const void* buf, size_t count)
     return write_rc;
 }
 
+/*
+ * Write the 'iovcnt' buffers of 'iov' into file starting at offset
+ * 'pos', one after another.  Space in the log is allocated once for
+ * all buffers and their data lands contiguously in the log, so the
+ * index entries of the buffers merge into one extent.  O_APPEND
+ * behavior is ignored as in
+ * unifyfs_fd_write().  On success, the number of bytes written is
+ * returned in 'nwritten'.
+ */
+int unifyfs_fd_writev(int fd, off_t pos, const struct iovec* iov,
+                      int iovcnt, size_t* nwritten)
+{
+    *nwritten = 0;
+
+    /* get the file id for this file descriptor */
+    int fid = unifyfs_get_fid_from_fd(fd);
+    if (fid < 0) {
+        return UNIFYFS_ERROR_BADF;
+    }
+
+    /* it's an error to write to a directory */
+    if (unifyfs_fid_is_dir(fid)) {
+        return UNIFYFS_ERROR_INVAL;
+    }
+
+    /* check that file descriptor is open for write */
+    unifyfs_fd_t* filedesc = unifyfs_get_filedesc_from_fd(fd);
+    if (!filedesc->write) {
+        return UNIFYFS_ERROR_BADF;
+    }
+
+    ssize_t total = unifyfs_iov_length(iov, iovcnt);
+    if (total < 0) {
+        return UNIFYFS_ERROR_INVAL;
+    }
+    size_t count = (size_t) total;
+
+    /* check that our write won't overflow the length */
+    if (unifyfs_would_overflow_offt(pos, (off_t) count)) {
+        return UNIFYFS_ERROR_OVERFLOW;
+    }
+
+    if (count == 0) {
+        return UNIFYFS_SUCCESS;
+    }
+
+    /* allocate storage space to hold data for all buffers */
+    off_t logsize = unifyfs_fid_log_size(fid);
+    off_t newlogsize = logsize + count;
+    int extend_rc = unifyfs_fid_extend(fid, newlogsize);
+    if (extend_rc != UNIFYFS_SUCCESS) {
+        return extend_rc;
+    }
+
+    /* write each buffer after the previous one, the write places data
+     * at the current end of the log, so advance it after each buffer */
+    unifyfs_filemeta_t* meta = unifyfs_get_meta_from_fid(fid);
+    int write_rc = UNIFYFS_SUCCESS;
+    off_t off = pos;
+    int i;
+    for (i = 0; i < iovcnt; i++) {
+        if (iov[i].iov_len == 0) {
+            continue;
+        }
+        write_rc = unifyfs_fid_write(fid, off, iov[i].iov_base,
+                                     iov[i].iov_len);
+        if (write_rc != UNIFYFS_SUCCESS) {
+            break;
+        }
+        off += (off_t) iov[i].iov_len;
+        meta->log_size = logsize + (off - pos);
+    }
+
+    /* record what we wrote, even if a later buffer failed */
+    if (off > pos) {
+        meta->needs_sync = 1;
+        meta->local_size = MAX(meta->local_size, off);
+        *nwritten = (size_t)(off - pos);
+    }
+    return write_rc;
+}
+
 int UNIFYFS_WRAP(creat)(const char* path, mode_t mode)
 {
     /* equivalent to open(path, O_WRONLY|O_CREAT|O_TRUNC, mode) */
@@ -1031,67 +1246,888 @@ ssize_t UNIFYFS_WRAP(write)(int fd, const void* buf, size_t count)
     return ret;
 }
 
-ssize_t UNIFYFS_WRAP(readv)(int fd, const struct iovec* iov, int iovcnt)
+ssize_t UNIFYFS_WRAP(readv)(int fd, const struct iovec* iov, int iovcnt)
+{
+    ssize_t ret;
+
+    /* check whether we should intercept this file descriptor */
+    if (unifyfs_intercept_fd(&fd)) {
+        /* get pointer to file descriptor structure */
+        unifyfs_fd_t* filedesc = unifyfs_get_filedesc_from_fd(fd);
+        if (filedesc == NULL) {
+            /* ERROR: invalid file descriptor */
+            errno = EBADF;
+            return (ssize_t)(-1);
+        }
+
+        /* read all buffers at once and update file position */
+        ret = unifyfs_fd_readv(fd, filedesc->pos, iov, iovcnt);
+        if (ret > 0) {
+            filedesc->pos += (off_t) ret;
+        }
+        return ret;
+    } else {
+        MAP_OR_FAIL(readv);
+        ret = UNIFYFS_REAL(readv)(fd, iov, iovcnt);
+        return ret;
+    }
+}
+
+ssize_t UNIFYFS_WRAP(writev)(int fd, const struct iovec* iov, int iovcnt)
+{
+    ssize_t ret;
+
+    /* check whether we should intercept this file descriptor */
+    if (unifyfs_intercept_fd(&fd)) {
+        /* get pointer to file descriptor structure */
+        unifyfs_fd_t* filedesc = unifyfs_get_filedesc_from_fd(fd);
+        if (filedesc == NULL) {
+            /* ERROR: invalid file descriptor */
+            errno = EBADF;
+            return (ssize_t)(-1);
+        }
+
+        off_t pos;
+        if (filedesc->append) {
+            /* with O_APPEND we always write to the end */
+            int fid = unifyfs_get_fid_from_fd(fd);
+            pos = unifyfs_fid_local_size(fid);
+        } else {
+            pos = filedesc->pos;
+        }
+
+        /* write all buffers at once, a partial write still
+         * moves the file position */
+        size_t nwritten;
+        int write_rc = unifyfs_fd_writev(fd, pos, iov, iovcnt, &nwritten);
+        filedesc->pos = pos + (off_t) nwritten;
+        if ((write_rc != UNIFYFS_SUCCESS) && (nwritten == 0)) {
+            errno = unifyfs_err_map_to_errno(write_rc);
+            return (ssize_t)(-1);
+        }
+        return (ssize_t) nwritten;
+    } else {
+        MAP_OR_FAIL(writev);
+        ret = UNIFYFS_REAL(writev)(fd, iov, iovcnt);
+        return ret;
+    }
+}
+
+ssize_t UNIFYFS_WRAP(preadv)(int fd, const struct iovec* iov, int iovcnt,
+                             off_t offset)
+{
+    /* equivalent to readv(), except that it reads from a given
+     * position without changing the file pointer */
+    if (unifyfs_intercept_fd(&fd)) {
+        return unifyfs_fd_readv(fd, offset, iov, iovcnt);
+    } else {
+        MAP_OR_FAIL(preadv);
+        ssize_t ret = UNIFYFS_REAL(preadv)(fd, iov, iovcnt, offset);
+        return ret;
+    }
+}
+
+ssize_t UNIFYFS_WRAP(preadv64)(int fd, const struct iovec* iov, int iovcnt,
+                               off64_t offset)
+{
+    /* check whether we should intercept this file descriptor */
+    if (unifyfs_intercept_fd(&fd)) {
+        return unifyfs_fd_readv(fd, (off_t)offset, iov, iovcnt);
+    } else {
+        MAP_OR_FAIL(preadv64);
+        ssize_t ret = UNIFYFS_REAL(preadv64)(fd, iov, iovcnt, offset);
+        return ret;
+    }
+}
+
+ssize_t UNIFYFS_WRAP(pwritev)(int fd, const struct iovec* iov, int iovcnt,
+                              off_t offset)
+{
+    /* equivalent to writev(), except that it writes into a given
+     * position without changing the file pointer */
+    if (unifyfs_intercept_fd(&fd)) {
+        size_t nwritten;
+        int write_rc = unifyfs_fd_writev(fd, offset, iov, iovcnt, &nwritten);
+        if ((write_rc != UNIFYFS_SUCCESS) && (nwritten == 0)) {
+            errno = unifyfs_err_map_to_errno(write_rc);
+            return (ssize_t)(-1);
+        }
+        return (ssize_t) nwritten;
+    } else {
+        MAP_OR_FAIL(pwritev);
+        ssize_t ret = UNIFYFS_REAL(pwritev)(fd, iov, iovcnt, offset);
+        return ret;
+    }
+}
+
+ssize_t UNIFYFS_WRAP(pwritev64)(int fd, const struct iovec* iov, int iovcnt,
+                                off64_t offset)
+{
+    /* check whether we should intercept this file descriptor */
+    if (unifyfs_intercept_fd(&fd)) {
+        return UNIFYFS_WRAP(pwritev)(fd, iov, iovcnt, (off_t)offset);
+    } else {
+        MAP_OR_FAIL(pwritev64);
+        ssize_t ret = UNIFYFS_REAL(pwritev64)(fd, iov, iovcnt, offset);
+        return ret;
+    }
+}
+
+/* ---------------------------------------
+ * POSIX wrappers: asynchronous I/O
+ * --------------------------------------- */
+
+/* Asynchronous writes to UnifyFS files only copy data into the local
+ * log, so they are complete when submitted.  Asynchronous reads are
+ * queued for a progress thread, which takes all queued reads at once
+ * and issues them together through unifyfs_fd_logreadlist(), so reads
+ * submitted while an earlier batch is in flight share the next round
+ * trip to the server.  As in glibc, status is kept in the aiocb error
+ * and return value fields, which are updated under the aio lock.
+ *
+ * The progress thread reads the file metadata of its requests while
+ * application threads keep running, so operations that change the
+ * metadata or data of a file (write, truncate, laminate, close, and
+ * releasing the file id) first wait in unifyfs_aio_drain() until no
+ * read of that file is queued or in flight. */
+
+/* requests of one lio_listio(LIO_NOWAIT) call with a notification */
+typedef struct {
+    int pending;          /* requests not yet complete */
+    struct sigevent sev;  /* notification for the whole list */
+} aio_list_t;
+
+/* queued asynchronous read */
+typedef struct aio_req {
+    struct aiocb* cbp;    /* control block of request */
+    int fid;              /* local file id */
+    struct sigevent sev;  /* notification for this request */
+    aio_list_t* list;     /* lio_listio group of request, or NULL */
+    int list_done;        /* set when request completed its group */
+    struct aio_req* next;
+} aio_req_t;
+
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t work_cond; /* signals queued reads to progress thread */
+    pthread_cond_t done_cond; /* signals completed requests to waiters */
+    aio_req_t* head;          /* queued reads, oldest first */
+    aio_req_t* tail;
+    aio_req_t* inflight;      /* reads taken by progress thread */
+    pthread_t thrd;
+    int started;
+    int exit_flag;
+} unifyfs_aio = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .work_cond = PTHREAD_COND_INITIALIZER,
+    .done_cond = PTHREAD_COND_INITIALIZER,
+};
+
+/* function and value of a SIGEV_THREAD notification */
+typedef struct {
+    void (*func)(union sigval);
+    union sigval value;
+} aio_notify_arg_t;
+
+static void* aio_notify_thread(void* arg)
+{
+    aio_notify_arg_t* notify = (aio_notify_arg_t*) arg;
+    notify->func(notify->value);
+    free(notify);
+    return NULL;
+}
+
+/* deliver completion notification, call without the aio lock held */
+static void aio_notify(const struct sigevent* sev)
+{
+    if (sev->sigev_notify == SIGEV_SIGNAL) {
+        sigqueue(getpid(), sev->sigev_signo, sev->sigev_value);
+    } else if ((sev->sigev_notify == SIGEV_THREAD) &&
+               (NULL != sev->sigev_notify_function)) {
+        aio_notify_arg_t* notify = malloc(sizeof(aio_notify_arg_t));
+        if (NULL == notify) {
+            LOGERR("failed to allocate aio notification");
+            return;
+        }
+        notify->func = sev->sigev_notify_function;
+        notify->value = sev->sigev_value;
+
+        pthread_t thrd;
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+        int rc = pthread_create(&thrd, &attr, aio_notify_thread, notify);
+        if (rc != 0) {
+            LOGERR("failed to create aio notification thread");
+            free(notify);
+        }
+        pthread_attr_destroy(&attr);
+    }
+}
+
+/* record result of a request, call with the aio lock held */
+static void aio_complete(struct aiocb* cbp, int errcode, ssize_t retval)
+{
+    AIOCB_RETURN_VAL(cbp) = (errcode == 0) ? retval : -1;
+    AIOCB_ERROR_CODE(cbp) = errcode;
+    pthread_cond_broadcast(&unifyfs_aio.done_cond);
+}
+
+/* drop a request from its lio_listio group, returns 1 if it was the
+ * last one, call with the aio lock held */
+static int aio_list_release(aio_list_t* list)
+{
+    list->pending--;
+    return (0 == list->pending);
+}
+
+/* map a read error to an errno value for the control block, codes
+ * without an errno counterpart are reported as EIO */
+static int aio_errno(int rc)
+{
+    int errcode = unifyfs_err_map_to_errno(rc);
+    if ((errcode <= 0) || (errcode >= (int)UNIFRFS_START_OF_ERRORS)) {
+        errcode = EIO;
+    }
+    return errcode;
+}
+
+/* read all queued requests in batches */
+static void* aio_progress_thread(void* arg)
+{
+    pthread_mutex_lock(&unifyfs_aio.lock);
+    while (1) {
+        while ((NULL == unifyfs_aio.head) && !unifyfs_aio.exit_flag) {
+            pthread_cond_wait(&unifyfs_aio.work_cond, &unifyfs_aio.lock);
+        }
+        if (NULL == unifyfs_aio.head) {
+            /* exit flag is set and all reads are done */
+            break;
+        }
+
+        /* take all queued reads */
+        aio_req_t* batch = unifyfs_aio.head;
+        unifyfs_aio.head = NULL;
+        unifyfs_aio.tail = NULL;
+        unifyfs_aio.inflight = batch;
+
+        int i;
+        int count = 0;
+        aio_req_t* req;
+        for (req = batch; NULL != req; req = req->next) {
+            count++;
+        }
+        read_req_t* reqs = (read_req_t*) calloc(count, sizeof(read_req_t));
+        int* matched = (int*) calloc(count, sizeof(int));
+        if ((NULL != reqs) && (NULL != matched)) {
+            i = 0;
+            for (req = batch; NULL != req; req = req->next, i++) {
+                struct aiocb* cbp = req->cbp;
+                reqs[i].fid     = req->fid;
+                reqs[i].offset  = (size_t)(cbp->aio_offset);
+                reqs[i].length  = cbp->aio_nbytes;
+                reqs[i].errcode = UNIFYFS_SUCCESS;
+                reqs[i].buf     = (char*)(cbp->aio_buf);
+            }
+        }
+        pthread_mutex_unlock(&unifyfs_aio.lock);
+
+        /* as in unifyfs_fd_read(), don't read past the end of the file,
+         * reads at or past the end are complete with no bytes and are
+         * moved behind the ones sent to the server */
+        int nreads = 0;
+        if ((NULL != reqs) && (NULL != matched)) {
+            for (i = 0; i < count; i++) {
+                off_t pos = (off_t) reqs[i].offset;
+                off_t filesize = unifyfs_fid_logical_size(reqs[i].fid);
+                if (filesize < pos + (off_t) reqs[i].length) {
+                    if (filesize > pos) {
+                        reqs[i].length = (size_t)(filesize - pos);
+                    } else {
+                        reqs[i].length = 0;
+                    }
+                }
+                if (reqs[i].length > 0) {
+                    read_req_t tmp = reqs[nreads];
+                    reqs[nreads] = reqs[i];
+                    reqs[i] = tmp;
+                    nreads++;
+                }
+            }
+        }
+
+        int rc = UNIFYFS_ERROR_NOMEM;
+        if ((NULL != reqs) && (NULL != matched)) {
+            rc = UNIFYFS_SUCCESS;
+            if (nreads > 0) {
+                rc = unifyfs_fd_logreadlist(reqs, nreads);
+            }
+        }
+
+        /* requests are reordered by the read, match them by buffer */
+        pthread_mutex_lock(&unifyfs_aio.lock);
+        for (req = batch; NULL != req; req = req->next) {
+            struct aiocb* cbp = req->cbp;
+            int errcode = ENOMEM;
+            ssize_t retval = -1;
+            for (i = 0; (NULL != reqs) && (NULL != matched) &&
+                        (i < count); i++) {
+                if (!matched[i] && (reqs[i].buf == (char*)(cbp->aio_buf))) {
+                    matched[i] = 1;
+                    errcode = 0;
+                    retval = (ssize_t) reqs[i].length;
+                    if (i >= nreads) {
+                        /* nothing to read before the end of the file */
+                        break;
+                    }
+                    if (reqs[i].errcode != UNIFYFS_SUCCESS) {
+                        errcode = aio_errno(reqs[i].errcode);
+                        retval = -1;
+                    } else if (rc != UNIFYFS_SUCCESS) {
+                        errcode = aio_errno(rc);
+                        retval = -1;
+                    }
+                    break;
+                }
+            }
+            aio_complete(cbp, errcode, retval);
+            if (NULL != req->list) {
+                req->list_done = aio_list_release(req->list);
+            }
+        }
+        unifyfs_aio.inflight = NULL;
+        pthread_cond_broadcast(&unifyfs_aio.done_cond);
+        pthread_mutex_unlock(&unifyfs_aio.lock);
+
+        /* control blocks may be reused as soon as they are complete,
+         * so notifications only use our copies */
+        while (NULL != batch) {
+            req = batch;
+            batch = req->next;
+            aio_notify(&(req->sev));
+            if (req->list_done) {
+                aio_notify(&(req->list->sev));
+                free(req->list);
+            }
+            free(req);
+        }
+        free(reqs);
+        free(matched);
+
+        pthread_mutex_lock(&unifyfs_aio.lock);
+    }
+    pthread_mutex_unlock(&unifyfs_aio.lock);
+
+    return NULL;
+}
+
+/* returns 1 if a read of the file is queued or in flight,
+ * call with the aio lock held */
+static int aio_fid_busy(int fid)
+{
+    aio_req_t* req;
+    for (req = unifyfs_aio.head; NULL != req; req = req->next) {
+        if (req->fid == fid) {
+            return 1;
+        }
+    }
+    for (req = unifyfs_aio.inflight; NULL != req; req = req->next) {
+        if (req->fid == fid) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* wait until no asynchronous read of the file is queued or in flight */
+void unifyfs_aio_drain(int fid)
+{
+    /* the progress thread is started by a read submitted before this
+     * call, so a thread that has not seen it started has nothing to
+     * wait for */
+    if (!unifyfs_aio.started) {
+        return;
+    }
+
+    pthread_mutex_lock(&unifyfs_aio.lock);
+    while (aio_fid_busy(fid)) {
+        pthread_cond_wait(&unifyfs_aio.done_cond, &unifyfs_aio.lock);
+    }
+    pthread_mutex_unlock(&unifyfs_aio.lock);
+}
+
+/* queue asynchronous read of a UnifyFS file, the notification of the
+ * request is given by sev, and list is its lio_listio group (if any),
+ * returns 0 on success or an errno value */
+static int aio_submit_read(struct aiocb* cbp, int fid,
+                           const struct sigevent* sev, aio_list_t* list)
+{
+    aio_req_t* req = (aio_req_t*) calloc(1, sizeof(aio_req_t));
+    if (NULL == req) {
+        return EAGAIN;
+    }
+    req->cbp = cbp;
+    req->fid = fid;
+    req->list = list;
+    if (NULL != sev) {
+        req->sev = *sev;
+    } else {
+        req->sev.sigev_notify = SIGEV_NONE;
+    }
+
+    pthread_mutex_lock(&unifyfs_aio.lock);
+    if (!unifyfs_aio.started) {
+        /* start progress thread on first use */
+        unifyfs_aio.exit_flag = 0;
+        int rc = pthread_create(&unifyfs_aio.thrd, NULL,
+                                aio_progress_thread, NULL);
+        if (rc != 0) {
+            LOGERR("failed to create aio progress thread - rc=%d", rc);
+            pthread_mutex_unlock(&unifyfs_aio.lock);
+            free(req);
+            return EAGAIN;
+        }
+        unifyfs_aio.started = 1;
+    }
+    AIOCB_RETURN_VAL(cbp) = 0;
+    AIOCB_ERROR_CODE(cbp) = EINPROGRESS;
+    if (NULL != list) {
+        list->pending++;
+    }
+    if (NULL == unifyfs_aio.tail) {
+        unifyfs_aio.head = req;
+    } else {
+        unifyfs_aio.tail->next = req;
+    }
+    unifyfs_aio.tail = req;
+    pthread_cond_signal(&unifyfs_aio.work_cond);
+    pthread_mutex_unlock(&unifyfs_aio.lock);
+
+    return 0;
+}
+
+/* write data of a control block to a UnifyFS file and record result */
+static void aio_do_write(struct aiocb* cbp)
+{
+    ssize_t wret = UNIFYFS_WRAP(pwrite)(cbp->aio_fildes,
+                                        (const void*)cbp->aio_buf,
+                                        cbp->aio_nbytes, cbp->aio_offset);
+    int errcode = (-1 == wret) ? errno : 0;
+
+    pthread_mutex_lock(&unifyfs_aio.lock);
+    aio_complete(cbp, errcode, wret);
+    pthread_mutex_unlock(&unifyfs_aio.lock);
+}
+
+/* wait for queued reads to complete and stop the progress thread */
+void unifyfs_aio_fini(void)
+{
+    pthread_mutex_lock(&unifyfs_aio.lock);
+    int started = unifyfs_aio.started;
+    unifyfs_aio.exit_flag = 1;
+    pthread_cond_signal(&unifyfs_aio.work_cond);
+    pthread_mutex_unlock(&unifyfs_aio.lock);
+
+    if (started) {
+        pthread_join(unifyfs_aio.thrd, NULL);
+        unifyfs_aio.started = 0;
+    }
+}
+
+/* get the file id of an intercepted descriptor to read from, returns
+ * 0 on success or an errno value as read() would set */
+static int aio_read_fid(int fd, int* fid)
+{
+    unifyfs_intercept_fd(&fd);
+    *fid = unifyfs_get_fid_from_fd(fd);
+    if (*fid < 0) {
+        return EBADF;
+    }
+
+    /* it's an error to read from a directory */
+    if (unifyfs_fid_is_dir(*fid)) {
+        return EISDIR;
+    }
+
+    /* check that file descriptor is open for read */
+    unifyfs_fd_t* filedesc = unifyfs_get_filedesc_from_fd(fd);
+    if ((NULL == filedesc) || !filedesc->read) {
+        return EBADF;
+    }
+    return 0;
+}
+
+/* returns 1 if control block refers to a UnifyFS file */
+static int aio_intercept_cb(const struct aiocb* cbp)
+{
+    int fd = cbp->aio_fildes;
+    return unifyfs_intercept_fd(&fd);
+}
+
+/* submit the requests of a lio_listio(LIO_NOWAIT) call */
+static int lio_listio_nowait(struct aiocb* const aiocb_list[], int nitems,
+                             struct sigevent* sevp)
+{
+    int i, fid, rc;
+    int ret = 0;
+
+    /* the group holds an extra reference until all are submitted,
+     * the notifications of individual requests are ignored */
+    aio_list_t* list = NULL;
+    if ((NULL != sevp) && (sevp->sigev_notify != SIGEV_NONE)) {
+        list = (aio_list_t*) calloc(1, sizeof(aio_list_t));
+        if (NULL == list) {
+            errno = EAGAIN;
+            return -1;
+        }
+        list->pending = 1;
+        list->sev = *sevp;
+    }
+
+    for (i = 0; i < nitems; i++) {
+        struct aiocb* cbp = aiocb_list[i];
+        if ((NULL == cbp) || (cbp->aio_lio_opcode == LIO_NOP)) {
+            continue;
+        }
+        if (!aio_intercept_cb(cbp)) {
+            /* not a UnifyFS file, do it now as before */
+            ssize_t sret;
+            if (cbp->aio_lio_opcode == LIO_WRITE) {
+                sret = UNIFYFS_WRAP(pwrite)(cbp->aio_fildes,
+                                            (const void*)cbp->aio_buf,
+                                            cbp->aio_nbytes,
+                                            cbp->aio_offset);
+            } else {
+                sret = UNIFYFS_WRAP(pread)(cbp->aio_fildes,
+                                           (void*)cbp->aio_buf,
+                                           cbp->aio_nbytes,
+                                           cbp->aio_offset);
+            }
+            AIOCB_ERROR_CODE(cbp) = (-1 == sret) ? errno : 0;
+            AIOCB_RETURN_VAL(cbp) = sret;
+            continue;
+        }
+        if (cbp->aio_lio_opcode == LIO_WRITE) {
+            aio_do_write(cbp);
+            continue;
+        }
+
+        rc = aio_read_fid(cbp->aio_fildes, &fid);
+        if (rc != 0) {
+            pthread_mutex_lock(&unifyfs_aio.lock);
+            aio_complete(cbp, rc, -1);
+            pthread_mutex_unlock(&unifyfs_aio.lock);
+            continue;
+        }
+        rc = aio_submit_read(cbp, fid, NULL, list);
+        if (rc != 0) {
+            pthread_mutex_lock(&unifyfs_aio.lock);
+            aio_complete(cbp, rc, -1);
+            pthread_mutex_unlock(&unifyfs_aio.lock);
+            errno = EIO;
+            ret = -1;
+        }
+    }
+
+    if (NULL != list) {
+        pthread_mutex_lock(&unifyfs_aio.lock);
+        int done = aio_list_release(list);
+        pthread_mutex_unlock(&unifyfs_aio.lock);
+        if (done) {
+            aio_notify(&(list->sev));
+            free(list);
+        }
+    }
+
+    return ret;
+}
+
+int UNIFYFS_WRAP(aio_read)(struct aiocb* cbp)
+{
+    if (aio_intercept_cb(cbp)) {
+        int fid;
+        int rc = aio_read_fid(cbp->aio_fildes, &fid);
+        if (rc != 0) {
+            errno = rc;
+            return -1;
+        }
+        rc = aio_submit_read(cbp, fid, &(cbp->aio_sigevent), NULL);
+        if (rc != 0) {
+            errno = rc;
+            return -1;
+        }
+        return 0;
+    } else {
+        MAP_OR_FAIL(aio_read);
+        int ret = UNIFYFS_REAL(aio_read)(cbp);
+        return ret;
+    }
+}
+
+int UNIFYFS_WRAP(aio_write)(struct aiocb* cbp)
+{
+    if (aio_intercept_cb(cbp)) {
+        /* copy the notification before the request completes */
+        struct sigevent sev = cbp->aio_sigevent;
+        aio_do_write(cbp);
+        aio_notify(&sev);
+        return 0;
+    } else {
+        MAP_OR_FAIL(aio_write);
+        int ret = UNIFYFS_REAL(aio_write)(cbp);
+        return ret;
+    }
+}
+
+int UNIFYFS_WRAP(aio_error)(const struct aiocb* cbp)
+{
+    if (aio_intercept_cb(cbp)) {
+        pthread_mutex_lock(&unifyfs_aio.lock);
+        int ret = AIOCB_ERROR_CODE(cbp);
+        pthread_mutex_unlock(&unifyfs_aio.lock);
+        return ret;
+    } else {
+        MAP_OR_FAIL(aio_error);
+        int ret = UNIFYFS_REAL(aio_error)(cbp);
+        return ret;
+    }
+}
+
+ssize_t UNIFYFS_WRAP(aio_return)(struct aiocb* cbp)
+{
+    if (aio_intercept_cb(cbp)) {
+        pthread_mutex_lock(&unifyfs_aio.lock);
+        ssize_t ret = AIOCB_RETURN_VAL(cbp);
+        pthread_mutex_unlock(&unifyfs_aio.lock);
+        return ret;
+    } else {
+        MAP_OR_FAIL(aio_return);
+        ssize_t ret = UNIFYFS_REAL(aio_return)(cbp);
+        return ret;
+    }
+}
+
+int UNIFYFS_WRAP(aio_cancel)(int fd, struct aiocb* cbp)
+{
+    int origfd = fd;
+    if (unifyfs_intercept_fd(&fd)) {
+        if ((NULL != cbp) && (cbp->aio_fildes != origfd)) {
+            errno = EBADF;
+            return -1;
+        }
+
+        /* writes complete when submitted and reads taken by the
+         * progress thread run to completion, only queued reads
+         * can be canceled */
+        int found = 0;
+        int in_flight = 0;
+        aio_req_t* canceled = NULL;
+        pthread_mutex_lock(&unifyfs_aio.lock);
+        aio_req_t* prev = NULL;
+        aio_req_t* req = unifyfs_aio.head;
+        while (NULL != req) {
+            aio_req_t* next = req->next;
+            if ((req->cbp->aio_fildes == origfd) &&
+                ((NULL == cbp) || (req->cbp == cbp))) {
+                found = 1;
+                if (NULL == prev) {
+                    unifyfs_aio.head = next;
+                } else {
+                    prev->next = next;
+                }
+                if (unifyfs_aio.tail == req) {
+                    unifyfs_aio.tail = prev;
+                }
+                aio_complete(req->cbp, ECANCELED, -1);
+                if (NULL != req->list) {
+                    req->list_done = aio_list_release(req->list);
+                }
+                req->next = canceled;
+                canceled = req;
+            } else {
+                prev = req;
+            }
+            req = next;
+        }
+        for (req = unifyfs_aio.inflight; NULL != req; req = req->next) {
+            if ((req->cbp->aio_fildes == origfd) &&
+                ((NULL == cbp) || (req->cbp == cbp))) {
+                in_flight = 1;
+            }
+        }
+        pthread_mutex_unlock(&unifyfs_aio.lock);
+
+        /* canceled requests are notified like completed ones */
+        while (NULL != canceled) {
+            req = canceled;
+            canceled = req->next;
+            aio_notify(&(req->sev));
+            if (req->list_done) {
+                aio_notify(&(req->list->sev));
+                free(req->list);
+            }
+            free(req);
+        }
+
+        if (in_flight) {
+            return AIO_NOTCANCELED;
+        }
+        return (found ? AIO_CANCELED : AIO_ALLDONE);
+    } else {
+        MAP_OR_FAIL(aio_cancel);
+        int ret = UNIFYFS_REAL(aio_cancel)(fd, cbp);
+        return ret;
+    }
+}
+
+int UNIFYFS_WRAP(aio_fsync)(int op, struct aiocb* cbp)
+{
+    if (aio_intercept_cb(cbp)) {
+        if ((op != O_SYNC) && (op != O_DSYNC)) {
+            errno = EINVAL;
+            return -1;
+        }
+
+        /* the sync covers all requests queued before it, and like
+         * writes it completes when submitted */
+        int fd = cbp->aio_fildes;
+        int ufd = fd;
+        unifyfs_intercept_fd(&ufd);
+        int fid = unifyfs_get_fid_from_fd(ufd);
+        if (fid < 0) {
+            errno = EBADF;
+            return -1;
+        }
+        unifyfs_aio_drain(fid);
+
+        struct sigevent sev = cbp->aio_sigevent;
+        int rc = UNIFYFS_WRAP(fsync)(fd);
+        int errcode = (0 != rc) ? errno : 0;
+        pthread_mutex_lock(&unifyfs_aio.lock);
+        aio_complete(cbp, errcode, 0);
+        pthread_mutex_unlock(&unifyfs_aio.lock);
+        aio_notify(&sev);
+        return 0;
+    } else {
+        MAP_OR_FAIL(aio_fsync);
+        int ret = UNIFYFS_REAL(aio_fsync)(op, cbp);
+        return ret;
+    }
+}
+
+int UNIFYFS_WRAP(aio_suspend)(const struct aiocb* const aiocb_list[],
+                              int nitems, const struct timespec* timeout)
 {
-    ssize_t ret;
+    int i;
+    int num_ours = 0;
+    for (i = 0; i < nitems; i++) {
+        if ((NULL != aiocb_list[i]) && aio_intercept_cb(aiocb_list[i])) {
+            num_ours++;
+        }
+    }
+    if (0 == num_ours) {
+        MAP_OR_FAIL(aio_suspend);
+        int ret = UNIFYFS_REAL(aio_suspend)(aiocb_list, nitems, timeout);
+        return ret;
+    }
 
-    /* check whether we should intercept this file descriptor */
-    if (unifyfs_intercept_fd(&fd)) {
-        ssize_t rret;
-        int i;
-        ret = 0;
-        for (i = 0; i < iovcnt; i++) {
-            rret = UNIFYFS_WRAP(read)(fd, (void*)iov[i].iov_base,
-                                      iov[i].iov_len);
-            if (-1 == rret) {
-                return -1;
-            } else if (0 == rret) {
-                return ret;
-            } else {
-                ret += rret;
+    /* requests of other files are left to the real aio_suspend,
+     * which we poll in short intervals */
+    const struct aiocb** others = NULL;
+    if (num_ours < nitems) {
+        others = (const struct aiocb**)
+            calloc(nitems, sizeof(struct aiocb*));
+        if (NULL == others) {
+            errno = EAGAIN;
+            return -1;
+        }
+        for (i = 0; i < nitems; i++) {
+            if ((NULL != aiocb_list[i]) && !aio_intercept_cb(aiocb_list[i])) {
+                others[i] = aiocb_list[i];
             }
         }
-        return ret;
-    } else {
-        MAP_OR_FAIL(readv);
-        ret = UNIFYFS_REAL(readv)(fd, iov, iovcnt);
-        return ret;
+        MAP_OR_FAIL(aio_suspend);
     }
-}
 
-ssize_t UNIFYFS_WRAP(writev)(int fd, const struct iovec* iov, int iovcnt)
-{
-    ssize_t ret;
+    /* compute absolute deadline for timed waits */
+    struct timespec deadline;
+    if (NULL != timeout) {
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += timeout->tv_sec;
+        deadline.tv_nsec += timeout->tv_nsec;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+    }
 
-    /* check whether we should intercept this file descriptor */
-    if (unifyfs_intercept_fd(&fd)) {
-        ssize_t wret;
-        int i;
-        ret = 0;
-        for (i = 0; i < iovcnt; i++) {
-            wret = UNIFYFS_WRAP(write)(fd, (const void*)iov[i].iov_base,
-                                       iov[i].iov_len);
-            if (-1 == wret) {
-                return -1;
-            } else {
-                ret += wret;
-                if ((size_t)wret != iov[i].iov_len) {
-                    return ret;
+    int ret = -1;
+    int err = EAGAIN;
+    pthread_mutex_lock(&unifyfs_aio.lock);
+    while (1) {
+        for (i = 0; i < nitems; i++) {
+            const struct aiocb* cbp = aiocb_list[i];
+            if ((NULL != cbp) && aio_intercept_cb(cbp) &&
+                (AIOCB_ERROR_CODE(cbp) != EINPROGRESS)) {
+                ret = 0;
+                break;
+            }
+        }
+        if (0 == ret) {
+            break;
+        }
+
+        int rc = 0;
+        if (NULL != others) {
+            /* poll other requests for up to a millisecond */
+            pthread_mutex_unlock(&unifyfs_aio.lock);
+            struct timespec poll_ts = { 0, 1000000L };
+            rc = UNIFYFS_REAL(aio_suspend)(others, nitems, &poll_ts);
+            int real_errno = errno;
+            pthread_mutex_lock(&unifyfs_aio.lock);
+            if (0 == rc) {
+                ret = 0;
+                break;
+            } else if (real_errno != EAGAIN) {
+                err = real_errno;
+                break;
+            }
+            if (NULL != timeout) {
+                struct timespec now;
+                clock_gettime(CLOCK_REALTIME, &now);
+                if ((now.tv_sec > deadline.tv_sec) ||
+                    ((now.tv_sec == deadline.tv_sec) &&
+                     (now.tv_nsec >= deadline.tv_nsec))) {
+                    rc = ETIMEDOUT;
                 }
             }
+        } else if (NULL != timeout) {
+            rc = pthread_cond_timedwait(&unifyfs_aio.done_cond,
+                                        &unifyfs_aio.lock, &deadline);
+        } else {
+            pthread_cond_wait(&unifyfs_aio.done_cond, &unifyfs_aio.lock);
         }
-        return ret;
-    } else {
-        MAP_OR_FAIL(writev);
-        ret = UNIFYFS_REAL(writev)(fd, iov, iovcnt);
-        return ret;
+        if (rc == ETIMEDOUT) {
+            break;
+        }
+    }
+    pthread_mutex_unlock(&unifyfs_aio.lock);
+
+    if (NULL != others) {
+        free(others);
+    }
+    if (ret != 0) {
+        errno = err;
     }
+    return ret;
 }
 
 int UNIFYFS_WRAP(lio_listio)(int mode, struct aiocb* const aiocb_list[],
                              int nitems, struct sigevent* sevp)
 {
-    /* TODO - support for LIO_NOWAIT mode */
+    if (mode == LIO_NOWAIT) {
+        return lio_listio_nowait(aiocb_list, nitems, sevp);
+    }
 
     read_req_t* reqs = calloc(nitems, sizeof(read_req_t));
     if (NULL == reqs) {
@@ -1613,22 +2649,27 @@ static int unifyfs_match_received_ack(read_req_t* read_reqs, int count,
     return UNIFYFS_FAILURE;
 }
 
-/* notify our delegator that the shared memory buffer
+/* returns header of given slot in shared memory receive buffer */
+static shm_header_t* recv_slot_header(int slot)
+{
+    return unifyfs_shm_recv_slot(shm_recv_buf, shm_recv_size,
+                                 shm_recv_slots, slot);
+}
+
+/* notify our delegator that a slot of the shared memory buffer
  * is now clear and ready to hold more read data */
-static void delegator_signal(void)
+static void delegator_signal(int slot)
 {
-    LOGDBG("receive buffer now empty");
+    LOGDBG("receive buffer slot %d now empty", slot);
 
     /* set shm flag to signal delegator we're done */
-    shm_header_t* hdr = (shm_header_t*)shm_recv_buf;
-    hdr->state = SHMEM_REGION_EMPTY;
-
-    /* TODO: MEM_FLUSH */
+    shm_header_t* hdr = recv_slot_header(slot);
+    unifyfs_shm_set_state(hdr, SHMEM_REGION_EMPTY);
 }
 
-/* wait for delegator to inform us that shared memory buffer
- * is filled with read data */
-static int delegator_wait(void)
+/* wait for delegator to inform us that a slot of the shared
+ * memory buffer is filled with read data */
+static int delegator_wait(int slot)
 {
     int rc = (int)UNIFYFS_SUCCESS;
 
@@ -1654,48 +2695,137 @@ static int delegator_wait(void)
     }
 #endif
 
-    /* specify time to sleep between checking flag in shared
-     * memory indicating server has produced */
-    struct timespec shm_wait_tm;
-    shm_wait_tm.tv_sec  = 0;
-    shm_wait_tm.tv_nsec = SHM_WAIT_INTERVAL;
-
     /* get pointer to flag in shared memory */
-    shm_header_t* hdr = (shm_header_t*)shm_recv_buf;
+    shm_header_t* hdr = recv_slot_header(slot);
 
     /* wait for server to set flag to non-zero */
-    int max_sleep = 5000000; // 5s
-    volatile int* vip = (volatile int*)&(hdr->state);
-    while (*vip == SHMEM_REGION_EMPTY) {
-        /* not there yet, sleep for a while */
-        nanosleep(&shm_wait_tm, NULL);
-        /* TODO: MEM_FETCH */
-        max_sleep--;
-        if (0 == max_sleep) {
-            LOGERR("timed out waiting for non-empty");
-            rc = (int)UNIFYFS_ERROR_SHMEM;
-            break;
-        }
+    rc = unifyfs_shm_wait_state(hdr, SHMEM_REGION_EMPTY, 0, 5000); // 5s
+    if (rc != (int)UNIFYFS_SUCCESS) {
+        LOGERR("timed out waiting for non-empty");
     }
 
     return rc;
 }
 
-/* copy read data from shared memory buffer to user buffers from read
- * calls, sets done=1 on return when delegator informs us it has no
- * more data */
-static int process_read_data(read_req_t* read_reqs, int count, int* done)
+/* sequence number of the last read operation posted to the ring */
+static uint64_t read_ring_op;
+
+/* returns 1 once timeout_ms milliseconds have passed since start */
+static int read_ring_expired(const struct timespec* start,
+                             unsigned int timeout_ms)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    int64_t elapsed_ms = ((int64_t)(now.tv_sec - start->tv_sec) * 1000) +
+                         ((now.tv_nsec - start->tv_nsec) / 1000000);
+    return (elapsed_ms >= (int64_t)timeout_ms);
+}
+
+/* make new ring entries visible to the server, and wake it if it
+ * blocked on its doorbell while we were idle */
+static void read_ring_publish(shm_req_ring_t* ring, uint64_t head)
+{
+    __atomic_store_n(&(ring->head), head, __ATOMIC_RELEASE);
+    if (NULL != shm_bell) {
+        unifyfs_shm_bell_ring(shm_bell);
+    }
+}
+
+/* post a read operation to the request ring in shared memory and
+ * wait for the server to start it, returns the server's result */
+static int post_read_requests(read_req_t* reqs, int count)
+{
+    shm_req_ring_t* ring = (shm_req_ring_t*) shm_req_buf;
+    shm_read_desc_t* descs = unifyfs_shm_req_ring_descs(ring);
+    uint64_t cap = (uint64_t) unifyfs_shm_req_ring_capacity(shm_req_size);
+    if (cap == 0) {
+        LOGERR("request buffer too small for read ring");
+        return UNIFYFS_ERROR_SHMEM;
+    }
+
+    /* a new op makes the server drop descriptors of an earlier
+     * operation that timed out before its last descriptor */
+    uint64_t op = ++read_ring_op;
+
+    LOGDBG("posting %d read requests (op=%" PRIu64 ")", count, op);
+
+    /* mark operation in progress before the server can see it */
+    unifyfs_shm_set_state(&(ring->hdr), SHMEM_REGION_DATA_READY);
+
+    /* we are the only writer of head, descriptors are published
+     * all at once unless the ring fills up */
+    uint64_t head = ring->head;
+    int i;
+    for (i = 0; i < count; i++) {
+        /* wait for the server to free an entry if ring is full */
+        if ((head - __atomic_load_n(&(ring->tail), __ATOMIC_ACQUIRE))
+            >= cap) {
+            read_ring_publish(ring, head);
+            struct timespec start;
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            while ((head - __atomic_load_n(&(ring->tail), __ATOMIC_ACQUIRE))
+                   >= cap) {
+                struct timespec ts = { 0, SHM_WAIT_INTERVAL };
+                nanosleep(&ts, NULL);
+                if (read_ring_expired(&start, 5000)) { // 5s
+                    LOGERR("timed out waiting for space in read ring");
+                    return UNIFYFS_ERROR_SHMEM;
+                }
+            }
+        }
+
+        shm_read_desc_t* desc = descs + (head % cap);
+        desc->gfid   = reqs[i].fid;
+        desc->offset = reqs[i].offset;
+        desc->length = reqs[i].length;
+        desc->op     = op;
+        desc->last   = (i == (count - 1));
+        head++;
+    }
+    read_ring_publish(ring, head);
+
+    /* wait for server to take the operation */
+    int rc = unifyfs_shm_wait_state(&(ring->hdr), SHMEM_REGION_EMPTY,
+                                    1, 5000); // 5s
+    if (rc != (int)UNIFYFS_SUCCESS) {
+        LOGERR("timed out waiting for server to take read requests");
+        return rc;
+    }
+
+    /* the late result of an operation that timed out earlier may
+     * have emptied the ring, wait for the result of ours */
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    while (__atomic_load_n(&(ring->op_done), __ATOMIC_ACQUIRE) != op) {
+        struct timespec ts = { 0, SHM_WAIT_INTERVAL };
+        nanosleep(&ts, NULL);
+        if (read_ring_expired(&start, 5000)) { // 5s
+            LOGERR("timed out waiting for server to take read requests");
+            return UNIFYFS_ERROR_SHMEM;
+        }
+    }
+    return ring->rc;
+}
+
+/* copy read data from a slot of the shared memory buffer to user
+ * buffers from read calls, sets done=1 on return when delegator
+ * informs us it has no more data */
+static int process_read_data(read_req_t* read_reqs, int count, int slot,
+                             int* done)
 {
     /* assume we'll succeed */
     int rc = UNIFYFS_SUCCESS;
 
-    /* get pointer to start of shared memory buffer */
-    shm_header_t* shm_hdr = (shm_header_t*)shm_recv_buf;
+    /* get pointer to start of shared memory buffer slot */
+    shm_header_t* shm_hdr = recv_slot_header(slot);
     char* shmptr = ((char*)shm_hdr) + sizeof(shm_header_t);
 
     size_t num = shm_hdr->meta_cnt;
     if (0 == num) {
         LOGDBG("no read responses available");
+        if (shm_hdr->state == SHMEM_REGION_DATA_COMPLETE) {
+            *done = 1;
+        }
         return rc;
     }
 
@@ -1713,18 +2843,42 @@ static int process_read_data(read_req_t* read_reqs, int count, int* done)
         req.length  = msg->length;
         req.errcode = msg->errcode;
 
-        LOGDBG("read reply: gfid=%d offset=%zu size=%zu",
+        LOGDBG("read reply: gfid=%" PRIu64 " offset=%zu size=%zu",
                req.fid, req.offset, req.length);
 
-        /* get pointer to data */
-        req.buf = shmptr;
-        shmptr += msg->length;
+        /* get pointer to data, which either follows the header or was
+         * left in place in the superblock of a local client */
+        uint64_t peer_gen = 0;
+        if (msg->src_client >= 0) {
+            req.buf = unifyfs_peer_superblock_ptr(msg->src_app,
+                                                  msg->src_client,
+                                                  msg->src_offset,
+                                                  msg->length, &peer_gen);
+            if ((NULL == req.buf) && (req.errcode == UNIFYFS_SUCCESS)) {
+                LOGERR("failed to access data in superblock of client %d",
+                       msg->src_client);
+                req.errcode = EIO;
+            }
+        } else {
+            req.buf = shmptr;
+            shmptr += msg->length;
+        }
 
         /* process this read reply, identify which application read
          * request this reply goes to and copy data to user buffer */
         int tmp_rc = unifyfs_match_received_ack(read_reqs, count, &req);
         if (tmp_rc != UNIFYFS_SUCCESS) {
             rc = UNIFYFS_FAILURE;
+        } else if ((msg->src_client >= 0) &&
+                   !unifyfs_peer_superblock_valid(msg->src_client,
+                                                  peer_gen)) {
+            /* another thread remapped the superblock while we copied,
+             * so the data may have come from the wrong client */
+            LOGERR("superblock of client %d changed during copy",
+                   msg->src_client);
+            req.errcode = EIO;
+            unifyfs_match_received_ack(read_reqs, count, &req);
+            rc = UNIFYFS_FAILURE;
         }
     }
 
@@ -1744,7 +2898,7 @@ static int process_read_data(read_req_t* read_reqs, int count, int* done)
  * @return error code
  *
  * */
-int unifyfs_fd_logreadlist(read_req_t* read_reqs, int count)
+static int read_from_server(read_req_t* read_reqs, int count)
 {
     int i;
     int tot_sz = 0;
@@ -1781,25 +2935,14 @@ int unifyfs_fd_logreadlist(read_req_t* read_reqs, int count)
      * */
 
     /* convert local fid to global fid */
-    unifyfs_file_attr_t tmp_meta_entry;
-    unifyfs_file_attr_t* ptr_meta_entry;
     for (i = 0; i < count; i++) {
-        /* look for global meta data for this local file id */
-        tmp_meta_entry.fid = read_reqs[i].fid;
-        ptr_meta_entry =
-            (unifyfs_file_attr_t*) bsearch(&tmp_meta_entry,
-                                           unifyfs_fattrs.meta_entry,
-                                           *unifyfs_fattrs.ptr_num_entries,
-                                           sizeof(unifyfs_file_attr_t),
-                                           compare_fattr);
-
         /* replace local file id with global file id in request */
-        if (ptr_meta_entry != NULL) {
-            read_reqs[i].fid = ptr_meta_entry->gfid;
-        } else {
+        uint64_t gfid = unifyfs_gfid_from_fid((int) read_reqs[i].fid);
+        if (gfid == 0) {
             /* failed to find gfid for this request */
             return UNIFYFS_ERROR_BADF;
         }
+        read_reqs[i].fid = gfid;
     }
 
     /* order read request by increasing file id, then increasing offset */
@@ -1811,53 +2954,17 @@ int unifyfs_fd_logreadlist(read_req_t* read_reqs, int count)
                                unifyfs_key_slice_range,
                                &read_req_set);
 
-    /* prepare our shared memory buffer for delegator */
-    delegator_signal();
-
-    int read_rc;
-    if (read_req_set.count > 1) {
-        /* got multiple read requests,
-         * build up a flat buffer to include them all */
-        flatcc_builder_t builder;
-        flatcc_builder_init(&builder);
-
-        /* create request vector */
-        unifyfs_Extent_vec_start(&builder);
-
-        /* fill in values for each request entry */
-        for (i = 0; i < read_req_set.count; i++) {
-            unifyfs_Extent_vec_push_create(&builder,
-                                           read_req_set.read_reqs[i].fid,
-                                           read_req_set.read_reqs[i].offset,
-                                           read_req_set.read_reqs[i].length);
-        }
-
-        /* complete the array */
-        unifyfs_Extent_vec_ref_t extents = unifyfs_Extent_vec_end(&builder);
-        unifyfs_ReadRequest_create_as_root(&builder, extents);
-        //unifyfs_ReadRequest_end_as_root(&builder);
-
-        /* allocate our buffer to be sent */
-        size_t size = 0;
-        void* buffer = flatcc_builder_finalize_buffer(&builder, &size);
-        assert(buffer);
-        LOGDBG("mread: n_reqs:%d, flatcc buffer (%p) sz:%zu",
-               read_req_set.count, buffer, size);
-
-        /* invoke read rpc here */
-        read_rc = invoke_client_mread_rpc(read_req_set.count, size, buffer);
-
-        flatcc_builder_clear(&builder);
-        free(buffer);
-    } else {
-        /* got a single read request */
-        int gfid = ptr_meta_entry->gfid;
-        size_t offset = read_req_set.read_reqs[0].offset;
-        size_t length = read_req_set.read_reqs[0].length;
-        LOGDBG("read: offset:%zu, len:%zu", offset, length);
-        read_rc = invoke_client_read_rpc(gfid, offset, length);
+    /* prepare our shared memory buffer for delegator,
+     * the delegator fills slots in order starting from the first */
+    int slot;
+    for (slot = 0; slot < shm_recv_slots; slot++) {
+        delegator_signal(slot);
     }
 
+    /* post read requests to the server through the request ring */
+    int read_rc = post_read_requests(read_req_set.read_reqs,
+                                     read_req_set.count);
+
     /* bail out with error if we failed to even start the read */
     if (read_rc != UNIFYFS_SUCCESS) {
         return read_rc;
@@ -1868,24 +2975,404 @@ int unifyfs_fd_logreadlist(read_req_t* read_reqs, int count)
      * are missed
      * */
 
+    /* drain slots in order while the delegator fills the next one */
     int done = 0;
+    slot = 0;
     while (!done) {
-        int tmp_rc = delegator_wait();
+        int tmp_rc = delegator_wait(slot);
         if (tmp_rc != UNIFYFS_SUCCESS) {
             rc = UNIFYFS_FAILURE;
             done = 1;
         } else {
-            tmp_rc = process_read_data(read_reqs, count, &done);
+            tmp_rc = process_read_data(read_reqs, count, slot, &done);
             if (tmp_rc != UNIFYFS_SUCCESS) {
                 rc = UNIFYFS_FAILURE;
             }
-            delegator_signal();
+            delegator_signal(slot);
+            slot = (slot + 1) % shm_recv_slots;
+        }
+    }
+
+    return rc;
+}
+
+/* serializes use of the shared memory receive buffer, which is
+ * shared by application threads and the aio progress thread */
+static pthread_mutex_t server_read_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* read_from_server() with at most one outstanding read per client */
+static int server_logreadlist(read_req_t* read_reqs, int count)
+{
+    pthread_mutex_lock(&server_read_lock);
+    int rc = read_from_server(read_reqs, count);
+    pthread_mutex_unlock(&server_read_lock);
+    return rc;
+}
+
+/* returns number of page cache blocks spanned by a read request of
+ * a laminated file (up to the laminated size), or -1 if the request
+ * must bypass the cache */
+static long cached_read_blocks(read_req_t* req, size_t blk_sz,
+                               size_t max_blks)
+{
+    unifyfs_filemeta_t* meta = unifyfs_get_meta_from_fid((int)req->fid);
+    if ((NULL == meta) || !meta->is_laminated ||
+        (0 == unifyfs_gfid_from_fid((int)req->fid))) {
+        return -1;
+    }
+
+    size_t fsize = (size_t) meta->global_size;
+    if ((req->length == 0) || (req->offset >= fsize)) {
+        /* nothing to read */
+        return 0;
+    }
+    size_t end = req->offset + req->length;
+    if (end > fsize) {
+        end = fsize;
+    }
+    size_t nblks = ((end - 1) / blk_sz) - (req->offset / blk_sz) + 1;
+    if (nblks > max_blks) {
+        /* larger than the cache */
+        return -1;
+    }
+    return (long) nblks;
+}
+
+/* copy part of a page cache block fetched from the server to the
+ * user buffer of a read request, returns errcode of the fetch */
+static int copy_fetched_block(read_req_t* fetch_reqs, int num_fetch,
+                              uint64_t gfid, size_t blk, size_t blk_sz,
+                              size_t blk_off, size_t len, char* buf)
+{
+    int i;
+    for (i = 0; i < num_fetch; i++) {
+        read_req_t* fetch = fetch_reqs + i;
+        if ((fetch->fid == gfid) && ((fetch->offset / blk_sz) == blk)) {
+            if (fetch->errcode != UNIFYFS_SUCCESS) {
+                return fetch->errcode;
+            }
+            if (blk_off < fetch->length) {
+                size_t avail = fetch->length - blk_off;
+                memcpy(buf, fetch->buf + blk_off, (len < avail) ? len : avail);
+            }
+            break;
+        }
+    }
+    return UNIFYFS_SUCCESS;
+}
+
+/*
+ * serve read requests of laminated files from the page cache, blocks
+ * missing from the cache are read from the server and then added to
+ * it, other read requests are passed to the server as usual
+ * @param read_reqs: a list of read requests
+ * @param count: number of read requests
+ * @return error code
+ */
+static int cached_logreadlist(read_req_t* read_reqs, int count)
+{
+    int i;
+    int rc = UNIFYFS_SUCCESS;
+    size_t blk_sz = unifyfs_pagecache_block_size();
+    size_t max_blks = unifyfs_pagecache_max_blocks();
+
+    /* move requests that bypass the cache to the front, callers
+     * match results by buffer since the list is reordered anyway */
+    int num_direct = 0;
+    long max_fetch = 0;
+    for (i = 0; i < count; i++) {
+        long nblks = cached_read_blocks(read_reqs + i, blk_sz, max_blks);
+        if (nblks < 0) {
+            if (i != num_direct) {
+                read_req_t tmp = read_reqs[num_direct];
+                read_reqs[num_direct] = read_reqs[i];
+                read_reqs[i] = tmp;
+            }
+            num_direct++;
+        } else {
+            max_fetch += nblks;
+        }
+    }
+
+    /* copy cached blocks, and list the ones we need to fetch */
+    int num_fetch = 0;
+    read_req_t* fetch_reqs = NULL;
+    if (max_fetch > 0) {
+        fetch_reqs = (read_req_t*) calloc(max_fetch, sizeof(read_req_t));
+        if (NULL == fetch_reqs) {
+            return UNIFYFS_ERROR_NOMEM;
+        }
+    }
+    for (i = num_direct; i < count; i++) {
+        read_req_t* req = read_reqs + i;
+        if (0 == cached_read_blocks(req, blk_sz, max_blks)) {
+            continue;
+        }
+        int fid = (int) req->fid;
+        uint64_t gfid = unifyfs_gfid_from_fid(fid);
+        size_t fsize = (size_t) unifyfs_fid_global_size(fid);
+        size_t end = req->offset + req->length;
+        if (end > fsize) {
+            end = fsize;
+        }
+        size_t pos = req->offset;
+        while (pos < end) {
+            size_t blk = pos / blk_sz;
+            size_t blk_off = pos - (blk * blk_sz);
+            size_t len = blk_sz - blk_off;
+            if (len > (end - pos)) {
+                len = end - pos;
+            }
+            char* buf = req->buf + (pos - req->offset);
+            if (!unifyfs_pagecache_read(gfid, blk, blk_off, len, buf)) {
+                int j;
+                for (j = 0; j < num_fetch; j++) {
+                    if (((int)fetch_reqs[j].fid == fid) &&
+                        (fetch_reqs[j].offset == (blk * blk_sz))) {
+                        break;
+                    }
+                }
+                if (j == num_fetch) {
+                    /* read whole block, up to the end of the file */
+                    read_req_t* fetch = fetch_reqs + num_fetch++;
+                    fetch->fid     = fid;
+                    fetch->offset  = blk * blk_sz;
+                    fetch->length  = fsize - fetch->offset;
+                    if (fetch->length > blk_sz) {
+                        fetch->length = blk_sz;
+                    }
+                    fetch->errcode = UNIFYFS_SUCCESS;
+                }
+            }
+            pos += len;
+        }
+    }
+
+    /* read missing blocks, holes in the file read as zeros */
+    if (num_fetch > 0) {
+        char* fetch_buf = (char*) calloc(num_fetch, blk_sz);
+        if (NULL == fetch_buf) {
+            free(fetch_reqs);
+            return UNIFYFS_ERROR_NOMEM;
+        }
+        for (i = 0; i < num_fetch; i++) {
+            fetch_reqs[i].buf = fetch_buf + (i * blk_sz);
+        }
+
+        /* request file ids are replaced by global ids on return */
+        int tmp_rc = server_logreadlist(fetch_reqs, num_fetch);
+        if (tmp_rc != UNIFYFS_SUCCESS) {
+            rc = tmp_rc;
+        }
+        for (i = 0; i < num_fetch; i++) {
+            read_req_t* fetch = fetch_reqs + i;
+            if ((tmp_rc == UNIFYFS_SUCCESS) &&
+                (fetch->errcode == UNIFYFS_SUCCESS)) {
+                unifyfs_pagecache_insert(fetch->fid, fetch->offset / blk_sz,
+                                         fetch->buf, fetch->length);
+            }
+        }
+
+        /* copy fetched blocks to requests that missed them */
+        for (i = num_direct; i < count; i++) {
+            read_req_t* req = read_reqs + i;
+            if (0 == cached_read_blocks(req, blk_sz, max_blks)) {
+                continue;
+            }
+            int fid = (int) req->fid;
+            uint64_t gfid = unifyfs_gfid_from_fid(fid);
+            size_t fsize = (size_t) unifyfs_fid_global_size(fid);
+            size_t end = req->offset + req->length;
+            if (end > fsize) {
+                end = fsize;
+            }
+            size_t pos = req->offset;
+            while (pos < end) {
+                size_t blk = pos / blk_sz;
+                size_t blk_off = pos - (blk * blk_sz);
+                size_t len = blk_sz - blk_off;
+                if (len > (end - pos)) {
+                    len = end - pos;
+                }
+                char* buf = req->buf + (pos - req->offset);
+                int errcode = copy_fetched_block(fetch_reqs, num_fetch,
+                                                 gfid, blk, blk_sz,
+                                                 blk_off, len, buf);
+                if (errcode != UNIFYFS_SUCCESS) {
+                    req->errcode = errcode;
+                    rc = UNIFYFS_FAILURE;
+                }
+                pos += len;
+            }
+        }
+        free(fetch_buf);
+    }
+    if (NULL != fetch_reqs) {
+        free(fetch_reqs);
+    }
+
+    /* send all other requests to the server */
+    if (num_direct > 0) {
+        int tmp_rc = server_logreadlist(read_reqs, num_direct);
+        if (tmp_rc != UNIFYFS_SUCCESS) {
+            rc = tmp_rc;
+        }
+    }
+
+    return rc;
+}
+
+/* get data for read requests from the page cache or the server */
+static int remote_logreadlist(read_req_t* read_reqs, int count)
+{
+    if (unifyfs_pagecache_enabled()) {
+        return cached_logreadlist(read_reqs, count);
+    }
+    return server_logreadlist(read_reqs, count);
+}
+
+/* read request for part of a user read request */
+typedef struct {
+    read_req_t req;  /* part of user request */
+    int owner;       /* index of user request */
+} read_part_t;
+
+/*
+ * copy the parts of read requests covered by data this process wrote
+ * from its own log, and read only the remaining parts remotely
+ * @param read_reqs: a list of read requests
+ * @param count: number of read requests
+ * @return error code
+ */
+static int local_logreadlist(read_req_t* read_reqs, int count)
+{
+    int rc = UNIFYFS_SUCCESS;
+    int any_local = 0;
+    read_part_t* parts = NULL;
+    int num_parts = 0;
+    int max_parts = 0;
+
+    int i;
+    for (i = 0; i < count; i++) {
+        read_req_t* req = &read_reqs[i];
+        off_t pos = (off_t) req->offset;
+        off_t end = pos + (off_t) req->length;
+
+        size_t num_exts;
+        unifyfs_index_t* exts =
+            unifyfs_local_extents((int) req->fid, pos, req->length,
+                                  &num_exts);
+
+        /* walk the request, extents are sorted and do not overlap */
+        size_t e = 0;
+        while (pos < end) {
+            off_t next = end;
+            const unifyfs_index_t* ext = (e < num_exts) ? &exts[e] : NULL;
+            char* buf = req->buf + (pos - (off_t) req->offset);
+            if ((NULL != ext) && (ext->file_pos <= pos)) {
+                /* we wrote these bytes, copy them from our log */
+                off_t ext_end = ext->file_pos + (off_t) ext->length;
+                if (ext_end < next) {
+                    next = ext_end;
+                }
+                off_t log_pos = ext->log_pos + (pos - ext->file_pos);
+                int tmp_rc = unifyfs_log_read(log_pos, buf,
+                                              (size_t)(next - pos));
+                if (tmp_rc != UNIFYFS_SUCCESS) {
+                    req->errcode = tmp_rc;
+                    rc = tmp_rc;
+                }
+                any_local = 1;
+                e++;
+            } else {
+                /* someone else wrote the bytes up to our next extent */
+                if ((NULL != ext) && (ext->file_pos < next)) {
+                    next = ext->file_pos;
+                }
+                if (num_parts == max_parts) {
+                    int new_max = (max_parts == 0) ? 16 : (2 * max_parts);
+                    read_part_t* new_parts = (read_part_t*)
+                        realloc(parts, new_max * sizeof(read_part_t));
+                    if (NULL == new_parts) {
+                        /* read everything remotely instead */
+                        free(exts);
+                        free(parts);
+                        return remote_logreadlist(read_reqs, count);
+                    }
+                    parts = new_parts;
+                    max_parts = new_max;
+                }
+                read_part_t* part = &parts[num_parts++];
+                part->req.fid     = req->fid;
+                part->req.offset  = (size_t) pos;
+                part->req.length  = (size_t)(next - pos);
+                part->req.errcode = UNIFYFS_SUCCESS;
+                part->req.buf     = buf;
+                part->owner       = i;
+            }
+            pos = next;
+        }
+        free(exts);
+    }
+
+    if (!any_local) {
+        /* nothing of ours, read the requests as they are */
+        free(parts);
+        return remote_logreadlist(read_reqs, count);
+    }
+
+    if (num_parts > 0) {
+        /* the remote read reorders its requests, so read a copy and
+         * find the owners of failed parts by their buffers */
+        read_req_t* reqs = (read_req_t*)
+            malloc(num_parts * sizeof(read_req_t));
+        if (NULL == reqs) {
+            free(parts);
+            return UNIFYFS_ERROR_NOMEM;
+        }
+        for (i = 0; i < num_parts; i++) {
+            reqs[i] = parts[i].req;
+        }
+
+        int tmp_rc = remote_logreadlist(reqs, num_parts);
+        if (tmp_rc != UNIFYFS_SUCCESS) {
+            rc = tmp_rc;
+        }
+        for (i = 0; i < num_parts; i++) {
+            if (reqs[i].errcode == UNIFYFS_SUCCESS) {
+                continue;
+            }
+            int j;
+            for (j = 0; j < num_parts; j++) {
+                if (parts[j].req.buf == reqs[i].buf) {
+                    read_reqs[parts[j].owner].errcode = reqs[i].errcode;
+                    break;
+                }
+            }
         }
+        free(reqs);
     }
+    free(parts);
 
     return rc;
 }
 
+/*
+ * get data for a list of read requests, data this process wrote is
+ * copied from its own log, and reads of laminated files are served
+ * from the page cache if it is enabled
+ * @param read_reqs: a list of read requests
+ * @param count: number of read requests
+ * @return error code
+ */
+int unifyfs_fd_logreadlist(read_req_t* read_reqs, int count)
+{
+    if (unifyfs_local_reads) {
+        return local_logreadlist(read_reqs, count);
+    }
+    return remote_logreadlist(read_reqs, count);
+}
+
 ssize_t UNIFYFS_WRAP(pread)(int fd, void* buf, size_t count, off_t offset)
 {
     /* equivalent to read(), except that it shall read from a given
@@ -2036,29 +3523,48 @@ int UNIFYFS_WRAP(ftruncate)(int fd, off_t length)
     }
 }
 
-/* get the gfid for use in fsync wrapper
- * TODO: maybe move this somewhere else */
-uint32_t get_gfid(int fid)
+/* register the extents of our writes with the server, called for
+ * fsync and before a file is laminated, returns 0 on success, or -1
+ * with errno set on failure */
+static int unifyfs_fid_sync(int fid)
 {
-    unifyfs_file_attr_t target;
-    target.fid = fid;
+    unifyfs_filemeta_t* meta = unifyfs_get_meta_from_fid(fid);
+    if (!meta->needs_sync) {
+        return 0;
+    }
 
-    const void* entries = unifyfs_fattrs.meta_entry;
-    size_t num  = *unifyfs_fattrs.ptr_num_entries;
-    size_t size = sizeof(unifyfs_file_attr_t);
+    /* if using spill over, fsync spillover data to disk */
+    if (unifyfs_use_spillover) {
+        int ret = __real_fsync(unifyfs_spilloverblock);
+        if (ret != 0) {
+            /* error, need to set errno appropriately,
+             * we called the real fsync which should
+             * have already set errno to something reasonable */
+            return -1;
+        }
+    }
 
-    unifyfs_file_attr_t* entry =
-        (unifyfs_file_attr_t*) bsearch(&target, entries, num, size,
-                                       compare_fattr);
+    /* copy extents of our writes into the shared index region */
+    int ret = unifyfs_flush_extents();
+    if (ret != UNIFYFS_SUCCESS) {
+        errno = EIO;
+        return -1;
+    }
 
-    uint32_t gfid;
-    if (entry != NULL) {
-        gfid = (uint32_t)entry->gfid;
-    } else {
+    /* invoke fsync rpc to register index metadata with server */
+    uint64_t gfid = unifyfs_gfid_from_fid(fid);
+    ret = invoke_client_fsync_rpc(gfid);
+    if (ret != UNIFYFS_SUCCESS) {
+        errno = EIO;
         return -1;
     }
 
-    return gfid;
+    /* server has taken our index entries, drop them so the
+     * next fsync only carries new entries */
+    unifyfs_compact_index();
+
+    meta->needs_sync = 0;
+    return 0;
 }
 
 int UNIFYFS_WRAP(fsync)(int fd)
@@ -2073,28 +3579,7 @@ int UNIFYFS_WRAP(fsync)(int fd)
             return -1;
         }
 
-        unifyfs_filemeta_t* meta = unifyfs_get_meta_from_fid(fid);
-        if (!meta->needs_sync) {
-            return 0;
-        }
-
-        /* if using spill over, fsync spillover data to disk */
-        if (unifyfs_use_spillover) {
-            int ret = __real_fsync(unifyfs_spilloverblock);
-            if (ret != 0) {
-                /* error, need to set errno appropriately,
-                 * we called the real fsync which should
-                 * have already set errno to something reasonable */
-                return -1;
-            }
-        }
-
-        /* invoke fsync rpc to register index metadata with server */
-        int gfid = get_gfid(fid);
-        invoke_client_fsync_rpc(gfid);
-
-        meta->needs_sync = 0;
-        return 0;
+        return unifyfs_fid_sync(fid);
     } else {
         MAP_OR_FAIL(fsync);
         int ret = UNIFYFS_REAL(fsync)(fd);
@@ -2327,7 +3812,7 @@ int UNIFYFS_WRAP(close)(int fd)
 /* Helper function used by fchmod() and chmod() */
 static int __chmod(int fid, mode_t mode)
 {
-    int gfid;
+    uint64_t gfid;
     unifyfs_filemeta_t* meta;
     const char* path;
     int ret;
@@ -2348,7 +3833,7 @@ static int __chmod(int fid, mode_t mode)
         return -1;
     }
 
-    gfid = unifyfs_generate_gfid(path);
+    gfid = unifyfs_gfid_from_fid(fid);
 
     /*
      * If the chmod clears all the existing write bits, then it's a laminate.
@@ -2358,6 +3843,15 @@ static int __chmod(int fid, mode_t mode)
      */
     if ((meta->mode & 0222) &&
         (((meta->mode & 0222) & mode) == 0)) {
+        /* let asynchronous reads of the file finish first */
+        unifyfs_aio_drain(fid);
+
+        /* our writes are only known to the server once synced,
+         * do that now so they are part of the laminated file */
+        if (unifyfs_fid_sync(fid) != 0) {
+            LOGERR("chmod: couldn't sync %s before laminate", path);
+            return -1;
+        }
 
         /*
          * We're laminating. Calculate the file size so we can cache it
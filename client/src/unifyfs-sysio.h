@@ -78,6 +78,14 @@ UNIFYFS_DECL(read, ssize_t, (int fd, void* buf, size_t count));
 UNIFYFS_DECL(write, ssize_t, (int fd, const void* buf, size_t count));
 UNIFYFS_DECL(readv, ssize_t, (int fd, const struct iovec* iov, int iovcnt));
 UNIFYFS_DECL(writev, ssize_t, (int fd, const struct iovec* iov, int iovcnt));
+UNIFYFS_DECL(preadv, ssize_t, (int fd, const struct iovec* iov, int iovcnt,
+                               off_t offset));
+UNIFYFS_DECL(preadv64, ssize_t, (int fd, const struct iovec* iov, int iovcnt,
+                                 off64_t offset));
+UNIFYFS_DECL(pwritev, ssize_t, (int fd, const struct iovec* iov, int iovcnt,
+                                off_t offset));
+UNIFYFS_DECL(pwritev64, ssize_t, (int fd, const struct iovec* iov, int iovcnt,
+                                  off64_t offset));
 UNIFYFS_DECL(pread, ssize_t, (int fd, void* buf, size_t count, off_t offset));
 UNIFYFS_DECL(pread64, ssize_t, (int fd, void* buf, size_t count,
                                 off64_t offset));
@@ -102,6 +110,21 @@ UNIFYFS_DECL(__fxstat, int, (int vers, int fd, struct stat* buf));
 UNIFYFS_DECL(close, int, (int fd));
 UNIFYFS_DECL(lio_listio, int, (int mode, struct aiocb* const aiocb_list[],
                                int nitems, struct sigevent* sevp));
+UNIFYFS_DECL(aio_read, int, (struct aiocb* cbp));
+UNIFYFS_DECL(aio_write, int, (struct aiocb* cbp));
+UNIFYFS_DECL(aio_error, int, (const struct aiocb* cbp));
+UNIFYFS_DECL(aio_return, ssize_t, (struct aiocb* cbp));
+UNIFYFS_DECL(aio_cancel, int, (int fd, struct aiocb* cbp));
+UNIFYFS_DECL(aio_fsync, int, (int op, struct aiocb* cbp));
+UNIFYFS_DECL(aio_suspend, int, (const struct aiocb* const aiocb_list[],
+                                int nitems, const struct timespec* timeout));
+
+/* wait for outstanding asynchronous reads and stop their progress thread */
+void unifyfs_aio_fini(void);
+
+/* wait until no asynchronous read of the file is queued or in flight,
+ * call before changing the metadata or data of the file */
+void unifyfs_aio_drain(int fid);
 
 /*
  * Read 'count' bytes info 'buf' from file starting at offset 'pos'.
@@ -110,10 +133,21 @@ UNIFYFS_DECL(lio_listio, int, (int mode, struct aiocb* const aiocb_list[],
  */
 ssize_t unifyfs_fd_read(int fd, off_t pos, void* buf, size_t count);
 
+/* read into iovec buffers from file starting at offset pos with one
+ * request list, does not change the file position, returns number of
+ * bytes read or -1 with errno set */
+ssize_t unifyfs_fd_readv(int fd, off_t pos, const struct iovec* iov,
+                         int iovcnt);
+
 /* write count bytes from buf into file starting at offset pos,
  * allocates new bytes and updates file size as necessary,
  * fills any gaps with zeros */
 int unifyfs_fd_write(int fd, off_t pos, const void* buf, size_t count);
+
+/* write iovec buffers into file starting at offset pos as one log
+ * allocation, sets nwritten to number of bytes written */
+int unifyfs_fd_writev(int fd, off_t pos, const struct iovec* iov,
+                      int iovcnt, size_t* nwritten);
 int unifyfs_fd_logreadlist(read_req_t* read_req, int count);
 
 #include "unifyfs-dirops.h"
@@ -42,11 +42,11 @@
 
 #include "unifyfs-internal.h"
 #include "unifyfs-fixed.h"
+#include "unifyfs-pagecache.h"
 #include "unifyfs_runstate.h"
 
 #include <time.h>
 #include <mpi.h>
-#include <openssl/md5.h>
 
 #ifdef HAVE_LIBNUMA
 #include <numa.h>
@@ -89,13 +89,20 @@ struct pollfd cmd_fd;
 /* shared memory buffer to transfer read requests
  * from client to server */
 static char   shm_req_name[GEN_STR_LEN]  = {0};
-static size_t shm_req_size = UNIFYFS_SHMEM_REQ_SIZE;
+size_t shm_req_size = UNIFYFS_SHMEM_REQ_SIZE;
 void* shm_req_buf;
 
+/* doorbell of the server, rung after posting to the request ring
+ * to wake the server when it is idle, see unifyfs_shm_bell_ring() */
+static char shm_bell_name[GEN_STR_LEN] = {0};
+int shm_bell_id = -1;
+shm_header_t* shm_bell;
+
 /* shared memory buffer to transfer read replies
  * from server to client */
 static char   shm_recv_name[GEN_STR_LEN] = {0};
-static size_t shm_recv_size = UNIFYFS_SHMEM_RECV_SIZE;
+size_t shm_recv_size = UNIFYFS_SHMEM_RECV_SIZE;
+int    shm_recv_slots = UNIFYFS_SHMEM_RECV_SLOTS;
 void* shm_recv_buf;
 
 int client_rank;
@@ -110,6 +117,14 @@ int unifyfs_use_memfs = 1;
  * store file contents on spill over device */
 int unifyfs_use_spillover = 1;
 
+/* whether fsync returns once the server has copied our
+ * index metadata, rather than after it has been published */
+int unifyfs_async_fsync = 0;
+
+/* whether reads of data this process wrote are served
+ * from its own log, rather than by the server */
+int unifyfs_local_reads = 0;
+
 static int unifyfs_use_single_shm = 0;
 static int unifyfs_page_size      = 0;
 
@@ -148,12 +163,41 @@ static size_t shm_super_size;
 
 /* global persistent memory block (metadata + data) */
 void* shm_super_buf;
+
+/* read-only mappings of superblocks of other local clients, used
+ * to copy data left in place by the server straight to user buffers.
+ * The generation of a slot changes whenever it is mapped to another
+ * superblock, and replaced mappings stay mapped until unmount, so
+ * pointers handed out remain readable while threads copy from them */
+typedef struct peer_superblock {
+    int app_id;
+    uint64_t gen;
+    size_t size;
+    void* addr;
+    struct peer_superblock* next; /* next replaced mapping */
+} peer_superblock_t;
+static peer_superblock_t peer_superblocks[MAX_NUM_CLIENTS];
+static peer_superblock_t* peer_superblocks_replaced;
+static pthread_mutex_t peer_superblocks_lock = PTHREAD_MUTEX_INITIALIZER;
 static void* free_fid_stack;
 void* free_chunk_stack;
 void* free_spillchunk_stack;
 unifyfs_filename_t* unifyfs_filelist;
 static unifyfs_filemeta_t* unifyfs_filemetas;
 
+/* Hash table that indexes unifyfs_filelist by path. Besides an entry
+ * for each file, it has an entry for every path prefix (ending before a
+ * '/') of a file, counting the files that lie beneath it. This lets us
+ * tell whether a directory is empty without scanning the file list. */
+typedef struct {
+    char* path;      /* hash key */
+    int fid;         /* file id with this path, or -1 if only a prefix */
+    int descendants; /* number of files whose path starts with path + '/' */
+    UT_hash_handle hh;
+} unifyfs_path_entry_t;
+
+static unifyfs_path_entry_t* unifyfs_path_index;
+
 unifyfs_chunkmeta_t* unifyfs_chunkmetas;
 
 char* unifyfs_chunks;
@@ -501,18 +545,135 @@ inline int unifyfs_intercept_dirstream(DIR* dirp)
     return 0;
 }
 
+/* find path index entry for the first len characters of path */
+static unifyfs_path_entry_t* unifyfs_path_index_find(const char* path,
+                                                     size_t len)
+{
+    unifyfs_path_entry_t* entry = NULL;
+    HASH_FIND(hh, unifyfs_path_index, path, len, entry);
+    return entry;
+}
+
+/* find or create path index entry for first len characters of path */
+static unifyfs_path_entry_t* unifyfs_path_index_get(const char* path,
+                                                    size_t len)
+{
+    unifyfs_path_entry_t* entry = unifyfs_path_index_find(path, len);
+    if (NULL == entry) {
+        entry = (unifyfs_path_entry_t*) calloc(1, sizeof(*entry));
+        if (NULL == entry) {
+            return NULL;
+        }
+        entry->path = strndup(path, len);
+        if (NULL == entry->path) {
+            free(entry);
+            return NULL;
+        }
+        entry->fid = -1;
+        HASH_ADD_KEYPTR(hh, unifyfs_path_index, entry->path, len, entry);
+    }
+    return entry;
+}
+
+/* delete path index entry if it no longer tracks anything */
+static void unifyfs_path_index_release(unifyfs_path_entry_t* entry)
+{
+    if ((entry->fid < 0) && (entry->descendants == 0)) {
+        HASH_DEL(unifyfs_path_index, entry);
+        free(entry->path);
+        free(entry);
+    }
+}
+
+/* add delta to descendant count of each proper prefix of path */
+static void unifyfs_path_index_update_prefixes(const char* path, int delta)
+{
+    size_t i;
+    for (i = 1; path[i] != '\0'; i++) {
+        if (path[i] != '/') {
+            continue;
+        }
+        unifyfs_path_entry_t* entry;
+        if (delta > 0) {
+            entry = unifyfs_path_index_get(path, i);
+        } else {
+            entry = unifyfs_path_index_find(path, i);
+        }
+        if (NULL != entry) {
+            entry->descendants += delta;
+            unifyfs_path_index_release(entry);
+        }
+    }
+}
+
+/* record that file id fid has the given path */
+static void unifyfs_path_index_add(const char* path, int fid)
+{
+    unifyfs_path_entry_t* entry = unifyfs_path_index_get(path, strlen(path));
+    if (NULL == entry) {
+        LOGERR("failed to allocate path index entry for %s", path);
+        return;
+    }
+    if (entry->fid < 0) {
+        unifyfs_path_index_update_prefixes(path, 1);
+    }
+    entry->fid = fid;
+}
+
+/* remove path from the index */
+static void unifyfs_path_index_remove(const char* path)
+{
+    unifyfs_path_entry_t* entry =
+        unifyfs_path_index_find(path, strlen(path));
+    if ((NULL != entry) && (entry->fid >= 0)) {
+        entry->fid = -1;
+        unifyfs_path_index_update_prefixes(path, -1);
+        unifyfs_path_index_release(entry);
+    }
+}
+
+/* free all entries in the path index */
+static void unifyfs_path_index_free(void)
+{
+    unifyfs_path_entry_t* entry;
+    unifyfs_path_entry_t* tmp;
+    HASH_ITER(hh, unifyfs_path_index, entry, tmp) {
+        HASH_DEL(unifyfs_path_index, entry);
+        free(entry->path);
+        free(entry);
+    }
+}
+
+/* build path index from the file list in the superblock */
+static void unifyfs_path_index_rebuild(void)
+{
+    unifyfs_path_index_free();
+
+    int i;
+    for (i = 0; i < unifyfs_max_files; i++) {
+        if (unifyfs_filelist[i].in_use) {
+            unifyfs_path_index_add(unifyfs_filelist[i].filename, i);
+        }
+    }
+}
+
+/* change the path of file id fid */
+void unifyfs_fid_set_path(int fid, const char* path)
+{
+    unifyfs_path_index_remove(unifyfs_filelist[fid].filename);
+    strcpy((void*)&unifyfs_filelist[fid].filename, path);
+    unifyfs_path_index_add(path, fid);
+}
+
 /* given a path, return the file id */
 inline int unifyfs_get_fid_from_path(const char* path)
 {
-    int i = 0;
-    while (i < unifyfs_max_files) {
-        if (unifyfs_filelist[i].in_use &&
-            strcmp((void*)&unifyfs_filelist[i].filename, path) == 0) {
-            LOGDBG("File found: unifyfs_filelist[%d].filename = %s",
-                   i, (char*)&unifyfs_filelist[i].filename);
-            return i;
-        }
-        i++;
+    unifyfs_path_entry_t* entry =
+        unifyfs_path_index_find(path, strlen(path));
+    if ((NULL != entry) && (entry->fid >= 0)) {
+        LOGDBG("File found: unifyfs_filelist[%d].filename = %s",
+               entry->fid, (char*)&unifyfs_filelist[entry->fid].filename);
+        return entry->fid;
     }
 
     /* couldn't find specified path */
@@ -670,36 +831,58 @@ int unifyfs_fid_is_dir(int fid)
 /*
  * hash a path to gfid
  * @param path: file path
- * return: gfid
+ * return: gfid, never zero
  */
-int unifyfs_generate_gfid(const char* path)
+uint64_t unifyfs_generate_gfid(const char* path)
 {
-    unsigned char digested[16] = { 0, };
-    unsigned long len = strlen(path);
-    int* ival = (int*) digested;
+    /* 64-bit FNV-1a over the bytes of the path */
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    const unsigned char* p;
+    for (p = (const unsigned char*) path; *p != '\0'; p++) {
+        hash ^= (uint64_t) *p;
+        hash *= 0x100000001b3ULL;
+    }
 
-    MD5((const unsigned char*) path, len, digested);
+    /* FNV spreads the last few characters poorly over the low bits,
+     * which MDHIM uses to pick a range server, so mix it some more */
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+
+    /* the server uses a zero gfid to mark unused read requests */
+    if (hash == 0) {
+        hash = 1;
+    }
 
-    return abs(ival[0]);
+    return hash;
 }
 
-int unifyfs_gfid_from_fid(const int fid)
+/* Given a fid, return the gfid cached when the file was created,
+ * returns 0 if fid is not in use */
+uint64_t unifyfs_gfid_from_fid(const int fid)
 {
     /* check that local file id is in range */
     if (fid < 0 || fid >= unifyfs_max_files) {
-        return -EINVAL;
+        return 0;
     }
 
-    /* lookup file name structure for this local file id */
-    unifyfs_filename_t* fname = &unifyfs_filelist[fid];
-
-    /* generate global file id from path if file is valid */
-    if (fname->in_use) {
-        int gfid = unifyfs_generate_gfid(fname->filename);
-        return gfid;
+    /* lookup global file id if file is valid */
+    if (unifyfs_filelist[fid].in_use) {
+        unifyfs_filemeta_t* meta = unifyfs_get_meta_from_fid(fid);
+        return meta->gfid;
     }
 
-    return -EINVAL;
+    return 0;
+}
+
+/* given a path and its local file id (-1 if not open locally),
+ * return the global file id, avoids hashing the path if we know it */
+uint64_t unifyfs_gfid_from_path(const char* path, int fid)
+{
+    if (fid >= 0) {
+        return unifyfs_gfid_from_fid(fid);
+    }
+    return unifyfs_generate_gfid(path);
 }
 
 /* Given a fid, return the path.  */
@@ -720,24 +903,17 @@ const char* unifyfs_path_from_fid(int fid)
  * returns 0 for no */
 int unifyfs_fid_is_dir_empty(const char* path)
 {
-    int i = 0;
-    while (i < unifyfs_max_files) {
-        /* only check this element if it's active */
-        if (unifyfs_filelist[i].in_use) {
-            /* if the file starts with the path, it is inside of that directory
-             * also check to make sure that it's not the directory entry itself */
-            char* strptr = strstr(path, unifyfs_filelist[i].filename);
-            if (strptr == unifyfs_filelist[i].filename &&
-                strcmp(path, unifyfs_filelist[i].filename) != 0) {
-                /* found a child item in path */
-                LOGDBG("File found: unifyfs_filelist[%d].filename = %s",
-                       i, (char*)&unifyfs_filelist[i].filename);
-                return 0;
-            }
-        }
+    /* ignore any trailing slashes on the directory name */
+    size_t len = strlen(path);
+    while ((len > 1) && (path[len - 1] == '/')) {
+        len--;
+    }
 
-        /* go on to next file */
-        i++;
+    /* if any file starts with the path, it is inside of that directory */
+    unifyfs_path_entry_t* entry = unifyfs_path_index_find(path, len);
+    if ((NULL != entry) && (entry->descendants > 0)) {
+        LOGDBG("found %d items in %s", entry->descendants, path);
+        return 0;
     }
 
     /* couldn't find any files with this prefix, dir must be empty */
@@ -826,7 +1002,7 @@ static int ins_file_meta(unifyfs_fattr_buf_t* ptr_f_meta_log,
 }
 
 unifyfs_filemeta_t* meta;
-int unifyfs_set_global_file_meta(int fid, int gfid)
+int unifyfs_set_global_file_meta(int fid, uint64_t gfid)
 {
     int ret = 0;
     unifyfs_filemeta_t* meta = unifyfs_get_meta_from_fid(fid);
@@ -874,7 +1050,8 @@ int unifyfs_set_global_file_meta(int fid, int gfid)
     return 0;
 }
 
-int unifyfs_get_global_file_meta(int fid, int gfid, unifyfs_file_attr_t* gfattr)
+int unifyfs_get_global_file_meta(int fid, uint64_t gfid,
+                                 unifyfs_file_attr_t* gfattr)
 {
     if (!gfattr) {
         return -EINVAL;
@@ -891,7 +1068,7 @@ int unifyfs_get_global_file_meta(int fid, int gfid, unifyfs_file_attr_t* gfattr)
 }
 
 /* fill in limited amount of stat information for global file id */
-int unifyfs_gfid_stat(int gfid, struct stat* buf)
+int unifyfs_gfid_stat(uint64_t gfid, struct stat* buf)
 {
     /* check that we have an output buffer to write to */
     if (!buf) {
@@ -938,6 +1115,12 @@ int unifyfs_fid_alloc()
 /* return the file id back to the free pool */
 int unifyfs_fid_free(int fid)
 {
+    /* let asynchronous reads of the file finish first */
+    unifyfs_aio_drain(fid);
+
+    /* forget any writes to this file not yet synced */
+    unifyfs_drop_extents(fid);
+
     unifyfs_stack_lock();
     unifyfs_stack_push(free_fid_stack, fid);
     unifyfs_stack_unlock();
@@ -964,6 +1147,7 @@ int unifyfs_fid_create_file(const char* path)
 
     /* copy file name into slot */
     strcpy((void*)&unifyfs_filelist[fid].filename, path);
+    unifyfs_path_index_add(path, fid);
     LOGDBG("Filename %s got unifyfs fd %d",
            unifyfs_filelist[fid].filename, fid);
 
@@ -978,6 +1162,7 @@ int unifyfs_fid_create_file(const char* path)
     meta->flock_status = UNLOCKED;
     meta->is_laminated = 0;
     meta->mode = UNIFYFS_STAT_DEFAULT_FILE_MODE;
+    meta->gfid = unifyfs_generate_gfid(path);
 
     /* PTHREAD_PROCESS_SHARED allows Process-Shared Synchronization*/
     pthread_spin_init(&meta->fspinlock, PTHREAD_PROCESS_SHARED);
@@ -989,7 +1174,7 @@ int unifyfs_fid_create_directory(const char* path)
 {
     int ret = 0;
     int fid = 0;
-    int gfid = 0;
+    uint64_t gfid = 0;
     int found_global = 0;
     int found_local = 0;
     size_t pathlen = strlen(path) + 1;
@@ -1002,7 +1187,7 @@ int unifyfs_fid_create_directory(const char* path)
     }
 
     fid = unifyfs_get_fid_from_path(path);
-    gfid = unifyfs_generate_gfid(path);
+    gfid = unifyfs_gfid_from_path(path, fid);
 
     found_global =
         (unifyfs_get_global_file_meta(fid, gfid, &gfattr) == UNIFYFS_SUCCESS);
@@ -1069,6 +1254,9 @@ int unifyfs_fid_write(int fid, off_t pos, const void* buf, size_t count)
         return UNIFYFS_SUCCESS;
     }
 
+    /* let asynchronous reads of the file finish first */
+    unifyfs_aio_drain(fid);
+
     /* get meta for this file id */
     unifyfs_filemeta_t* meta = unifyfs_get_meta_from_fid(fid);
 
@@ -1164,6 +1352,9 @@ int unifyfs_fid_shrink(int fid, off_t length)
  * is more than size */
 int unifyfs_fid_truncate(int fid, off_t length)
 {
+    /* let asynchronous reads of the file finish first */
+    unifyfs_aio_drain(fid);
+
     /* get meta data for this file */
     unifyfs_filemeta_t* meta = unifyfs_get_meta_from_fid(fid);
     if (meta->is_laminated) {
@@ -1173,6 +1364,10 @@ int unifyfs_fid_truncate(int fid, off_t length)
     /* get current size of file */
     off_t size = meta->local_size;
 
+    /* data we wrote past the new end is gone, even if its log
+     * chunks are kept, so don't serve reads from it any more */
+    unifyfs_trim_local_extents(fid, length);
+
     /* drop data if length is less than current size,
      * allocate new space and zero fill it if bigger */
     if (length < size) {
@@ -1202,26 +1397,6 @@ int unifyfs_fid_truncate(int fid, off_t length)
     return UNIFYFS_SUCCESS;
 }
 
-/*
- * hash a path to gfid
- * @param path: file path
- * return: error code, gfid
- * */
-static int unifyfs_get_global_fid(const char* path, int* gfid)
-{
-    MD5_CTX ctx;
-
-    unsigned char md[16];
-    memset(md, 0, 16);
-
-    MD5_Init(&ctx);
-    MD5_Update(&ctx, path, strlen(path));
-    MD5_Final(md, &ctx);
-
-    *gfid = *((int*)md);
-    return UNIFYFS_SUCCESS;
-}
-
 /* opens a new file id with specified path, access flags, and permissions,
  * fills outfid with file id and outpos with position for current file pointer,
  * returns UNIFYFS error code
@@ -1233,7 +1408,7 @@ int unifyfs_fid_open(const char* path, int flags, mode_t mode, int* outfid,
     int ret = 0;
     size_t pathlen = strlen(path) + 1;
     int fid = 0;
-    int gfid = -1;
+    uint64_t gfid = 0;
     int found_global = 0;
     int found_local = 0;
     off_t pos = 0;      /* set the pointer to the start of the file */
@@ -1252,15 +1427,22 @@ int unifyfs_fid_open(const char* path, int flags, mode_t mode, int* outfid,
      * the broadcast for cache invalidation has not been implemented, yet.
      */
 
-    gfid = unifyfs_generate_gfid(path);
     fid = unifyfs_get_fid_from_path(path);
+    gfid = unifyfs_gfid_from_path(path, fid);
 
-    LOGDBG("unifyfs_get_fid_from_path() gave %d (gfid = %d)", fid, gfid);
+    LOGDBG("unifyfs_get_fid_from_path() gave %d (gfid = %" PRIu64 ")",
+           fid, gfid);
 
     found_global =
         (unifyfs_get_global_file_meta(fid, gfid, &gfattr) == UNIFYFS_SUCCESS);
     found_local = (fid >= 0);
 
+    /* cached data of an earlier file at this path is no longer valid
+     * once the path refers to a file that is not laminated */
+    if (!found_global || !gfattr.is_laminated) {
+        unifyfs_pagecache_invalidate(gfid);
+    }
+
     /*
      * Catch any case where we could potentially want to write to a laminated
      * file.
@@ -1401,13 +1583,24 @@ int unifyfs_fid_close(int fid)
 {
     /* TODO: clear any held locks */
 
-    /* nothing to do here, just a place holder */
-    return UNIFYFS_SUCCESS;
+    /* let asynchronous reads of the file finish first */
+    unifyfs_aio_drain(fid);
+
+    /* do not leave the extents of our writes in private memory,
+     * the next fsync of any file hands them to the server */
+    int rc = unifyfs_flush_file_extents(fid);
+    if (rc != UNIFYFS_SUCCESS) {
+        LOGERR("failed to flush write extents of fid=%d", fid);
+    }
+    return rc;
 }
 
 /* delete a file id and return file its resources to free pools */
 int unifyfs_fid_unlink(int fid)
 {
+    /* a new file at this path would get the same global file id */
+    unifyfs_pagecache_invalidate(unifyfs_gfid_from_fid(fid));
+
     /* return data to free pools */
     int rc = unifyfs_fid_truncate(fid, 0);
     if (rc != UNIFYFS_SUCCESS) {
@@ -1430,6 +1623,7 @@ int unifyfs_fid_unlink(int fid)
      * release the file id itself */
 
     /* set this file id as not in use */
+    unifyfs_path_index_remove(unifyfs_filelist[fid].filename);
     unifyfs_filelist[fid].in_use = 0;
 
     /* add this id back to the free stack */
@@ -1614,8 +1808,11 @@ static void* unifyfs_init_pointers(void* superblock)
         unifyfs_chunks = NULL;
     }
 
-    /* record pointer to number of index entries */
-    unifyfs_indices.ptr_num_entries = (size_t*)ptr;
+    /* record pointer to number of index entries, and to number
+     * of those entries already synced to the server */
+    unifyfs_index_hdr_t* idx_hdr = (unifyfs_index_hdr_t*)ptr;
+    unifyfs_indices.ptr_num_entries = &(idx_hdr->num_entries);
+    unifyfs_indices.ptr_num_synced  = &(idx_hdr->synced_entries);
 
     /* pointer to array of index entries */
     ptr += unifyfs_page_size;
@@ -1679,6 +1876,7 @@ static int unifyfs_init_structures()
 
     /* initialize count of key/value entries */
     *(unifyfs_indices.ptr_num_entries) = 0;
+    *(unifyfs_indices.ptr_num_synced)  = 0;
 
     /* initialize count of file stat structures */
     *(unifyfs_fattrs.ptr_num_entries) = 0;
@@ -1715,6 +1913,88 @@ static int unifyfs_get_spillblock(size_t size, const char* path)
     return spillblock_fd;
 }
 
+/* returns pointer to length bytes at offset within superblock of
+ * the given local client, mapping the superblock if needed, and sets
+ * gen to the generation of the mapping (0 for our own superblock),
+ * returns NULL on failure */
+char* unifyfs_peer_superblock_ptr(int peer_app, int peer_id,
+                                  size_t offset, size_t length,
+                                  uint64_t* gen)
+{
+    char shm_name[GEN_STR_LEN];
+    char* ptr = NULL;
+
+    if ((peer_id < 0) || (peer_id >= MAX_NUM_CLIENTS)) {
+        LOGERR("invalid local client id %d", peer_id);
+        return NULL;
+    }
+
+    /* data is in our own superblock */
+    if ((peer_app == app_id) && (peer_id == local_rank_idx)) {
+        if ((offset + length) > shm_super_size) {
+            return NULL;
+        }
+        *gen = 0;
+        return (char*)shm_super_buf + offset;
+    }
+
+    pthread_mutex_lock(&peer_superblocks_lock);
+
+    peer_superblock_t* peer = &(peer_superblocks[peer_id]);
+    snprintf(shm_name, sizeof(shm_name), "%d-super-%d", peer_app, peer_id);
+    if ((NULL != peer->addr) && (peer->app_id != peer_app)) {
+        /* another thread may still be copying from the old mapping */
+        peer_superblock_t* old = malloc(sizeof(peer_superblock_t));
+        if (NULL == old) {
+            LOGERR("failed to replace mapping of superblock %s", shm_name);
+            pthread_mutex_unlock(&peer_superblocks_lock);
+            return NULL;
+        }
+        *old = *peer;
+        old->next = peer_superblocks_replaced;
+        peer_superblocks_replaced = old;
+        peer->addr = NULL;
+    }
+    if (NULL == peer->addr) {
+        peer->addr = unifyfs_shm_attach_ro(shm_name, &(peer->size));
+        if (NULL != peer->addr) {
+            peer->app_id = peer_app;
+            peer->gen++;
+        }
+    }
+
+    if (NULL == peer->addr) {
+        /* failed to map */
+    } else if ((offset + length) > peer->size) {
+        LOGERR("offset=%zu length=%zu beyond superblock %s", offset, length,
+               shm_name);
+    } else {
+        ptr = (char*)peer->addr + offset;
+        *gen = peer->gen;
+    }
+
+    pthread_mutex_unlock(&peer_superblocks_lock);
+
+    return ptr;
+}
+
+/* returns 1 if the superblock mapping of the given local client is
+ * still the one of generation gen, i.e., data copied from a pointer
+ * returned with gen came from the intended superblock, 0 otherwise */
+int unifyfs_peer_superblock_valid(int peer_id, uint64_t gen)
+{
+    /* generation 0 is our own superblock, which is never remapped */
+    if (0 == gen) {
+        return 1;
+    }
+
+    pthread_mutex_lock(&peer_superblocks_lock);
+    int valid = (peer_superblocks[peer_id].gen == gen);
+    pthread_mutex_unlock(&peer_superblocks_lock);
+
+    return valid;
+}
+
 /* create superblock of specified size and name, or attach to existing
  * block if available */
 static void* unifyfs_superblock_shmget(size_t size, key_t key)
@@ -1747,6 +2027,9 @@ static void* unifyfs_superblock_shmget(size_t size, key_t key)
         *(int32_t*)addr = 0xDEADBEEF;
     }
 
+    /* index the paths of any files already in the superblock */
+    unifyfs_path_index_rebuild();
+
     /* return starting memory address of super block */
     return addr;
 }
@@ -1819,6 +2102,26 @@ static int unifyfs_init(int rank)
         }
         LOGDBG("are we using spillover? %d", unifyfs_use_spillover);
 
+        /* will fsync publish index metadata in the background? */
+        unifyfs_async_fsync = 0;
+        cfgval = client_cfg.client_async_fsync;
+        if (cfgval != NULL) {
+            rc = configurator_bool_val(cfgval, &b);
+            if ((rc == 0) && b) {
+                unifyfs_async_fsync = 1;
+            }
+        }
+
+        /* serve reads of data we wrote from our log? */
+        unifyfs_local_reads = 0;
+        cfgval = client_cfg.client_local_reads;
+        if (cfgval != NULL) {
+            rc = configurator_bool_val(cfgval, &b);
+            if ((rc == 0) && b) {
+                unifyfs_local_reads = 1;
+            }
+        }
+
         /* determine maximum number of bytes of spillover for chunk storage */
         unifyfs_spillover_size = UNIFYFS_SPILLOVER_SIZE;
         cfgval = client_cfg.spillover_size;
@@ -1839,6 +2142,27 @@ static int unifyfs_init(int rank)
             }
         }
 
+        /* set up cache of laminated file data */
+        long cache_size = UNIFYFS_PAGE_CACHE_SIZE;
+        long cache_block = UNIFYFS_PAGE_CACHE_BLOCK;
+        cfgval = client_cfg.client_page_cache_size;
+        if (cfgval != NULL) {
+            rc = configurator_int_val(cfgval, &l);
+            if (rc == 0) {
+                cache_size = l;
+            }
+        }
+        cfgval = client_cfg.client_page_cache_block;
+        if (cfgval != NULL) {
+            rc = configurator_int_val(cfgval, &l);
+            if (rc == 0) {
+                cache_block = l;
+            }
+        }
+        if ((cache_size > 0) && (cache_block > 0)) {
+            unifyfs_pagecache_init((size_t)cache_size, (size_t)cache_block);
+        }
+
         /* determine number of bits for chunk size */
         unifyfs_chunk_bits = UNIFYFS_CHUNK_BITS;
         cfgval = client_cfg.shmem_chunk_bits;
@@ -1859,6 +2183,9 @@ static int unifyfs_init(int rank)
             }
         }
 
+        /* select how we wait on the server to fill our recv shmem */
+        unifyfs_shm_wait_init(&client_cfg);
+
         /* set chunk size, set chunk offset mask, and set total number
          * of chunks */
         unifyfs_chunk_size = 1 << unifyfs_chunk_bits;
@@ -2060,6 +2387,7 @@ void fill_client_mount_info(unifyfs_mount_in_t* in)
     in->num_procs_per_node = local_rank_cnt;
     in->req_buf_sz         = shm_req_size;
     in->recv_buf_sz        = shm_recv_size;
+    in->recv_buf_slots     = shm_recv_slots;
     in->superblock_sz      = shm_super_size;
     in->meta_offset        = meta_offset;
     in->meta_size          = meta_size;
@@ -2085,6 +2413,16 @@ static int unifyfs_init_recv_shm(int local_rank_idx, int app_id)
         }
     }
 
+    /* get number of slots to split region into */
+    cfgval = client_cfg.shmem_recv_slots;
+    if (cfgval != NULL) {
+        long l;
+        int rc = configurator_int_val(cfgval, &l);
+        if ((rc == 0) && (l > 0)) {
+            shm_recv_slots = (int)l;
+        }
+    }
+
     /* define file name to shared memory file */
     snprintf(shm_recv_name, sizeof(shm_recv_name),
              "%d-recv-%d", app_id, local_rank_idx);
@@ -2132,6 +2470,26 @@ static int unifyfs_init_req_shm(int local_rank_idx, int app_id)
         return UNIFYFS_FAILURE;
     }
 
+    /* start with an empty read request ring */
+    shm_req_ring_t* ring = (shm_req_ring_t*) shm_req_buf;
+    ring->rc = (int)UNIFYFS_SUCCESS;
+    ring->op_done = 0;
+    ring->head = 0;
+    ring->tail = 0;
+    unifyfs_shm_set_state(&(ring->hdr), SHMEM_REGION_EMPTY);
+
+    /* map the doorbell the server created, without it the server
+     * keeps polling our ring */
+    if (shm_bell_id >= 0) {
+        snprintf(shm_bell_name, sizeof(shm_bell_name),
+                 "%d-bell", shm_bell_id);
+        shm_bell = (shm_header_t*)
+            unifyfs_shm_alloc(shm_bell_name, sizeof(shm_header_t));
+        if (shm_bell == NULL) {
+            LOGERR("Failed to map server doorbell %s", shm_bell_name);
+        }
+    }
+
     return UNIFYFS_SUCCESS;
 }
 
@@ -2606,9 +2964,27 @@ static int unifyfs_finalize(void)
         unifyfs_spillmetablock = 0;
     }
 
+    /* free path index before detaching from superblock */
+    unifyfs_path_index_free();
+
     /* detach from superblock */
     unifyfs_shm_free(shm_super_name, shm_super_size, &shm_super_buf);
 
+    /* detach from superblocks of other local clients */
+    int i;
+    pthread_mutex_lock(&peer_superblocks_lock);
+    for (i = 0; i < MAX_NUM_CLIENTS; i++) {
+        peer_superblock_t* peer = &(peer_superblocks[i]);
+        unifyfs_shm_detach("peer superblock", peer->size, &(peer->addr));
+    }
+    while (NULL != peer_superblocks_replaced) {
+        peer_superblock_t* old = peer_superblocks_replaced;
+        peer_superblocks_replaced = old->next;
+        unifyfs_shm_detach("peer superblock", old->size, &(old->addr));
+        free(old);
+    }
+    pthread_mutex_unlock(&peer_superblocks_lock);
+
     /* free directory stream stack */
     if (unifyfs_dirstream_stack != NULL) {
         free(unifyfs_dirstream_stack);
@@ -2652,8 +3028,19 @@ int unifyfs_unmount(void)
      * tear down connection to server
      ************************/
 
+    /* complete outstanding asynchronous reads */
+    unifyfs_aio_fini();
+
+    /* report time spent waiting on read data from server */
+    unifyfs_shm_wait_log_stats("client");
+
+    /* drop cached laminated file data */
+    unifyfs_pagecache_fini();
+
     /* detach from shared memory regions */
     unifyfs_shm_free(shm_req_name,  shm_req_size,  &shm_req_buf);
+    unifyfs_shm_detach(shm_bell_name, sizeof(shm_header_t),
+                       (void**)&shm_bell);
     unifyfs_shm_free(shm_recv_name, shm_recv_size, &shm_recv_buf);
 
     /* close socket to server */
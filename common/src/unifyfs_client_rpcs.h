@@ -27,6 +27,7 @@ MERCURY_GEN_PROC(unifyfs_mount_in_t,
                  ((hg_const_string_t)(client_addr_str))
                  ((hg_size_t)(req_buf_sz))
                  ((hg_size_t)(recv_buf_sz))
+                 ((int32_t)(recv_buf_slots))
                  ((hg_size_t)(superblock_sz))
                  ((hg_size_t)(meta_offset))
                  ((hg_size_t)(meta_size))
@@ -37,6 +38,7 @@ MERCURY_GEN_PROC(unifyfs_mount_in_t,
                  ((hg_const_string_t)(external_spill_dir)))
 MERCURY_GEN_PROC(unifyfs_mount_out_t,
                  ((hg_size_t)(max_recs_per_slice))
+                 ((int32_t)(bell_id))
                  ((int32_t)(ret)))
 DECLARE_MARGO_RPC_HANDLER(unifyfs_mount_rpc)
 
@@ -62,7 +64,7 @@ MERCURY_GEN_STRUCT_PROC(sys_timespec_t,
 MERCURY_GEN_PROC(unifyfs_metaset_in_t,
                  ((hg_const_string_t)(filename))
                  ((int32_t)(fid))
-                 ((int32_t)(gfid))
+                 ((uint64_t)(gfid))
                  ((uint32_t)(mode))
                  ((uint32_t)(uid))
                  ((uint32_t)(gid))
@@ -79,12 +81,12 @@ DECLARE_MARGO_RPC_HANDLER(unifyfs_metaset_rpc)
  * returns file metadata including size and name
  * given a global file id */
 MERCURY_GEN_PROC(unifyfs_metaget_in_t,
-                 ((int32_t)(gfid)))
+                 ((uint64_t)(gfid)))
 MERCURY_GEN_PROC(unifyfs_metaget_out_t,
                  ((int32_t)(ret))
                  ((hg_const_string_t)(filename))
                  ((int32_t)(fid))
-                 ((int32_t)(gfid))
+                 ((uint64_t)(gfid))
                  ((uint32_t)(mode))
                  ((uint32_t)(uid))
                  ((uint32_t)(gid))
@@ -99,11 +101,14 @@ DECLARE_MARGO_RPC_HANDLER(unifyfs_metaget_rpc)
  *
  * given app_id, client_id, and a global file id as input,
  * read extent location metadata from client shared memory
- * and insert corresponding key/value pairs into global index */
+ * and insert corresponding key/value pairs into global index,
+ * if async is set the server returns once it has copied the
+ * metadata and inserts it in the background */
 MERCURY_GEN_PROC(unifyfs_fsync_in_t,
                  ((int32_t)(app_id))
                  ((int32_t)(local_rank_idx))
-                 ((int32_t)(gfid)))
+                 ((uint64_t)(gfid))
+                 ((int32_t)(async)))
 MERCURY_GEN_PROC(unifyfs_fsync_out_t, ((int32_t)(ret)))
 DECLARE_MARGO_RPC_HANDLER(unifyfs_fsync_rpc)
 
@@ -114,39 +119,12 @@ DECLARE_MARGO_RPC_HANDLER(unifyfs_fsync_rpc)
 MERCURY_GEN_PROC(unifyfs_filesize_in_t,
                  ((int32_t)(app_id))
                  ((int32_t)(local_rank_idx))
-                 ((int32_t)(gfid)))
+                 ((uint64_t)(gfid)))
 MERCURY_GEN_PROC(unifyfs_filesize_out_t,
                  ((int32_t)(ret))
                  ((hg_size_t)(filesize)))
 DECLARE_MARGO_RPC_HANDLER(unifyfs_filesize_rpc)
 
-/* unifyfs_read_rpc (client => server)
- *
- * given an app_id, client_id, global file id, an offset, and a length,
- * initiate read request for data */
-MERCURY_GEN_PROC(unifyfs_read_in_t,
-                 ((int32_t)(app_id))
-                 ((int32_t)(local_rank_idx))
-                 ((int32_t)(gfid))
-                 ((hg_size_t)(offset))
-                 ((hg_size_t)(length)))
-MERCURY_GEN_PROC(unifyfs_read_out_t, ((int32_t)(ret)))
-DECLARE_MARGO_RPC_HANDLER(unifyfs_read_rpc)
-
-/* unifyfs_mread_rpc (client => server)
- *
- * given an app_id, client_id, global file id, and a count
- * of read requests, followed by list of offset/length tuples
- * initiate read requests for data */
-MERCURY_GEN_PROC(unifyfs_mread_in_t,
-                 ((int32_t)(app_id))
-                 ((int32_t)(local_rank_idx))
-                 ((int32_t)(read_count))
-                 ((hg_size_t)(bulk_size))
-                 ((hg_bulk_t)(bulk_handle)))
-MERCURY_GEN_PROC(unifyfs_mread_out_t, ((int32_t)(ret)))
-DECLARE_MARGO_RPC_HANDLER(unifyfs_mread_rpc)
-
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -69,7 +69,11 @@
     UNIFYFS_CFG_CLI(unifyfs, consistency, STRING, LAMINATED, "consistency model", NULL, 'c', "specify consistency model (NONE | LAMINATED | POSIX)") \
     UNIFYFS_CFG_CLI(unifyfs, daemonize, BOOL, on, "enable server daemonization", NULL, 'D', "on|off") \
     UNIFYFS_CFG_CLI(unifyfs, mountpoint, STRING, /unifyfs, "mountpoint directory", NULL, 'm', "specify full path to desired mountpoint") \
+    UNIFYFS_CFG(client, async_fsync, BOOL, off, "return from fsync before server publishes metadata", NULL) \
+    UNIFYFS_CFG(client, local_reads, BOOL, off, "serve reads of data written by this process from its own log", NULL) \
     UNIFYFS_CFG(client, max_files, INT, UNIFYFS_MAX_FILES, "client max file count", NULL) \
+    UNIFYFS_CFG(client, page_cache_block, INT, UNIFYFS_PAGE_CACHE_BLOCK, "block size in bytes of laminated file cache", NULL) \
+    UNIFYFS_CFG(client, page_cache_size, INT, UNIFYFS_PAGE_CACHE_SIZE, "size in bytes of laminated file cache (0 = disabled)", NULL) \
     UNIFYFS_CFG_CLI(log, verbosity, INT, 0, "log verbosity level", NULL, 'v', "specify logging verbosity level") \
     UNIFYFS_CFG_CLI(log, file, STRING, unifyfsd.log, "log file name", NULL, 'l', "specify log file name") \
     UNIFYFS_CFG_CLI(log, dir, STRING, LOGDIR, "log file directory", configurator_directory_check, 'L', "specify full path to directory to contain log file") \
@@ -78,20 +82,29 @@
     UNIFYFS_CFG(margo, tcp, BOOL, on, "use TCP for server-server margo RPCs", NULL) \
     UNIFYFS_CFG(meta, db_name, STRING, META_DEFAULT_DB_NAME, "metadata database name", NULL) \
     UNIFYFS_CFG(meta, db_path, STRING, RUNDIR, "metadata database path", configurator_directory_check) \
+    UNIFYFS_CFG(meta, extent_cache, BOOL, on, "cache file extents from range queries", NULL) \
+    UNIFYFS_CFG(meta, extent_cache_ttl, INT, 0, "seconds to cache extents of non-laminated files", NULL) \
     UNIFYFS_CFG(meta, server_ratio, INT, META_DEFAULT_SERVER_RATIO, "metadata server ratio", NULL) \
     UNIFYFS_CFG(meta, range_size, INT, META_DEFAULT_RANGE_SZ, "metadata range size", NULL) \
+    UNIFYFS_CFG(meta, num_workers, INT, META_DEFAULT_NUM_WORKERS, "metadata worker threads per range server", NULL) \
     UNIFYFS_CFG_CLI(runstate, dir, STRING, RUNDIR, "runstate file directory", configurator_directory_check, 'R', "specify full path to directory to contain server runstate file") \
     UNIFYFS_CFG_CLI(server, hostfile, STRING, NULLSTRING, "server hostfile name", NULL, 'H', "specify full path to server hostfile") \
+    UNIFYFS_CFG(server, readahead_size, INT, UNIFYFS_READAHEAD_SIZE, "read-ahead window size in bytes for sequential reads of laminated files (0 = disabled)", NULL) \
+    UNIFYFS_CFG(server, reqmgr_threads, INT, UNIFYFS_REQMGR_THREADS, "request manager worker threads (0 = one per core)", NULL) \
     UNIFYFS_CFG_CLI(sharedfs, dir, STRING, NULLSTRING, "shared file system directory", configurator_directory_check, 'S', "specify full path to directory to contain server shared files") \
     UNIFYFS_CFG(shmem, chunk_bits, INT, UNIFYFS_CHUNK_BITS, "shared memory data chunk size in bits (i.e., size=2^bits)", NULL) \
     UNIFYFS_CFG(shmem, chunk_mem, INT, UNIFYFS_CHUNK_MEM, "shared memory segment size for data chunks", NULL) \
     UNIFYFS_CFG(shmem, recv_size, INT, UNIFYFS_SHMEM_RECV_SIZE, "shared memory segment size in bytes for receiving data from delegators", NULL) \
+    UNIFYFS_CFG(shmem, recv_slots, INT, UNIFYFS_SHMEM_RECV_SLOTS, "number of slots the receive segment is split into", NULL) \
     UNIFYFS_CFG(shmem, req_size, INT, UNIFYFS_SHMEM_REQ_SIZE, "shared memory segment size in bytes for sending requests to delegators", NULL) \
     UNIFYFS_CFG(shmem, single, BOOL, off, "use single shared memory region for all clients", NULL) \
+    UNIFYFS_CFG(shmem, wait_mode, STRING, futex, "shared memory wait mode (poll | futex)", NULL) \
+    UNIFYFS_CFG(shmem, wait_spin, INT, UNIFYFS_SHMEM_WAIT_SPIN, "max shared memory state checks before blocking", NULL) \
     UNIFYFS_CFG(spillover, enabled, BOOL, on, "use local device for data chunk spillover", NULL) \
     UNIFYFS_CFG(spillover, data_dir, STRING, NULLSTRING, "spillover data directory", configurator_directory_check) \
     UNIFYFS_CFG(spillover, meta_dir, STRING, NULLSTRING, "spillover metadata directory", configurator_directory_check) \
     UNIFYFS_CFG(spillover, size, INT, UNIFYFS_SPILLOVER_SIZE, "spillover max data size in bytes", NULL) \
+    UNIFYFS_CFG(spillover, read_threads, INT, UNIFYFS_SPILLOVER_READ_THREADS, "server threads reading spillover data for remote reads", NULL) \
 
 #ifdef __cplusplus
 extern "C" {
@@ -54,19 +54,28 @@
 #define MAX_FILE_CNT_PER_NODE KIB
 
 // Request Manager
-#define RECV_BUF_CNT 4               /* number of remote read buffers */
-#define SENDRECV_BUF_LEN (8 * MIB)   /* remote read buffer size */
-#define MAX_META_PER_SEND (4 * KIB)  /* max read request count per server */
-#define REQ_BUF_LEN (MAX_META_PER_SEND * 64) /* chunk read reqs buffer size */
+#define RECV_BUF_CNT 4               /* chunk read windows in flight/server */
+#define SENDRECV_BUF_LEN (8 * MIB)   /* max data per chunk read window */
+#define MAX_META_PER_SEND (4 * KIB)  /* max chunk reads per window */
 #define SHM_WAIT_INTERVAL 1000       /* unit: ns */
+#define SHM_WAIT_MIN_SPIN 16         /* min state checks before blocking */
 #define RM_MAX_ACTIVE_REQUESTS 64    /* number of concurrent read requests */
-
-// Service Manager
-#define LARGE_BURSTY_DATA (512 * MIB)
-#define MAX_BURSTY_INTERVAL 10000 /* unit: us */
-#define MIN_SLEEP_INTERVAL 100    /* unit: us */
-#define SLEEP_INTERVAL 500        /* unit: us */
-#define SLEEP_SLICE_PER_UNIT 50   /* unit: us */
+#define RM_FSYNC_BATCH_SIZE (16 * KIB) /* extents per metadata batch put */
+#define RM_FSYNC_MAX_ATTEMPTS 5      /* publish attempts per async fsync */
+#define RM_FSYNC_RETRY_USEC 100000   /* delay before first publish retry */
+#define RM_MAX_WORKERS 64            /* max request manager worker threads */
+#define UNIFYFS_REQMGR_THREADS 0     /* default workers, 0 = one per core */
+#define UNIFYFS_READAHEAD_SIZE (4 * MIB) /* default read-ahead window size */
+#define RM_READAHEAD_MIN_SEQ 2       /* sequential reads before read-ahead */
+#define RM_READAHEAD_WINDOWS 2       /* read-ahead windows per client */
+#define RM_RING_POLL_MAX 100000      /* max ns between polls of idle rings */
+#define RM_RING_PARK_MS 1000         /* max ms blocked on the ring doorbell */
+
+// Read Path Buffer Pool
+#define BUFPOOL_MIN_SHIFT 12         /* smallest pooled buffer (4 KiB) */
+#define BUFPOOL_MAX_SHIFT 26         /* largest pooled buffer (64 MiB) */
+#define BUFPOOL_MAX_CACHED (64 * MIB) /* max cached bytes per size class */
+#define BUFPOOL_MAX_TOTAL (256 * MIB) /* max cached bytes of all classes */
 
 // Request and Service Managers, Command Handler
 #define MAX_NUM_CLIENTS 64 /* app processes per server */
@@ -81,20 +90,23 @@
 #define UNIFYFS_CHUNK_BITS 24
 #define UNIFYFS_CHUNK_MEM (256 * MIB)
 #define UNIFYFS_SPILLOVER_SIZE (KIB * MIB)
+#define UNIFYFS_SPILLOVER_READ_THREADS 4
 #define UNIFYFS_SUPERBLOCK_KEY 4321
 #define UNIFYFS_SHMEM_REQ_SIZE (8 * MIB)
 #define UNIFYFS_SHMEM_RECV_SIZE (32 * MIB)
+#define UNIFYFS_SHMEM_RECV_SLOTS 2
+#define UNIFYFS_SHMEM_WAIT_SPIN 1024
 #define UNIFYFS_INDEX_BUF_SIZE  (20 * MIB)
 #define UNIFYFS_FATTR_BUF_SIZE MIB
 #define UNIFYFS_MAX_READ_CNT KIB
-
-/* NOTE: max read size = UNIFYFS_MAX_SPLIT_CNT * META_DEFAULT_RANGE_SZ */
-#define UNIFYFS_MAX_SPLIT_CNT (4 * KIB)
+#define UNIFYFS_PAGE_CACHE_SIZE 0    /* laminated file cache, 0 = disabled */
+#define UNIFYFS_PAGE_CACHE_BLOCK MIB /* laminated file cache block size */
 
 // Metadata/MDHIM Default Values
 #define META_DEFAULT_DB_NAME unifyfs_db
 #define META_DEFAULT_SERVER_RATIO 1
 #define META_DEFAULT_RANGE_SZ MIB
+#define META_DEFAULT_NUM_WORKERS 4
 
 #endif // UNIFYFS_CONST_H
 
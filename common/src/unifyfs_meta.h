@@ -43,7 +43,7 @@ typedef enum {
 
 typedef struct {
     int fid;
-    int gfid;
+    uint64_t gfid;
     char filename[UNIFYFS_MAX_FILENAME];
 
     /* essential stat fields */
@@ -100,21 +100,38 @@ typedef struct {
     off_t file_pos; /* starting logical offset of data in file */
     off_t log_pos;  /* starting physical offset of data in log */
     size_t length;  /* length of data */
-    int fid;        /* global file id */
+    uint64_t fid;   /* global file id */
 } unifyfs_index_t;
 
+/* Header at the start of the index region in the client superblock,
+ * the index entries start one page into the region.
+ *   num_entries    - number of index entries written by the client
+ *   synced_entries - leading entries the server has taken by fsync,
+ *                    the client drops these when it compacts its index */
+typedef struct {
+    size_t num_entries;
+    size_t synced_entries;
+} unifyfs_index_hdr_t;
+
 /* Header for read request reply in client shared memory region.
  * The associated data payload immediately follows the header in
  * the shmem region.
  *   offset  - offset within file
  *   length  - data size
  *   gfid    - global file id
- *   errcode - read error code (zero on success) */
+ *   errcode - read error code (zero on success)
+ *   src_app    - app id of local client holding data (if src_client >= 0)
+ *   src_client - local client whose superblock holds the data, or -1
+ *                when the data payload follows the header
+ *   src_offset - offset of data within the superblock of src_client */
 typedef struct {
     size_t offset;
     size_t length;
-    int gfid;
+    uint64_t gfid;
     int errcode;
+    int src_app;
+    int src_client;
+    size_t src_offset;
 } shm_meta_t;
 
 /* State values for client shared memory region */
@@ -128,12 +145,14 @@ typedef enum {
  *   sync     - for synchronizing updates/access by server threads
  *   meta_cnt - number of shm_meta_t (i.e., read replies) currently in shmem
  *   bytes    - total bytes of shmem region in use (shm_meta_t + payloads)
- *   state    - region state variable used for client-server coordination */
+ *   state    - region state variable used for client-server coordination
+ *   waiters  - number of threads blocked on a futex for state to change */
  typedef struct {
     pthread_mutex_t sync;
     volatile size_t meta_cnt;
     volatile size_t bytes;
     volatile shm_region_state_e state;
+    volatile int waiters;
 } shm_header_t;
 
 #ifdef __cplusplus
@@ -39,7 +39,9 @@ DECLARE_MARGO_RPC_HANDLER(server_request_rpc)
 
 /* chunk_read_request_rpc (server => server)
  *
- * request for chunk reads from another server */
+ * request for chunk reads from another server, if resp_size is
+ * non-zero the responses are pushed into resp_handle before the
+ * rpc returns, otherwise they are sent by chunk_read_response_rpc */
 MERCURY_GEN_PROC(chunk_read_request_in_t,
                  ((int32_t)(src_rank))
                  ((int32_t)(app_id))
@@ -47,9 +49,12 @@ MERCURY_GEN_PROC(chunk_read_request_in_t,
                  ((int32_t)(req_id))
                  ((int32_t)(num_chks))
                  ((hg_size_t)(bulk_size))
-                 ((hg_bulk_t)(bulk_handle)))
+                 ((hg_bulk_t)(bulk_handle))
+                 ((hg_size_t)(resp_size))
+                 ((hg_bulk_t)(resp_handle)))
 MERCURY_GEN_PROC(chunk_read_request_out_t,
-                 ((int32_t)(ret)))
+                 ((int32_t)(ret))
+                 ((hg_size_t)(resp_size)))
 DECLARE_MARGO_RPC_HANDLER(chunk_read_request_rpc)
 
 /* chunk_read_response_rpc (server => server)
@@ -67,6 +72,30 @@ MERCURY_GEN_PROC(chunk_read_response_out_t,
                  ((int32_t)(ret)))
 DECLARE_MARGO_RPC_HANDLER(chunk_read_response_rpc)
 
+/* fsync_flush_rpc (server => server)
+ *
+ * wait until the asynchronous fsyncs of an app queued
+ * at the target server have been published */
+MERCURY_GEN_PROC(fsync_flush_in_t,
+                 ((int32_t)(src_rank))
+                 ((int32_t)(app_id)))
+MERCURY_GEN_PROC(fsync_flush_out_t,
+                 ((int32_t)(ret)))
+DECLARE_MARGO_RPC_HANDLER(fsync_flush_rpc)
+
+/* extents_invalidate_rpc (server => server)
+ *
+ * drop cached extents of the files whose global file ids are in
+ * the bulk buffer, after new extents of them have been stored */
+MERCURY_GEN_PROC(extents_invalidate_in_t,
+                 ((int32_t)(src_rank))
+                 ((int32_t)(num_gfids))
+                 ((hg_size_t)(bulk_size))
+                 ((hg_bulk_t)(bulk_handle)))
+MERCURY_GEN_PROC(extents_invalidate_out_t,
+                 ((int32_t)(ret)))
+DECLARE_MARGO_RPC_HANDLER(extents_invalidate_rpc)
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -16,14 +16,37 @@
 #include <unistd.h>
 #include <stdlib.h>
 #include <errno.h>
+#include <limits.h>
 #include <string.h>
+#include <strings.h>
+#include <time.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <fcntl.h>
 
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#define UNIFYFS_HAVE_FUTEX 1
+#endif
+
 #include "unifyfs_log.h"
 #include "unifyfs_const.h"
+#include "unifyfs_shm.h"
+
+/* wait mode and max spin count, set by unifyfs_shm_wait_init() */
+static shm_wait_mode_e shm_wait_mode = SHMEM_WAIT_FUTEX;
+static int shm_wait_max_spin = UNIFYFS_SHMEM_WAIT_SPIN;
+
+/* current spin count, adapted between SHM_WAIT_MIN_SPIN and
+ * shm_wait_max_spin based on whether recent waits finished while
+ * spinning. Shared by all threads in the process, races are benign. */
+static volatile int shm_wait_spin = UNIFYFS_SHMEM_WAIT_SPIN;
+
+/* wait counters, updated atomically since server request manager
+ * threads may wait concurrently */
+static shm_wait_stats_t shm_wait_stats;
 
 /* TODO: same function exists in client code, move this to common */
 /* creates a shared memory of given size under specified name,
@@ -139,3 +162,376 @@ int unifyfs_shm_free(const char* name, size_t size, void** paddr)
 
     return UNIFYFS_SUCCESS;
 }
+
+/* maps an existing shared memory region read-only, sets size to
+ * the size of the region, returns address of the region if successful,
+ * returns NULL on error */
+void* unifyfs_shm_attach_ro(const char* name, size_t* size)
+{
+    /* open existing shared memory file */
+    errno = 0;
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd == -1) {
+        LOGERR("Failed to open shared memory %s errno=%d (%s)",
+               name, errno, strerror(errno));
+        return NULL;
+    }
+
+    /* look up size of region */
+    struct stat sb;
+    errno = 0;
+    if (fstat(fd, &sb) == -1) {
+        LOGERR("Failed to stat shared memory %s errno=%d (%s)",
+               name, errno, strerror(errno));
+        close(fd);
+        return NULL;
+    }
+
+    /* map shared memory region into address space */
+    errno = 0;
+    void* addr = mmap(NULL, (size_t)sb.st_size, PROT_READ, MAP_SHARED,
+                      fd, 0);
+    if (addr == MAP_FAILED) {
+        LOGERR("Failed to mmap shared memory %s errno=%d (%s)",
+               name, errno, strerror(errno));
+        close(fd);
+        return NULL;
+    }
+    close(fd);
+
+    *size = (size_t)sb.st_size;
+    return addr;
+}
+
+/* unmaps a shared memory region without unlinking it,
+ * sets paddr to NULL on return, returns UNIFYFS_SUCCESS on success */
+int unifyfs_shm_detach(const char* name, size_t size, void** paddr)
+{
+    if (paddr == NULL) {
+        return UNIFYFS_FAILURE;
+    }
+
+    void* addr = *paddr;
+    if (addr != NULL) {
+        errno = 0;
+        int rc = munmap(addr, size);
+        if (rc == -1) {
+            LOGERR("Failed to unmap shared memory %s errno=%d (%s)",
+                   name, errno, strerror(errno));
+        }
+    }
+
+    *paddr = NULL;
+    return UNIFYFS_SUCCESS;
+}
+
+size_t unifyfs_shm_recv_slot_size(size_t region_sz, int num_slots)
+{
+    if (num_slots < 1) {
+        num_slots = 1;
+    }
+
+    /* keep each slot header on its own cache line */
+    size_t slot_sz = region_sz / (size_t)num_slots;
+    slot_sz &= ~((size_t)63);
+    return slot_sz;
+}
+
+shm_header_t* unifyfs_shm_recv_slot(void* region, size_t region_sz,
+                                    int num_slots, int slot)
+{
+    size_t slot_sz = unifyfs_shm_recv_slot_size(region_sz, num_slots);
+    return (shm_header_t*)((char*)region + ((size_t)slot * slot_sz));
+}
+
+size_t unifyfs_shm_req_ring_capacity(size_t region_sz)
+{
+    if (region_sz <= sizeof(shm_req_ring_t)) {
+        return 0;
+    }
+    return (region_sz - sizeof(shm_req_ring_t)) / sizeof(shm_read_desc_t);
+}
+
+shm_read_desc_t* unifyfs_shm_req_ring_descs(shm_req_ring_t* ring)
+{
+    return (shm_read_desc_t*)(ring + 1);
+}
+
+int unifyfs_shm_wait_init(unifyfs_cfg_t* cfg)
+{
+    int rc;
+    long l;
+
+    if (NULL == cfg) {
+        return (int)UNIFYFS_ERROR_INVAL;
+    }
+
+    shm_wait_mode = SHMEM_WAIT_FUTEX;
+    if (NULL != cfg->shmem_wait_mode) {
+        if (0 == strcasecmp(cfg->shmem_wait_mode, "poll")) {
+            shm_wait_mode = SHMEM_WAIT_POLL;
+        } else if (0 != strcasecmp(cfg->shmem_wait_mode, "futex")) {
+            LOGERR("invalid shmem.wait_mode '%s', using futex",
+                   cfg->shmem_wait_mode);
+        }
+    }
+#if !defined(UNIFYFS_HAVE_FUTEX)
+    shm_wait_mode = SHMEM_WAIT_POLL;
+#endif
+
+    shm_wait_max_spin = UNIFYFS_SHMEM_WAIT_SPIN;
+    if (NULL != cfg->shmem_wait_spin) {
+        rc = configurator_int_val(cfg->shmem_wait_spin, &l);
+        if ((0 == rc) && (l >= 0) && (l <= INT_MAX)) {
+            shm_wait_max_spin = (int)l;
+        }
+    }
+    shm_wait_spin = shm_wait_max_spin;
+
+    memset(&shm_wait_stats, 0, sizeof(shm_wait_stats));
+
+    LOGDBG("shmem wait mode=%s max_spin=%d",
+           (shm_wait_mode == SHMEM_WAIT_FUTEX ? "futex" : "poll"),
+           shm_wait_max_spin);
+
+    return (int)UNIFYFS_SUCCESS;
+}
+
+/* returns 1 if current state of region satisfies the wait condition */
+static inline int shm_state_reached(shm_header_t* hdr,
+                                    shm_region_state_e target,
+                                    int until_equal)
+{
+    int cur = __atomic_load_n((int*)&(hdr->state), __ATOMIC_SEQ_CST);
+    if (until_equal) {
+        return (cur == (int)target);
+    }
+    return (cur != (int)target);
+}
+
+static inline uint64_t shm_elapsed_ns(struct timespec* start)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)(now.tv_sec - start->tv_sec) * 1000000000ULL) +
+           (uint64_t)(now.tv_nsec - start->tv_nsec);
+}
+
+#if defined(UNIFYFS_HAVE_FUTEX)
+/* the shmem region is mapped by multiple processes, so these
+ * must not use the FUTEX_PRIVATE_FLAG variants */
+static inline int shm_futex_wait(volatile void* addr, int val,
+                                 struct timespec* tmo)
+{
+    return (int) syscall(SYS_futex, (int*)addr, FUTEX_WAIT, val,
+                         tmo, NULL, 0);
+}
+
+static inline int shm_futex_wake(volatile void* addr)
+{
+    return (int) syscall(SYS_futex, (int*)addr, FUTEX_WAKE, INT_MAX,
+                         NULL, NULL, 0);
+}
+#endif
+
+void unifyfs_shm_set_state(shm_header_t* hdr, shm_region_state_e state)
+{
+    __atomic_store_n((int*)&(hdr->state), (int)state, __ATOMIC_SEQ_CST);
+
+#if defined(UNIFYFS_HAVE_FUTEX)
+    /* only pay for the syscall when the other side is blocked,
+     * the seq_cst store/load pair orders this check against the
+     * waiter's increment of waiters and its recheck of state */
+    if (__atomic_load_n(&(hdr->waiters), __ATOMIC_SEQ_CST) > 0) {
+        shm_futex_wake(&(hdr->state));
+        __atomic_add_fetch(&(shm_wait_stats.num_wakes), 1,
+                           __ATOMIC_RELAXED);
+    }
+#endif
+}
+
+int unifyfs_shm_wait_state(shm_header_t* hdr,
+                           shm_region_state_e target,
+                           int until_equal,
+                           unsigned int timeout_ms)
+{
+    int rc = (int)UNIFYFS_SUCCESS;
+    int blocked = 0;
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    uint64_t timeout_ns = (uint64_t)timeout_ms * 1000000ULL;
+
+    /* spin for a bit first, the other side is often just about done */
+    int spin = 0;
+    int max_spin = shm_wait_spin;
+    if (shm_wait_mode == SHMEM_WAIT_POLL) {
+        max_spin = 0;
+    }
+    while ((spin < max_spin) && !shm_state_reached(hdr, target, until_equal)) {
+        spin++;
+    }
+
+    if (shm_wait_mode == SHMEM_WAIT_POLL) {
+        /* sleep between checks of state */
+        struct timespec shm_wait_tm;
+        shm_wait_tm.tv_sec  = 0;
+        shm_wait_tm.tv_nsec = SHM_WAIT_INTERVAL;
+        while (!shm_state_reached(hdr, target, until_equal)) {
+            blocked = 1;
+            nanosleep(&shm_wait_tm, NULL);
+            if (shm_elapsed_ns(&start) >= timeout_ns) {
+                rc = (int)UNIFYFS_ERROR_SHMEM;
+                break;
+            }
+        }
+    }
+#if defined(UNIFYFS_HAVE_FUTEX)
+    else {
+        /* block in kernel until state changes */
+        while (!shm_state_reached(hdr, target, until_equal)) {
+            uint64_t elapsed = shm_elapsed_ns(&start);
+            if (elapsed >= timeout_ns) {
+                rc = (int)UNIFYFS_ERROR_SHMEM;
+                break;
+            }
+            uint64_t remain = timeout_ns - elapsed;
+            struct timespec tmo;
+            tmo.tv_sec  = (time_t)(remain / 1000000000ULL);
+            tmo.tv_nsec = (long)(remain % 1000000000ULL);
+
+            blocked = 1;
+            __atomic_add_fetch(&(hdr->waiters), 1, __ATOMIC_SEQ_CST);
+            int cur = __atomic_load_n((int*)&(hdr->state), __ATOMIC_SEQ_CST);
+            if ((until_equal && (cur != (int)target)) ||
+                (!until_equal && (cur == (int)target))) {
+                /* returns immediately with EAGAIN if state != cur,
+                 * EINTR and ETIMEDOUT are handled by the loop */
+                shm_futex_wait(&(hdr->state), cur, &tmo);
+            }
+            __atomic_sub_fetch(&(hdr->waiters), 1, __ATOMIC_SEQ_CST);
+        }
+
+        /* adapt spin count: grow when spinning would have (or did)
+         * suffice, shrink when we ended up blocking anyway */
+        if (blocked) {
+            if (max_spin > SHM_WAIT_MIN_SPIN) {
+                shm_wait_spin = max_spin / 2;
+            }
+        } else if (max_spin < shm_wait_max_spin) {
+            int next = (max_spin < SHM_WAIT_MIN_SPIN) ?
+                       SHM_WAIT_MIN_SPIN : (max_spin * 2);
+            shm_wait_spin = (next > shm_wait_max_spin) ?
+                            shm_wait_max_spin : next;
+        }
+    }
+#endif
+
+    /* update counters */
+    uint64_t wait_ns = shm_elapsed_ns(&start);
+    __atomic_add_fetch(&(shm_wait_stats.num_waits), 1, __ATOMIC_RELAXED);
+    if (blocked) {
+        __atomic_add_fetch(&(shm_wait_stats.num_blocks), 1,
+                           __ATOMIC_RELAXED);
+    } else {
+        __atomic_add_fetch(&(shm_wait_stats.num_spins), 1,
+                           __ATOMIC_RELAXED);
+    }
+    if (rc != (int)UNIFYFS_SUCCESS) {
+        __atomic_add_fetch(&(shm_wait_stats.num_timeout), 1,
+                           __ATOMIC_RELAXED);
+    }
+    __atomic_add_fetch(&(shm_wait_stats.total_ns), wait_ns,
+                       __ATOMIC_RELAXED);
+    uint64_t max_ns = __atomic_load_n(&(shm_wait_stats.max_ns),
+                                      __ATOMIC_RELAXED);
+    while ((wait_ns > max_ns) &&
+           !__atomic_compare_exchange_n(&(shm_wait_stats.max_ns), &max_ns,
+                                        wait_ns, 0, __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED)) {
+        /* max_ns updated with current value on failure, try again */
+    }
+
+    return rc;
+}
+
+void unifyfs_shm_bell_ring(shm_header_t* bell)
+{
+    /* order the caller's ring update before the check of the bell,
+     * pairs with the fence in unifyfs_shm_bell_arm() */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    int cur = __atomic_load_n((int*)&(bell->state), __ATOMIC_SEQ_CST);
+    if (cur == (int)SHMEM_REGION_EMPTY) {
+        unifyfs_shm_set_state(bell, SHMEM_REGION_DATA_READY);
+    }
+}
+
+int unifyfs_shm_bell_arm(shm_header_t* bell)
+{
+#if defined(UNIFYFS_HAVE_FUTEX)
+    if (shm_wait_mode == SHMEM_WAIT_FUTEX) {
+        __atomic_store_n((int*)&(bell->state), (int)SHMEM_REGION_EMPTY,
+                         __ATOMIC_SEQ_CST);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        return 1;
+    }
+#endif
+    return 0;
+}
+
+void unifyfs_shm_bell_wait(shm_header_t* bell, unsigned int timeout_ms)
+{
+#if defined(UNIFYFS_HAVE_FUTEX)
+    struct timespec tmo;
+    tmo.tv_sec  = (time_t)(timeout_ms / 1000);
+    tmo.tv_nsec = (long)(timeout_ms % 1000) * 1000000L;
+
+    /* not counted in the wait stats, which describe read waits */
+    __atomic_add_fetch(&(bell->waiters), 1, __ATOMIC_SEQ_CST);
+    int cur = __atomic_load_n((int*)&(bell->state), __ATOMIC_SEQ_CST);
+    if (cur == (int)SHMEM_REGION_EMPTY) {
+        shm_futex_wait(&(bell->state), cur, &tmo);
+    }
+    __atomic_sub_fetch(&(bell->waiters), 1, __ATOMIC_SEQ_CST);
+#endif
+}
+
+void unifyfs_shm_wait_get_stats(shm_wait_stats_t* stats)
+{
+    if (NULL == stats) {
+        return;
+    }
+    stats->num_waits = __atomic_load_n(&(shm_wait_stats.num_waits),
+                                       __ATOMIC_RELAXED);
+    stats->num_spins = __atomic_load_n(&(shm_wait_stats.num_spins),
+                                       __ATOMIC_RELAXED);
+    stats->num_blocks = __atomic_load_n(&(shm_wait_stats.num_blocks),
+                                        __ATOMIC_RELAXED);
+    stats->num_wakes = __atomic_load_n(&(shm_wait_stats.num_wakes),
+                                       __ATOMIC_RELAXED);
+    stats->num_timeout = __atomic_load_n(&(shm_wait_stats.num_timeout),
+                                         __ATOMIC_RELAXED);
+    stats->total_ns = __atomic_load_n(&(shm_wait_stats.total_ns),
+                                      __ATOMIC_RELAXED);
+    stats->max_ns = __atomic_load_n(&(shm_wait_stats.max_ns),
+                                    __ATOMIC_RELAXED);
+}
+
+void unifyfs_shm_wait_log_stats(const char* who)
+{
+    shm_wait_stats_t stats;
+    unifyfs_shm_wait_get_stats(&stats);
+    if (0 == stats.num_waits) {
+        return;
+    }
+    LOGDBG("%s shmem waits=%llu spin-only=%llu blocked=%llu wakes=%llu "
+           "timeouts=%llu avg=%lluns max=%lluns",
+           (who ? who : ""),
+           (unsigned long long) stats.num_waits,
+           (unsigned long long) stats.num_spins,
+           (unsigned long long) stats.num_blocks,
+           (unsigned long long) stats.num_wakes,
+           (unsigned long long) stats.num_timeout,
+           (unsigned long long) (stats.total_ns / stats.num_waits),
+           (unsigned long long) stats.max_ns);
+}
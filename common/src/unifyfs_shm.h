@@ -15,6 +15,11 @@
 #ifndef UNIFYFS_SHM_H
 #define UNIFYFS_SHM_H
 
+#include <stdint.h>
+
+#include "unifyfs_configurator.h"
+#include "unifyfs_meta.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -30,6 +35,137 @@ void* unifyfs_shm_alloc(const char* name, size_t size);
  * returns UNIFYFS_SUCCESS on success */
 int unifyfs_shm_free(const char* name, size_t size, void** paddr);
 
+/* map an existing named shared memory region read-only, sets size
+ * to the size of the region, returns starting memory address on
+ * success, returns NULL on failure */
+void* unifyfs_shm_attach_ro(const char* name, size_t* size);
+
+/* unmaps a region mapped by unifyfs_shm_attach_ro(), the region itself
+ * is left in place for its owner */
+int unifyfs_shm_detach(const char* name, size_t size, void** paddr);
+
+/* The read reply (recv) region is split into num_slots equal slots,
+ * each starting with its own shm_header_t, so that the server can
+ * fill one slot while the client drains another. Slots are used in
+ * order starting from slot 0 for each read operation. */
+
+/* returns size in bytes of each slot of a recv region */
+size_t unifyfs_shm_recv_slot_size(size_t region_sz, int num_slots);
+
+/* returns header of the given slot of a recv region */
+shm_header_t* unifyfs_shm_recv_slot(void* region, size_t region_sz,
+                                    int num_slots, int slot);
+
+/* The request (req) region holds a single-producer/single-consumer
+ * ring of fixed-size read descriptors, which replaces the read rpcs
+ * for submitting reads to the server.  For each read operation, the
+ * client sets the ring state to SHMEM_REGION_DATA_READY and appends
+ * the descriptors of the operation at head, marking the last one.
+ * The server polls the rings of its clients, takes descriptors from
+ * tail, and once it has the last one starts the reads, records the
+ * result in rc and sets the state back to SHMEM_REGION_EMPTY.
+ * Operations with more descriptors than fit in the ring are fed in
+ * as the server frees space.  head and tail only ever increase, and
+ * descriptor i is stored in entry (i % capacity).
+ *
+ * Each operation is tagged with a sequence number (op), so the server
+ * drops the descriptors of an operation the client gave up on before
+ * posting its last descriptor, and the client only accepts the result
+ * the server tags with the op it is waiting for (op_done). */
+
+/* read descriptor in request ring */
+typedef struct {
+    uint64_t gfid;   /* global file id */
+    size_t offset;   /* file offset */
+    size_t length;   /* number of bytes to read */
+    uint64_t op;     /* sequence number of operation */
+    int last;        /* non-zero on final descriptor of operation */
+} shm_read_desc_t;
+
+/* header at start of request region, head and tail are kept
+ * on their own cache lines since each side writes one of them */
+typedef struct {
+    shm_header_t hdr;                         /* operation state */
+    volatile int rc;                          /* result of operation */
+    volatile uint64_t op_done;                /* op that rc belongs to */
+    volatile uint64_t head __attribute__((aligned(64))); /* by client */
+    volatile uint64_t tail __attribute__((aligned(64))); /* by server */
+} shm_req_ring_t;
+
+/* returns number of descriptors in request ring of region */
+size_t unifyfs_shm_req_ring_capacity(size_t region_sz);
+
+/* returns first descriptor entry of request ring */
+shm_read_desc_t* unifyfs_shm_req_ring_descs(shm_req_ring_t* ring);
+
+/* The doorbell (bell) region is a single shm_header_t created by the
+ * server and mapped by all of its clients.  Once the request rings of
+ * its clients have been idle for a while, the server thread polling
+ * them arms the bell by setting it to SHMEM_REGION_EMPTY, checks the
+ * rings once more, and blocks on the bell.  A client that finds the
+ * bell armed after posting to its ring sets it to
+ * SHMEM_REGION_DATA_READY, which wakes the server. */
+
+/* ring the bell after publishing new ring entries, only stores to
+ * the bell and wakes the server when it is armed */
+void unifyfs_shm_bell_ring(shm_header_t* bell);
+
+/* arm the bell before a last check of the rings, returns 1 if the
+ * caller may block in unifyfs_shm_bell_wait(), or 0 if the wait mode
+ * does not block and the caller should keep polling */
+int unifyfs_shm_bell_arm(shm_header_t* bell);
+
+/* block until the armed bell is rung or timeout_ms milliseconds have
+ * passed, may return early */
+void unifyfs_shm_bell_wait(shm_header_t* bell, unsigned int timeout_ms);
+
+/* methods for waiting on a change to the state of a shmem region */
+typedef enum {
+    SHMEM_WAIT_POLL = 0,  /* check state, nanosleep, repeat */
+    SHMEM_WAIT_FUTEX = 1  /* spin on state, then block on a futex */
+} shm_wait_mode_e;
+
+/* counters describing time spent waiting on shmem region state
+ *   num_waits   - number of calls to unifyfs_shm_wait_state()
+ *   num_spins   - waits satisfied without sleeping/blocking
+ *   num_blocks  - waits that had to sleep or block at least once
+ *   num_wakes   - futex wake calls issued by state updates
+ *   num_timeout - waits that timed out
+ *   total_ns    - total nanoseconds spent in waits
+ *   max_ns      - longest single wait in nanoseconds */
+typedef struct {
+    uint64_t num_waits;
+    uint64_t num_spins;
+    uint64_t num_blocks;
+    uint64_t num_wakes;
+    uint64_t num_timeout;
+    uint64_t total_ns;
+    uint64_t max_ns;
+} shm_wait_stats_t;
+
+/* set shmem wait mode and spin count from shmem.wait_mode
+ * and shmem.wait_spin configuration settings */
+int unifyfs_shm_wait_init(unifyfs_cfg_t* cfg);
+
+/* set state of shmem region and wake any process blocked in
+ * unifyfs_shm_wait_state() on the same region */
+void unifyfs_shm_set_state(shm_header_t* hdr, shm_region_state_e state);
+
+/* wait for the state of shmem region to change. If until_equal is
+ * non-zero, waits until state == target, otherwise waits until
+ * state != target. Gives up after timeout_ms milliseconds.
+ * Returns UNIFYFS_SUCCESS, or UNIFYFS_ERROR_SHMEM on timeout */
+int unifyfs_shm_wait_state(shm_header_t* hdr,
+                           shm_region_state_e target,
+                           int until_equal,
+                           unsigned int timeout_ms);
+
+/* copy current shmem wait counters into stats */
+void unifyfs_shm_wait_get_stats(shm_wait_stats_t* stats);
+
+/* write shmem wait counters to log, prefixed by who */
+void unifyfs_shm_wait_log_stats(const char* who);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
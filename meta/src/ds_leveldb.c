@@ -42,16 +42,6 @@
 #include <sys/time.h>
 #include "ds_leveldb.h"
 
-struct timeval dbputstart, dbputend;
-struct timeval dbgetstart, dbgetend;
-double dbputtime=0, dbgettime=0;
-
-struct timeval dbngetstart, dbngetend;
-double dbngettime=0;
-
-struct timeval dbbputstart, dbbputend;
-double dbbputtime=0;
-
 extern int dbg_rank;
 static void cmp_destroy(void* arg) { }
 
@@ -193,7 +183,7 @@ static int cmp_byte_compare(void* arg, const char* a, size_t alen,
 	int ret;
 
 	long offset, old_offset;
-	long fid, old_fid;
+	unsigned long fid, old_fid;
 
 	fid = *((unsigned long *)a);
 	old_fid = *((unsigned long *)b);
@@ -201,7 +191,8 @@ static int cmp_byte_compare(void* arg, const char* a, size_t alen,
 	offset = *((unsigned long *)a+1);
 	old_offset = *((unsigned long *)b+1);
 
-	ret = fid - old_fid;
+	/* fids are 64-bit hashes, so their difference does not fit in an int */
+	ret = (fid > old_fid) - (fid < old_fid);
 
 	if (ret != 0)
 			return ret;
@@ -223,7 +214,7 @@ static int cmp_unifyfs_compare(void* arg, const char* a, size_t alen,
 	int ret;
 
 	long offset, old_offset;
-	long fid, old_fid;
+	unsigned long fid, old_fid;
 
 	fid = *((unsigned long *)a);
 	old_fid = *((unsigned long *)b);
@@ -231,7 +222,8 @@ static int cmp_unifyfs_compare(void* arg, const char* a, size_t alen,
 	offset = *((unsigned long *)a+1);
 	old_offset = *((unsigned long *)b+1);
 
-	ret = fid - old_fid;
+	/* fids are 64-bit hashes, so their difference does not fit in an int */
+	ret = (fid > old_fid) - (fid < old_fid);
 
 	if (ret != 0)
 			return ret;
@@ -431,7 +423,6 @@ int mdhim_leveldb_put(void *dbh, void *key, int key_len, void *data, int32_t dat
  */
 int mdhim_leveldb_batch_put(void *dbh, void **keys, int32_t *key_lens, 
 			    void **data, int32_t *data_lens, int num_records) {
-	gettimeofday(&dbbputstart, NULL);
 	leveldb_writeoptions_t *options;
 	char *err = NULL;
 	struct mdhim_leveldb_t *mdhimdb = (struct mdhim_leveldb_t *) dbh;
@@ -462,8 +453,6 @@ int mdhim_leveldb_batch_put(void *dbh, void **keys, int32_t *key_lens,
 	gettimeofday(&end, NULL);
     gettimeofday(&end, NULL);
 
-    gettimeofday(&dbbputend, NULL);
-	dbbputtime+=1000000*(dbbputend.tv_sec-dbbputstart.tv_sec)+dbbputend.tv_usec-dbbputstart.tv_usec;
 	mlog(MDHIM_SERVER_DBG, "Took: %d seconds to put %d records", 
 	     (int) (end.tv_sec - start.tv_sec), num_records);
 	
@@ -497,7 +486,6 @@ int mdhim_leveldb_get(void *dbh, void *key, int key_len, void **data, int32_t *d
 
 	options = mdhimdb->read_options;
 	*data = NULL;
-	gettimeofday(&dbgetstart, NULL);
 	ldb_data = leveldb_get(mdhimdb->db, options, key, key_len, &ldb_data_len, &err);
 	if (err != NULL) {
 		mlog(MDHIM_SERVER_CRIT, "Error getting value in leveldb");
@@ -513,9 +501,6 @@ int mdhim_leveldb_get(void *dbh, void *key, int key_len, void **data, int32_t *d
 	*data = malloc(*data_len);
 	memcpy(*data, ldb_data, *data_len);
 	free(ldb_data);
-	gettimeofday(&dbgetend, NULL);
-	dbgettime+=1000000*(dbgetend.tv_sec-dbgetstart.tv_sec) + \
-		dbgetend.tv_usec-dbgetstart.tv_usec;
 	return ret;
 }
 
@@ -544,7 +529,6 @@ int mdhim_leveldb_get_next(void *dbh, void **key, int *key_len,
 	struct timeval start, end;
 	int cmp_ret = -5;
 
-	gettimeofday(&dbngetstart, NULL);
 	//Init the data to return
 	*data = NULL;
 	*data_len = 0;
@@ -633,13 +617,9 @@ int mdhim_leveldb_get_next(void *dbh, void **key, int *key_len,
 	gettimeofday(&end, NULL);
 	mlog(MDHIM_SERVER_DBG, "Took: %d seconds to get the next record", 
 	     (int) (end.tv_sec - start.tv_sec));
-	gettimeofday(&dbngetend, NULL);
-	dbngettime += 1000000*(dbngetend.tv_sec-dbngetstart.tv_sec)+dbngetend.tv_usec-dbngetstart.tv_usec;
 	return ret;
 
 error:	
-	gettimeofday(&dbngetend, NULL);
-	dbngettime += 1000000*(dbngetend.tv_sec-dbngetstart.tv_sec)+dbngetend.tv_usec-dbngetstart.tv_usec; 
 	 //Destroy iterator
 	leveldb_iter_destroy(iter);      
 	*key = NULL;
@@ -845,7 +825,6 @@ int mdhim_leveldb_batch_next(void *dbh, char **key, int *key_len,
                              char **data, int32_t *data_len,
                              int tot_records, int *num_records) {
 
-	gettimeofday(&dbngetstart, NULL);
 	struct mdhim_leveldb_t *mdhim_db = (struct mdhim_leveldb_t *) dbh;
 	int cursor = 0;
 	leveldb_readoptions_t *options;
@@ -898,19 +877,12 @@ int mdhim_leveldb_batch_next(void *dbh, char **key, int *key_len,
 			cursor++;
 		}
 	}
-	gettimeofday(&dbngetend, NULL);
-	dbngettime +=\
-			1000000 * (dbngetend.tv_sec - dbngetstart.tv_sec)\
-			+ dbngetend.tv_usec - dbngetstart.tv_usec;
 	leveldb_iter_destroy(iter);
 	if (*num_records < tot_records)
 		return MDHIM_DB_ERROR;
 	else
 		return 0;
 error:
-	gettimeofday(&dbngetend, NULL);
-	dbngettime += 1000000 * (dbngetend.tv_sec - dbngetstart.tv_sec)\
-			+ dbngetend.tv_usec - dbngetstart.tv_usec;
 		 //Destroy iterator
 	leveldb_iter_destroy(iter);
 	return MDHIM_DB_ERROR;
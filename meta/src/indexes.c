@@ -49,17 +49,6 @@
 #include "mdhim.h"
 #include "indexes.h"
 
-struct timeval hashopstart, hashopend;
-double hashoptime=0;
-
-struct timeval cmpstart, cmpend;
-double cmptime=0;
-
-struct timeval metastart, metaend;
-double metatime=0;
-
-struct timeval sleepstart, sleepend;
-double sleeptime=0;
 /**
  * to_lower
  * convert strings to all lower case
@@ -220,216 +209,201 @@ int read_manifest(struct mdhim_t *md, struct index_t *index) {
 }
 
 /**
- * update_stat
- * Adds or updates the given stat to the hash table
+ * get_stat_bounds
+ * Allocates the min and max values that a key contributes to the stat of its slice
  *
- * @param md       pointer to the main MDHIM structure
+ * @param index    the index the key belongs to
  * @param key      pointer to the key we are examining
  * @param key_len  the key's length
- * @return MDHIM_SUCCESS or MDHIM_ERROR on error
+ * @param val1     out  the key's min value
+ * @param val2     out  the key's max value
  */
-int update_stat(struct mdhim_t *md, struct index_t *index, void *key, uint32_t key_len) {
-	int slice_num;
-	void *val1, *val2;
-	int float_type = 0;
-	struct mdhim_stat *os, *stat;
-
-	//Acquire the lock to update the stats
-	gettimeofday(&sleepstart, NULL);
-	while (pthread_rwlock_wrlock(index->mdhim_store->mdhim_store_stats_lock) == EBUSY) {
-		usleep(10);
+static void get_stat_bounds(struct index_t *index, void *key, uint32_t key_len,
+			    void **val1, void **val2) {
+	if (is_float_key(index->key_type) == 1) {
+		*val1 = (void *) malloc(sizeof(long));
+		*val2 = (void *) malloc(sizeof(long));
+	} else if (index->key_type != MDHIM_UNIFYFS_KEY) {
+		*val1 = (void *) malloc(sizeof(uint64_t));
+		*val2 = (void *) malloc(sizeof(uint64_t));
+	} else {
+		*val1 = NULL;
+		*val2 = NULL;
 	}
-	gettimeofday(&sleepend, NULL);
-	sleeptime += 1000000*(sleepend.tv_sec-sleepstart.tv_sec)+sleepend.tv_usec-sleepstart.tv_usec;
-
-			gettimeofday(&metastart, NULL);
-	if ((float_type = is_float_key(index->key_type)) == 1) {
-		val1 = (void *) malloc(sizeof(long));
-		val2 = (void *) malloc(sizeof(long));
-		/* printf("is float key\n");
-		   fflush(stdout);
-		*/
-	} else if (index->key_type != MDHIM_UNIFYFS_KEY){
-		val1 = (void *) malloc(sizeof(uint64_t));
-		val2 = (void *) malloc(sizeof(uint64_t));
-		/* printf("is not unifyfs key\n");
-		   fflush(stdout);
-		   */
-	}
-	else {
-		val1 = NULL;
-		val2 = NULL;
-		/*
-		printf("is unifyfs key\n");
-		fflush(stdout);
-		*/
-	}
-	/*
-	printf("key_type is %d\n", index->key_type);
-	fflush(stdout);
-	*/
+
 	if (index->key_type == MDHIM_STRING_KEY) {
-		*(long double *)val1 = get_str_num(key, key_len);
-		*(long double *)val2 = *(long double *)val1;
+		*(long double *)*val1 = get_str_num(key, key_len);
+		*(long double *)*val2 = *(long double *)*val1;
 	} else if (index->key_type == MDHIM_FLOAT_KEY) {
-		*(long double *)val1 = *(float *) key;
-		*(long double *)val2 = *(float *) key;
+		*(long double *)*val1 = *(float *) key;
+		*(long double *)*val2 = *(float *) key;
 	} else if (index->key_type == MDHIM_DOUBLE_KEY) {
-		*(long double *)val1 = *(double *) key;
-		*(long double *)val2 = *(double *) key;
+		*(long double *)*val1 = *(double *) key;
+		*(long double *)*val2 = *(double *) key;
 	} else if (index->key_type == MDHIM_INT_KEY) {
-		*(uint64_t *)val1 = *(uint32_t *) key;
-		*(uint64_t *)val2 = *(uint32_t *) key;
+		*(uint64_t *)*val1 = *(uint32_t *) key;
+		*(uint64_t *)*val2 = *(uint32_t *) key;
 	} else if (index->key_type == MDHIM_LONG_INT_KEY) {
-		*(uint64_t *)val1 = *(uint64_t *) key;
-		*(uint64_t *)val2 = *(uint64_t *) key;
+		*(uint64_t *)*val1 = *(uint64_t *) key;
+		*(uint64_t *)*val2 = *(uint64_t *) key;
 	} else if (index->key_type == MDHIM_BYTE_KEY) {
-		*(unsigned long  *)val1 = get_byte_num(key, key_len);
-		*(unsigned long  *)val2 = *(unsigned long *)val1;
+		*(unsigned long  *)*val1 = get_byte_num(key, key_len);
+		*(unsigned long  *)*val2 = *(unsigned long *)*val1;
 	} else if (index->key_type == MDHIM_UNIFYFS_KEY) {
-			val1 = get_meta_pair(key, key_len);
-			val2 = get_meta_pair(key, key_len);
+		*val1 = get_meta_pair(key, key_len);
+		*val2 = get_meta_pair(key, key_len);
 	}
-			gettimeofday(&metaend, NULL);
-			metatime+=1000000*(metaend.tv_sec-metastart.tv_sec)+metaend.tv_usec-metastart.tv_usec;
+}
 
-	slice_num = get_slice_num(md, index, key, key_len);
-	gettimeofday(&hashopstart, NULL);
-	HASH_FIND_INT(index->mdhim_store->mdhim_store_stats, &slice_num, os);
-	gettimeofday(&hashopend, NULL);
+/**
+ * stat_less
+ * Compares two stat values of an index
+ *
+ * @param index  the index the values belong to
+ * @param a      first value
+ * @param b      second value
+ * @return nonzero if a is less than b
+ */
+static int stat_less(struct index_t *index, void *a, void *b) {
+	if (index->key_type == MDHIM_UNIFYFS_KEY) {
+		return unifyfs_compare((const char *) a, (const char *) b) < 0;
+	} else if (is_float_key(index->key_type) == 1) {
+		return *(unsigned long *)a < *(unsigned long *)b;
+	}
 
+	return *(uint64_t *)a < *(uint64_t *)b;
+}
+
+/**
+ * merge_stat
+ * Adds num keys between min and max to the stat of a slice.  Takes ownership of 
+ * min and max.  The caller must hold the index's stats lock.
+ *
+ * @param index      the index the keys belong to
+ * @param slice_num  the slice the keys belong to
+ * @param min        the least of the keys' min values
+ * @param max        the greatest of the keys' max values
+ * @param num        the number of keys
+ */
+static void merge_stat(struct index_t *index, int slice_num, void *min, void *max, 
+		       uint64_t num) {
+	struct mdhim_stat *os, *stat;
+
+	HASH_FIND_INT(index->mdhim_store->mdhim_store_stats, &slice_num, os);
 
-	// printf("val1 is %ld, val2 is %ld\n", *((long *)val1+1), *((long *)val2+1));
 	stat = malloc(sizeof(struct mdhim_stat));
-	stat->min = val1;
-	stat->max = val2;
-	stat->num = 1;
+	stat->min = min;
+	stat->max = max;
+	stat->num = num;
 	stat->key = slice_num;
 	stat->dirty = 1;
-	hashoptime += 1000000*(hashopend.tv_sec-hashopstart.tv_sec)+hashopend.tv_usec-hashopstart.tv_usec;
-//	printf("here min stat is %ld, max stat is %ld\n", *((long *)stat->min), *((long *)stat->max));
-//	fflush(stdout);
-
-	gettimeofday(&cmpstart, NULL);
-	if (index->key_type == MDHIM_UNIFYFS_KEY && os ) {
-		if (unifyfs_compare(os->min, val1) > 0) {
-			/*
-			printf("freeing %x, va1 addr is %x\n", os->min, val1);
-			fflush(stdout);
-			*/
-			free(os->min);
-			stat->min = val1;
-		} else {
-			stat->min = os->min;
-			free(val1);
-		}
 
-		if (unifyfs_compare(os->max, val2) < 0) {
-			/*
-			printf("freeing %xb,bbb\n", os->max);
-			fflush(stdout);
-			*/
-			free(os->max);
-			stat->max = val2;
-		} else {
-			stat->max = os->max;
-			free(val2);
-		}
+	if (!os) {
+		HASH_ADD_INT(index->mdhim_store->mdhim_store_stats, key, stat);    
+		return;
 	}
-	gettimeofday(&cmpend, NULL);
-	cmptime+=1000000*(cmpend.tv_sec-cmpstart.tv_sec)+cmpend.tv_usec-cmpstart.tv_usec;
 
-	if (float_type && os) {
-//		printf("comparing min is %ld, val1 is %ld\n", *((long *)stat->min), *((long *)val1));
-//		fflush(stdout);
-		if (*(unsigned long *)os->min > *(unsigned long *)val1) {
-			/*
-			printf("freeing %x 1\n", os->min);
-			fflush(stdout);
-			*/
-			free(os->min);
-			stat->min = val1;
-		} else {
-			/*
-			printf("freeing %x 1\n", val1);
-			fflush(stdout);
-			*/
-			free(val1);
-			stat->min = os->min;
-		}
+	if (stat_less(index, min, os->min)) {
+		free(os->min);
+	} else {
+		stat->min = os->min;
+		free(min);
+	}
+
+	if (stat_less(index, os->max, max)) {
+		free(os->max);
+	} else {
+		stat->max = os->max;
+		free(max);
+	}
+
+	stat->num = os->num + num;
+
+	//Replace the existing stat
+	HASH_REPLACE_INT(index->mdhim_store->mdhim_store_stats, key, stat, os);  
+	free(os);
+}
+
+/**
+ * update_stat
+ * Adds or updates the given stat to the hash table
+ *
+ * @param md       pointer to the main MDHIM structure
+ * @param key      pointer to the key we are examining
+ * @param key_len  the key's length
+ * @return MDHIM_SUCCESS or MDHIM_ERROR on error
+ */
+int update_stat(struct mdhim_t *md, struct index_t *index, void *key, uint32_t key_len) {
+	int len = key_len;
+
+	return update_stats(md, index, &key, &len, 1);
+}
+
+/**
+ * update_stats
+ * Adds or updates the stats of a batch of keys in the hash table.  The keys are 
+ * first combined per slice, so the stats lock is taken once for the whole batch.
+ *
+ * @param md        pointer to the main MDHIM structure
+ * @param index     the index the keys belong to
+ * @param keys      array of pointers to the keys
+ * @param key_lens  array of the keys' lengths
+ * @param num_keys  number of keys
+ * @return MDHIM_SUCCESS or MDHIM_ERROR on error
+ */
+int update_stats(struct mdhim_t *md, struct index_t *index, void **keys, 
+		 int *key_lens, int num_keys) {
+	struct mdhim_stat *batch = NULL;
+	struct mdhim_stat *stat, *tmp;
+	void *val1, *val2;
+	int slice_num;
+	int i;
 
-		if (*(unsigned long *)os->max < *(unsigned long *)val2) {
-			/*
-			printf("freeing %x2\n", os->max);
-			fflush(stdout);
-			*/
-			free(os->max);
+	//Combine the keys of each slice without holding the stats lock
+	for (i = 0; i < num_keys; i++) {
+		get_stat_bounds(index, keys[i], key_lens[i], &val1, &val2);
+		slice_num = get_slice_num(md, index, keys[i], key_lens[i]);
+
+		HASH_FIND_INT(batch, &slice_num, stat);
+		if (!stat) {
+			stat = malloc(sizeof(struct mdhim_stat));
+			stat->key = slice_num;
+			stat->min = val1;
 			stat->max = val2;
-		} else {
-			/*
-			printf("freeing %x2\n", val2);
-			fflush(stdout);
-			*/
-			free(val2);
-			stat->max = os->max;
+			stat->num = 1;
+			HASH_ADD_INT(batch, key, stat);
+			continue;
 		}
-	}	
 
-	if (!float_type && os && index->key_type != MDHIM_UNIFYFS_KEY) {
-		if (*(uint64_t *)os->min > *(uint64_t *)val1) {
-			/*
-			printf("freeing %x3\n", os->min);
-			fflush(stdout);
-			*/
-			free(os->min);
+		if (stat_less(index, val1, stat->min)) {
+			free(stat->min);
 			stat->min = val1;
 		} else {
-			/*
-			printf("freeing %x3\n", val1);
-			fflush(stdout);
-			*/
 			free(val1);
-			stat->min = os->min;
 		}
 
-		if (*(uint64_t *)os->max < *(uint64_t *)val2) {
-			/*
-			printf("freeing %x4\n", os->max);
-			fflush(stdout);
-			*/
-			free(os->max);
+		if (stat_less(index, stat->max, val2)) {
+			free(stat->max);
 			stat->max = val2;
 		} else {
-			/*
-			printf("freeing %x4\n", val2);
-			fflush(stdout);
-			*/
 			free(val2);
-			stat->max = os->max;
-		}		
+		}
+
+		stat->num++;
 	}
 
-	if (!os) {
-		gettimeofday(&hashopstart, NULL);
-		HASH_ADD_INT(index->mdhim_store->mdhim_store_stats, key, stat);    
-		gettimeofday(&hashopend, NULL);
-		hashoptime += 1000000*(hashopend.tv_sec-hashopstart.tv_sec)+hashopend.tv_usec-hashopstart.tv_usec;
-	} else {	
-		stat->num = os->num + 1;
+	//Acquire the lock to update the stats
+	pthread_rwlock_wrlock(index->mdhim_store->mdhim_store_stats_lock);
 
-		//Replace the existing stat
-		gettimeofday(&hashopstart, NULL);
-		HASH_REPLACE_INT(index->mdhim_store->mdhim_store_stats, key, stat, os);  
-		free(os);
-		gettimeofday(&hashopend, NULL);
-		hashoptime += 1000000*(hashopend.tv_sec-hashopstart.tv_sec)+hashopend.tv_usec-hashopstart.tv_usec;
+	HASH_ITER(hh, batch, stat, tmp) {
+		HASH_DEL(batch, stat);
+		merge_stat(index, stat->key, stat->min, stat->max, stat->num);
+		free(stat);
 	}
 
 	//Release the stats lock
-	gettimeofday(&sleepstart, NULL);
 	pthread_rwlock_unlock(index->mdhim_store->mdhim_store_stats_lock);
-	gettimeofday(&sleepend, NULL);
-	sleeptime +=1000000*(sleepend.tv_sec-sleepstart.tv_sec)+sleepend.tv_usec-sleepstart.tv_usec;
+
 	return MDHIM_SUCCESS;
 }
 
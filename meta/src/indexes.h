@@ -128,6 +128,8 @@ typedef struct index_manifest_t {
 } index_manifest_t;
 
 int update_stat(struct mdhim_t *md, struct index_t *bi, void *key, uint32_t key_len);
+int update_stats(struct mdhim_t *md, struct index_t *bi, void **keys, int *key_lens, 
+		 int num_keys);
 int load_stats(struct mdhim_t *md, struct index_t *bi);
 int write_stats(struct mdhim_t *md, struct index_t *bi);
 int open_db_store(struct mdhim_t *md, struct index_t *index);
@@ -136,26 +136,50 @@ struct mdhim_rm_t *local_client_bput(struct mdhim_t *md, struct mdhim_bputm_t *b
  * @return return_message structure with ->error = MDHIM_SUCCESS or MDHIM_ERROR
  */
 struct mdhim_bgetrm_t *local_client_bget(struct mdhim_t *md, struct mdhim_bgetm_t *bgm) {
+	if (local_client_bget_post(md, bgm) != MDHIM_SUCCESS) {
+		return NULL;
+	}
+
+	// Return response
+	return local_client_bget_wait(md);
+}
+
+/**
+ * Insert bulk get into the range server's work queue without waiting for the response,
+ * the response must be collected with local_client_bget_wait
+ *
+ * @param md main MDHIM struct
+ * @param bgm pointer to get message to be inserted into the range server's work queue
+ * @return MDHIM_SUCCESS or MDHIM_ERROR on error
+ */
+int local_client_bget_post(struct mdhim_t *md, struct mdhim_bgetm_t *bgm) {
 	int ret;
-	struct mdhim_bgetrm_t *rm;
 	work_item *item;
 
 	if ((item = malloc(sizeof(work_item))) == NULL) {
 		mlog(MDHIM_CLIENT_CRIT, "Error while allocating memory for client");
-		return NULL;
+		return MDHIM_ERROR;
 	}
 
 	item->message = (void *)bgm;
 	item->source = md->mdhim_rank;
 	if ((ret = range_server_add_work(md, item)) != MDHIM_SUCCESS) {
-		mlog(MDHIM_CLIENT_CRIT, "Error adding work to range server in local_client_put");
-		return NULL;
+		mlog(MDHIM_CLIENT_CRIT, "Error adding work to range server in local_client_bget_post");
+		free(item);
+		return MDHIM_ERROR;
 	}
-	
-	rm = (struct mdhim_bgetrm_t *) get_msg_self(md);
 
-	// Return response
-	return rm;
+	return MDHIM_SUCCESS;
+}
+
+/**
+ * Wait for the response to a bulk get posted with local_client_bget_post
+ *
+ * @param md main MDHIM struct
+ * @return return_message structure with ->error = MDHIM_SUCCESS or MDHIM_ERROR
+ */
+struct mdhim_bgetrm_t *local_client_bget_wait(struct mdhim_t *md) {
+	return (struct mdhim_bgetrm_t *) get_msg_self(md);
 }
 
 /**
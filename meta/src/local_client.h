@@ -42,6 +42,8 @@
 struct mdhim_rm_t *local_client_put(struct mdhim_t *md, struct mdhim_putm_t *pm);
 struct mdhim_rm_t *local_client_bput(struct mdhim_t *md, struct mdhim_bputm_t *bpm);
 struct mdhim_bgetrm_t *local_client_bget(struct mdhim_t *md, struct mdhim_bgetm_t *bgm);
+int local_client_bget_post(struct mdhim_t *md, struct mdhim_bgetm_t *bgm);
+struct mdhim_bgetrm_t *local_client_bget_wait(struct mdhim_t *md);
 struct mdhim_bgetrm_t *local_client_bget_op(struct mdhim_t *md, struct mdhim_getm_t *gm);
 struct mdhim_rm_t *local_client_commit(struct mdhim_t *md, struct mdhim_basem_t *cm);
 struct mdhim_rm_t *local_client_delete(struct mdhim_t *md, struct mdhim_delm_t *dm);
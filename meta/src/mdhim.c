@@ -156,6 +156,14 @@ struct mdhim_t *mdhimInit(void *appComm, struct mdhim_options_t *opts) {
 		return NULL;
 	}
 
+	//Check whether MPI lets threads block in MPI calls concurrently
+	if ((ret = MPI_Query_thread(&provided)) != MPI_SUCCESS) {
+		mlog(MDHIM_CLIENT_CRIT, "MDHIM Rank: %d - "
+		     "Error while querying the MPI thread level", md->mdhim_rank);
+		return NULL;
+	}
+	md->comm_thread_multiple = (provided == MPI_THREAD_MULTIPLE);
+
 	//Dup the communicator passed in for barriers between clients
 	if ((ret = MPI_Comm_dup(comm, &md->mdhim_client_comm)) != MPI_SUCCESS) {
 		mlog(MDHIM_CLIENT_CRIT, "Error while initializing the MDHIM communicator");
@@ -72,6 +72,8 @@ struct mdhim_t {
         //It is used for sending and receiving to and from the range servers
 	MPI_Comm mdhim_comm;   
 	pthread_mutex_t *mdhim_comm_lock;
+	//Set if MPI provides MPI_THREAD_MULTIPLE, so waits may block without mdhim_comm_lock
+	int comm_thread_multiple;
 
 	//This communicator will include every process in the application, but is separate from the app
         //It is used for barriers for clients
@@ -265,6 +265,9 @@ struct mdhim_brm_t *_bput_records(struct mdhim_t *md, struct index_t *index,
 				bpm->values = malloc(sizeof(void *) * MAX_BULK_OPS);
 				bpm->value_lens = malloc(sizeof(int) * MAX_BULK_OPS);
 				bpm->num_keys = 0;
+				bpm->key_size = 0;
+				bpm->value_size = 0;
+				bpm->records = NULL;
 				bpm->basem.server_rank = rl->ri->rank;
 				bpm->basem.mtype = MDHIM_BULK_PUT;
 				bpm->basem.index = put_index->id;
@@ -422,11 +425,18 @@ struct mdhim_bgetrm_t *_bget_records(struct mdhim_t *md, struct index_t *index,
 
 	//Make a list out of the received messages to return
 	gettimeofday(&localgetstart, NULL);
+	//Queue the local message first, so the local range server works on it
+	//while the messages to the remote range servers are exchanged
+	if (lbgm && local_client_bget_post(md, lbgm) != MDHIM_SUCCESS) {
+		lbgm = NULL;
+	}
 	bgrm_head = client_bget(md, index, bgm_list);
 	if (lbgm) {
-		lbgrm = local_client_bget(md, lbgm);
-		lbgrm->next = bgrm_head;
-		bgrm_head = lbgrm;
+		lbgrm = local_client_bget_wait(md);
+		if (lbgrm) {
+			lbgrm->next = bgrm_head;
+			bgrm_head = lbgrm;
+		}
 	}
 	gettimeofday(&localgetend, NULL);
 	localgettime += 1000000*(localgetend.tv_sec-localgetstart.tv_sec)+\
@@ -535,11 +545,16 @@ struct mdhim_bgetrm_t *_bget_range_records(struct mdhim_t *md, struct index_t *i
 
 
 	//Make a list out of the received messages to return
+	if (lbgm && local_client_bget_post(md, lbgm) != MDHIM_SUCCESS) {
+		lbgm = NULL;
+	}
 	bgrm_head = client_bget(md, index, bgm_list);
 	if (lbgm) {
-		lbgrm = local_client_bget(md, lbgm);
-		lbgrm->next = bgrm_head;
-		bgrm_head = lbgrm;
+		lbgrm = local_client_bget_wait(md);
+		if (lbgrm) {
+			lbgrm->next = bgrm_head;
+			bgrm_head = lbgrm;
+		}
 	}
 	for (i = 0; i < index->num_rangesrvs; i++) {
 		if (!bgm_list[i]) {
@@ -41,6 +41,7 @@
 #include "partitioner.h"
 #include "messages.h"
 #include <stdio.h>
+#include <time.h>
 #include <sys/time.h>
 
 struct timeval recv_comm_start, recv_comm_end;
@@ -57,23 +58,207 @@ double packretgettime = 0;
 struct timeval packretputstart, packretputend;
 double packretputtime = 0;
 
-void test_req_and_wait(struct mdhim_t *md, MPI_Request *req) {
-	int flag;
+/**
+ * cancel_reqs
+ * Cancels the requests in pending that have not completed and frees them
+ */
+static void cancel_reqs(struct mdhim_t *md, MPI_Request **reqs, 
+			MPI_Request *pending, int count) {
+	int i;
+
+	pthread_mutex_lock(md->mdhim_comm_lock);
+	for (i = 0; i < count; i++) {
+		if (!reqs[i]) {
+			continue;
+		}
+
+		if (pending[i] != MPI_REQUEST_NULL) {
+			MPI_Cancel(&pending[i]);
+			MPI_Wait(&pending[i], MPI_STATUS_IGNORE);
+		}
+		free(reqs[i]);
+		reqs[i] = NULL;
+	}
+	pthread_mutex_unlock(md->mdhim_comm_lock);
+}
+
+/**
+ * wait_reqs
+ * Waits for the requests in reqs to complete.  Each completed request is freed 
+ * and its entry set to NULL.  If MPI provides MPI_THREAD_MULTIPLE, the caller 
+ * blocks in MPI_Waitany without holding mdhim_comm_lock, so a message is seen 
+ * as soon as MPI completes it.  Otherwise the requests are tested under the lock, 
+ * first back-to-back and then with a sleep that doubles from MDHIM_WAIT_MIN_NS 
+ * up to MDHIM_WAIT_MAX_NS.  If the wait fails or is canceled, the remaining 
+ * requests are canceled and freed.
+ *
+ * @param md       main MDHIM struct
+ * @param reqs     array of pointers to requests, NULL entries are skipped
+ * @param count    number of entries in reqs
+ * @param statuses array of count statuses to fill in, or NULL
+ * @param cancel   stop waiting once this becomes nonzero, or NULL
+ * @return MDHIM_SUCCESS or MDHIM_ERROR on error or cancel
+ */
+int wait_reqs(struct mdhim_t *md, MPI_Request **reqs, int count,
+	      MPI_Status *statuses, volatile int *cancel) {
+	MPI_Request *pending;
+	MPI_Status *stats;
 	MPI_Status status;
-	int done = 0;
+	int *indices;
+	int i, j, idx, num_done, outstanding;
+	int spins = 0;
+	long sleep_ns = MDHIM_WAIT_MIN_NS;
+	struct timespec ts;
+	int return_code;
+	int ret = MDHIM_SUCCESS;
+
+	if (count <= 0) {
+		return MDHIM_SUCCESS;
+	}
+
+	pending = malloc(sizeof(MPI_Request) * count);
+	stats = malloc(sizeof(MPI_Status) * count);
+	indices = malloc(sizeof(int) * count);
+	outstanding = 0;
+	for (i = 0; i < count; i++) {
+		if (reqs[i]) {
+			pending[i] = *reqs[i];
+			outstanding++;
+		} else {
+			pending[i] = MPI_REQUEST_NULL;
+		}
+	}
+
+	while (outstanding > 0) {
+		if (cancel && *cancel) {
+			ret = MDHIM_ERROR;
+			break;
+		}
+
+		if (md->comm_thread_multiple) {
+			//Block until any request completes
+			return_code = MPI_Waitany(count, pending, &idx, &status);
+			if (return_code != MPI_SUCCESS || idx == MPI_UNDEFINED) {
+				ret = MDHIM_ERROR;
+				break;
+			}
+
+			if (statuses) {
+				statuses[idx] = status;
+			}
+			free(reqs[idx]);
+			reqs[idx] = NULL;
+			outstanding--;
+			continue;
+		}
 
-	while (!done) {
 		pthread_mutex_lock(md->mdhim_comm_lock);
-		(void) MPI_Test(req, &flag, &status);
-		//Unlock the mdhim_comm_lock
+		return_code = MPI_Testsome(count, pending, &num_done, indices, stats);
 		pthread_mutex_unlock(md->mdhim_comm_lock);
 
-		if (flag) {
-			done = 1;
+		if ((return_code != MPI_SUCCESS && return_code != MPI_ERR_IN_STATUS) ||
+		    num_done == MPI_UNDEFINED) {
+			ret = MDHIM_ERROR;
+			break;
+		}
+
+		if (return_code == MPI_ERR_IN_STATUS) {
+			ret = MDHIM_ERROR;
+		}
+
+		for (j = 0; j < num_done; j++) {
+			idx = indices[j];
+			if (statuses) {
+				statuses[idx] = stats[j];
+			}
+			free(reqs[idx]);
+			reqs[idx] = NULL;
+			outstanding--;
+		}
+
+		if (num_done > 0) {
+			spins = 0;
+			sleep_ns = MDHIM_WAIT_MIN_NS;
+		} else if (spins < MDHIM_WAIT_SPINS) {
+			spins++;
 		} else {
-			usleep(100);
+			ts.tv_sec = 0;
+			ts.tv_nsec = sleep_ns;
+			nanosleep(&ts, NULL);
+			if (sleep_ns < MDHIM_WAIT_MAX_NS) {
+				sleep_ns *= 2;
+			}
 		}
 	}
+
+	if (outstanding > 0) {
+		cancel_reqs(md, reqs, pending, count);
+	}
+
+	free(pending);
+	free(stats);
+	free(indices);
+
+	return ret;
+}
+
+void test_req_and_wait(struct mdhim_t *md, MPI_Request *req) {
+	MPI_Request *tmp;
+
+	//Wait on a copy so the caller keeps ownership of req
+	tmp = malloc(sizeof(MPI_Request));
+	*tmp = *req;
+	wait_reqs(md, &tmp, 1, NULL, NULL);
+	*req = MPI_REQUEST_NULL;
+}
+
+/**
+ * post_rangesrv_wakeup
+ * Sends an empty work size message to this rank, so a listener blocked in
+ * receive_rangesrv_work returns and notices md->shutdown
+ *
+ * @param md  main MDHIM struct
+ * @param req request to post the send on
+ * @return MDHIM_SUCCESS or MDHIM_ERROR on error
+ */
+int post_rangesrv_wakeup(struct mdhim_t *md, MPI_Request *req) {
+	static int wakeup_size = 0;
+	int return_code;
+
+	pthread_mutex_lock(md->mdhim_comm_lock);
+	return_code = MPI_Isend(&wakeup_size, 1, MPI_INT, md->mdhim_rank, 
+				RANGESRV_WORK_SIZE_MSG, md->mdhim_comm, req);
+	pthread_mutex_unlock(md->mdhim_comm_lock);
+	if (return_code != MPI_SUCCESS) {
+		*req = MPI_REQUEST_NULL;
+		return MDHIM_ERROR;
+	}
+
+	return MDHIM_SUCCESS;
+}
+
+/**
+ * finish_rangesrv_wakeup
+ * Completes the send from post_rangesrv_wakeup, canceling it if the 
+ * listener exited without receiving it
+ *
+ * @param md  main MDHIM struct
+ * @param req request passed to post_rangesrv_wakeup
+ */
+void finish_rangesrv_wakeup(struct mdhim_t *md, MPI_Request *req) {
+	int flag = 0;
+
+	if (*req == MPI_REQUEST_NULL) {
+		return;
+	}
+
+	pthread_mutex_lock(md->mdhim_comm_lock);
+	MPI_Test(req, &flag, MPI_STATUS_IGNORE);
+	if (!flag) {
+		MPI_Cancel(req);
+		MPI_Wait(req, MPI_STATUS_IGNORE);
+	}
+	pthread_mutex_unlock(md->mdhim_comm_lock);
 }
 
 /**
@@ -186,9 +371,8 @@ int send_all_rangesrv_work(struct mdhim_t *md, void **messages, int num_srvs) {
 	MPI_Request **reqs, **size_reqs;
 	MPI_Request *req;
 	int num_msgs;
-	int i, ret, flag, done;
+	int i, ret;
 	void *mesg;
-	MPI_Status status;
 	int dest;
 
 	ret = MDHIM_SUCCESS;
@@ -201,7 +385,6 @@ int send_all_rangesrv_work(struct mdhim_t *md, void **messages, int num_srvs) {
 	memset(sendbufs, 0, sizeof(void *) * num_srvs);
 	sizes = malloc(sizeof(int) * num_srvs);
 	memset(sizes, 0, sizeof(int) * num_srvs);
-	done = 0;
 
 	//Send all messages at once
 	for (i = 0; i < num_srvs; i++) {
@@ -281,45 +464,12 @@ int send_all_rangesrv_work(struct mdhim_t *md, void **messages, int num_srvs) {
 	}
 	
 	//Wait for messages to complete
-	while (done != num_msgs * 2) {
-		for (i = 0; i < num_msgs; i++) {
-			req = size_reqs[i];
-			if (!req) {
-				continue;
-			}
-			
-			//Lock the mdhim_comm_lock
-			pthread_mutex_lock(md->mdhim_comm_lock);
-			ret = MPI_Test(req, &flag, &status);
-			//Unlock the mdhim_comm_lock
-			pthread_mutex_unlock(md->mdhim_comm_lock);
-
-			if (flag) {
-				free(req);
-				size_reqs[i] = NULL;
-				done++;
-			}		
-		}
-		for (i = 0; i < num_msgs; i++) {
-			req = reqs[i];
-			if (!req) {
-				continue;
-			}
-			
-			pthread_mutex_lock(md->mdhim_comm_lock);
-			ret = MPI_Test(req, &flag, &status);
-			pthread_mutex_unlock(md->mdhim_comm_lock);
-
-			if (flag) {
-				free(req);
-				reqs[i] = NULL;
-				done++;
-			}		
-		}
-		
-		if (done != num_msgs * 2) {
-			usleep(100);
-		}
+	if (wait_reqs(md, size_reqs, num_msgs, NULL, NULL) != MDHIM_SUCCESS ||
+	    wait_reqs(md, reqs, num_msgs, NULL, NULL) != MDHIM_SUCCESS) {
+		mlog(MPI_CRIT, "Rank: %d - " 
+		     "Error waiting for work messages in send_all_rangesrv_work", 
+		     md->mdhim_rank);
+		ret = MDHIM_ERROR;
 	}
 
 	for (i = 0; i < num_msgs; i++) {
@@ -357,11 +507,9 @@ int receive_rangesrv_work(struct mdhim_t *md, int *src, void **message) {
 	struct mdhim_basem_t *bm;
 	int mesg_idx = 0;
 	MPI_Request *req;
-	int flag = 0;
 	int ret = MDHIM_SUCCESS;
 
 	// Receive a message from any client
-	flag = 0;
 
 	req = malloc(sizeof(MPI_Request));
 	pthread_mutex_lock(md->mdhim_comm_lock);
@@ -381,28 +529,27 @@ int receive_rangesrv_work(struct mdhim_t *md, int *src, void **message) {
 	}
 
 	gettimeofday(&recv_comm_start, NULL);	
-	while (!flag) {
-		if (md->shutdown) {
-			free(req);
-			return MDHIM_ERROR;
-		}
-		
-		pthread_mutex_lock(md->mdhim_comm_lock);
-		return_code = MPI_Test(req, &flag, &status);
-		pthread_mutex_unlock(md->mdhim_comm_lock);
-		usleep(100);
-	}
+	return_code = wait_reqs(md, &req, 1, &status, &md->shutdown);
 	gettimeofday(&recv_comm_end, NULL);
 	recv_comm_time += 1000000*(recv_comm_end.tv_sec-recv_comm_start.tv_sec)+recv_comm_end.tv_usec-recv_comm_start.tv_usec;
 		
-	if (return_code == MPI_ERR_IN_STATUS) {
-		mlog(MDHIM_SERVER_CRIT, "MDHIM Rank: %d - Received an error status: %d "
-                     " while receiving work message size", md->mdhim_rank, status.MPI_ERROR);		
+	if (return_code != MDHIM_SUCCESS) {
+		if (!md->shutdown) {
+			mlog(MDHIM_SERVER_CRIT, "MDHIM Rank: %d - Received an error status: %d "
+			     " while receiving work message size", md->mdhim_rank, status.MPI_ERROR);
+		}
+		return MDHIM_ERROR;
 	}
+
+	//An empty size message from range_server_stop wakes us for shutdown
+	if (md->shutdown || recvsize <= 0) {
+		return MDHIM_ERROR;
+	}
+
 	recvbuf = (void *) malloc(recvsize);	
 	memset(recvbuf, 0, recvsize);
-	flag = 0;
 
+	req = malloc(sizeof(MPI_Request));
 	pthread_mutex_lock(md->mdhim_comm_lock);
 	gettimeofday(&recv_comm_start, NULL);	
 	return_code = MPI_Irecv(recvbuf, recvsize, MPI_PACKED, status.MPI_SOURCE, 
@@ -419,24 +566,17 @@ int receive_rangesrv_work(struct mdhim_t *md, int *src, void **message) {
 		return MDHIM_ERROR;
 	}
 	gettimeofday(&recv_comm_start, NULL);
-	while (!flag) {
-		if (md->shutdown) {
-			return MDHIM_ERROR;
-		}
-
-		pthread_mutex_lock(md->mdhim_comm_lock);
-		return_code = MPI_Test(req, &flag, &status);
-		pthread_mutex_unlock(md->mdhim_comm_lock);
-
-		usleep(100);
-	}
+	return_code = wait_reqs(md, &req, 1, &status, &md->shutdown);
 	gettimeofday(&recv_comm_end, NULL);
 	recv_comm_time += 1000000*(recv_comm_end.tv_sec-recv_comm_start.tv_sec)+recv_comm_end.tv_usec-recv_comm_start.tv_usec;	
 
-	free(req);
-	if (return_code == MPI_ERR_IN_STATUS) {
-		mlog(MDHIM_SERVER_CRIT, "MDHIM Rank: %d - Received an error status: %d "
-                     " while receiving work message size", md->mdhim_rank, status.MPI_ERROR);
+	if (return_code != MDHIM_SUCCESS) {
+		if (!md->shutdown) {
+			mlog(MDHIM_SERVER_CRIT, "MDHIM Rank: %d - Received an error status: %d "
+			     " while receiving work message", md->mdhim_rank, status.MPI_ERROR);
+		}
+		free(recvbuf);
+		return MDHIM_ERROR;
 	}
 	if (!recvbuf) {
 		return MDHIM_ERROR;
@@ -682,7 +822,6 @@ int receive_client_response(struct mdhim_t *md, int src, void **message) {
  */
 int receive_all_client_responses(struct mdhim_t *md, int *srcs, int nsrcs, 
 				 void ***messages) {
-	MPI_Status status;
 	int return_code;
 	int mtype;
 	int mesg_idx = 0;
@@ -692,8 +831,6 @@ int receive_all_client_responses(struct mdhim_t *md, int *srcs, int nsrcs,
 	int i;
 	int ret = MDHIM_SUCCESS;
 	MPI_Request **reqs, *req;
-	int done = 0;
-	int flag = 0;
 	int msg_size;
 
 	sizebuf = malloc(sizeof(int) * nsrcs);
@@ -702,7 +839,6 @@ int receive_all_client_responses(struct mdhim_t *md, int *srcs, int nsrcs,
 	memset(reqs, 0, nsrcs * sizeof(MPI_Request *));
 	recvbufs = malloc(nsrcs * sizeof(void *));
 	memset(recvbufs, 0, nsrcs * sizeof(void *));
-	done =  0;
 	for (i = 0; i < nsrcs; i++) {
 	// Receive a size message from the servers in the list	
 		req = malloc(sizeof(MPI_Request));
@@ -719,41 +855,28 @@ int receive_all_client_responses(struct mdhim_t *md, int *srcs, int nsrcs,
 			mlog(MPI_CRIT, "Rank: %d - " 
 			     "Error receiving message in receive_client_response", 
 			     md->mdhim_rank);
+			free(req);
+			reqs[i] = NULL;
 			ret = MDHIM_ERROR;
 		}
 	}
 
 	//Wait for size messages to complete
-	while (done != nsrcs) {
-		for (i = 0; i < nsrcs; i++) {
-			req = reqs[i];
-			if (!req) {
-				continue;
-			}
-			
-			pthread_mutex_lock(md->mdhim_comm_lock);
-			return_code = MPI_Test(req, &flag, &status);
-			pthread_mutex_unlock(md->mdhim_comm_lock);
- 
-			if (return_code == MPI_ERR_REQUEST) {
-				mlog(MDHIM_SERVER_CRIT, "MDHIM Rank: %d - Received an error status: %d "
-				     " while receiving client response message size", 
-				     md->mdhim_rank, status.MPI_ERROR);
-			}
-			if (!flag) {
-			  continue;
-			}
-			free(req);
-			reqs[i] = NULL;
-			done++;		
-		}
+	if (wait_reqs(md, reqs, nsrcs, NULL, NULL) != MDHIM_SUCCESS) {
+		mlog(MDHIM_SERVER_CRIT, "MDHIM Rank: %d - Error while receiving "
+		     "client response message sizes", md->mdhim_rank);
+		ret = MDHIM_ERROR;
+	}
 
-		if (done != nsrcs) {
-			usleep(100);
+	//Without all sizes the responses can't be received, return no messages
+	if (ret != MDHIM_SUCCESS) {
+		for (i = 0; i < nsrcs; i++) {
+			*(*messages + i) = NULL;
 		}
+		free(reqs);
+		goto done;
 	}
 
-	done = 0;
 	for (i = 0; i < nsrcs; i++) {		
 		// Receive a message from the servers in the list			
 		recvbuf = malloc(sizebuf[i]);
@@ -777,32 +900,10 @@ int receive_all_client_responses(struct mdhim_t *md, int *srcs, int nsrcs,
 	}
 
 	//Wait for messages to complete
-	while (done != nsrcs) {
-		for (i = 0; i < nsrcs; i++) {
-			req = reqs[i];
-			if (!req) {
-				continue;
-			}
-			
-			pthread_mutex_lock(md->mdhim_comm_lock);
-			return_code = MPI_Test(req, &flag, &status);
-			pthread_mutex_unlock(md->mdhim_comm_lock);
-
-			if (return_code == MPI_ERR_REQUEST) {
-				mlog(MDHIM_SERVER_CRIT, "MDHIM Rank: %d - Received an error status: %d "
-				     " while receiving work message size", md->mdhim_rank, status.MPI_ERROR);
-			}
-			if (!flag) {
-			  continue;
-			}
-			free(req);
-			reqs[i] = NULL;
-			done++;		
-		}
-
-		if (done != nsrcs) {
-			usleep(100);
-		}
+	if (wait_reqs(md, reqs, nsrcs, NULL, NULL) != MDHIM_SUCCESS) {
+		mlog(MDHIM_SERVER_CRIT, "MDHIM Rank: %d - Error while receiving "
+		     "client response messages", md->mdhim_rank);
+		ret = MDHIM_ERROR;
 	}
 
 	free(reqs);
@@ -841,6 +942,7 @@ int receive_all_client_responses(struct mdhim_t *md, int *srcs, int nsrcs,
 		free(recvbuf);
 	}
 
+done:
 	free(recvbufs);
 	free(sizebuf);
 
@@ -914,6 +1016,111 @@ int pack_put_message(struct mdhim_t *md, struct mdhim_putm_t *pm, void **sendbuf
 	return MDHIM_SUCCESS;
 }
 
+/**
+ * fixed_record_size
+ * Returns the length shared by all records in lens, or 0 if the lengths differ
+ *
+ * @param lens  array of record lengths
+ * @param num   number of records
+ * @return the common record length or 0
+ */
+static int fixed_record_size(int *lens, int num) {
+	int i;
+
+	if (num <= 0 || lens[0] <= 0) {
+		return 0;
+	}
+
+	for (i = 1; i < num; i++) {
+		if (lens[i] != lens[0]) {
+			return 0;
+		}
+	}
+
+	return lens[0];
+}
+
+/**
+ * pack_fixed_records
+ * Packs records of the same size into sendbuf as one contiguous array.  Runs of 
+ * records that are already adjacent in memory are packed with a single call.
+ *
+ * @param md        in      main MDHIM struct
+ * @param recs      in      array of pointers to the records
+ * @param num       in      number of records
+ * @param size      in      size of each record
+ * @param sendbuf   in      buffer to pack into
+ * @param mesg_size in      size of sendbuf
+ * @param mesg_idx  in/out  current position in sendbuf
+ * @return MPI_SUCCESS or nonzero on error
+ */
+static int pack_fixed_records(struct mdhim_t *md, void **recs, int num, int size,
+			      void *sendbuf, int mesg_size, int *mesg_idx) {
+	int return_code = MPI_SUCCESS;
+	int i, run;
+
+	for (i = 0; i < num; i += run) {
+		run = 1;
+		while (i + run < num && 
+		       (char *) recs[i + run] == (char *) recs[i] + (size_t) run * size) {
+			run++;
+		}
+
+		return_code += MPI_Pack(recs[i], run * size, MPI_CHAR, sendbuf, 
+					mesg_size, mesg_idx, md->mdhim_comm);
+	}
+
+	return return_code;
+}
+
+/**
+ * unpack_fixed_bput_records
+ * Unpacks the keys and values of a fixed-width bulk put message into a single 
+ * records buffer and points the message's keys and values into it
+ *
+ * @param md         in   main MDHIM struct
+ * @param message    in   pointer for packed message we received
+ * @param mesg_size  in   size of the incoming message
+ * @param mesg_idx   in   position of the records in message
+ * @param bpm        in   bulk put message with its pointer and length arrays allocated
+ * @return MDHIM_SUCCESS or MDHIM_ERROR on error
+ */
+static int unpack_fixed_bput_records(struct mdhim_t *md, void *message, int mesg_size, 
+				     int *mesg_idx, struct mdhim_bputm_t *bpm) {
+	int return_code = MPI_SUCCESS;
+	int num_records = bpm->num_keys;
+	char *keybuf, *valbuf;
+	int i;
+
+	bpm->records = malloc((size_t) num_records * (bpm->key_size + bpm->value_size));
+	if (!bpm->records) {
+		mlog(MDHIM_SERVER_CRIT, "MDHIM Rank: %d - Error: unable to allocate "
+		     "memory to unpack bput message.", md->mdhim_rank);
+		return MDHIM_ERROR;
+	}
+
+	keybuf = bpm->records;
+	valbuf = keybuf + (size_t) num_records * bpm->key_size;
+	return_code += MPI_Unpack(message, mesg_size, mesg_idx, keybuf, 
+				  num_records * bpm->key_size, MPI_CHAR, md->mdhim_comm);
+	return_code += MPI_Unpack(message, mesg_size, mesg_idx, valbuf, 
+				  num_records * bpm->value_size, MPI_CHAR, md->mdhim_comm);
+	if (return_code != MPI_SUCCESS) {
+		mlog(MDHIM_SERVER_CRIT, "MDHIM Rank: %d - Error: unable to unpack "
+		     "the bput message.", md->mdhim_rank);
+		return MDHIM_ERROR;
+	}
+
+	for (i = 0; i < num_records; i++) {
+		bpm->keys[i] = keybuf + (size_t) i * bpm->key_size;
+		bpm->key_lens[i] = bpm->key_size;
+		bpm->values[i] = valbuf + (size_t) i * bpm->value_size;
+		bpm->value_lens[i] = bpm->value_size;
+	}
+
+	return MDHIM_SUCCESS;
+}
+
 /**
  * pack_bput_message
  * Packs a bulk put message structure into contiguous memory for message passing
@@ -941,12 +1148,26 @@ int pack_bput_message(struct mdhim_t *md, struct mdhim_bputm_t *bpm, void **send
     	int mesg_idx = 0;
         int i;
 
-        // Add the sizes of the length arrays (key_lens and data_lens)
-        m_size += 2 * bpm->num_keys * sizeof(int);
+        // Use the fixed-width layout if all keys and all values have the same length
+        bpm->key_size = fixed_record_size(bpm->key_lens, bpm->num_keys);
+        bpm->value_size = fixed_record_size(bpm->value_lens, bpm->num_keys);
+        if (!bpm->key_size || !bpm->value_size) {
+                bpm->key_size = 0;
+                bpm->value_size = 0;
+        }
+        bpm->records = NULL;
+
+        if (bpm->key_size) {
+                // One array of keys and one array of values, no lengths
+                m_size += (int64_t) bpm->num_keys * (bpm->key_size + bpm->value_size);
+        } else {
+                // Add the sizes of the length arrays (key_lens and data_lens)
+                m_size += 2 * bpm->num_keys * sizeof(int);
         
-        // For the each of the keys and data add enough chars.
-        for (i=0; i < bpm->num_keys; i++)
-                m_size += bpm->key_lens[i] + bpm->value_lens[i];
+                // For the each of the keys and data add enough chars.
+                for (i=0; i < bpm->num_keys; i++)
+                        m_size += bpm->key_lens[i] + bpm->value_lens[i];
+        }
         
         // Is the computed message size of a safe value? (less than a max message size?)
         if (m_size > MDHIM_MAX_MSG_SIZE) {
@@ -968,9 +1189,19 @@ int pack_bput_message(struct mdhim_t *md, struct mdhim_bputm_t *bpm, void **send
         return_code = MPI_Pack(bpm, sizeof(struct mdhim_bputm_t), MPI_CHAR, *sendbuf,
 			       mesg_size, &mesg_idx, md->mdhim_comm);
          
-        // For the each of the keys and data pack the chars plus two ints for key_len and data_len.
         gettimeofday(&packmpiputstart, NULL);
-        for (i=0; i < bpm->num_keys; i++) {
+        if (bpm->key_size) {
+                // Pack all of the keys and then all of the values
+                return_code += pack_fixed_records(md, bpm->keys, bpm->num_keys, 
+						  bpm->key_size, *sendbuf, 
+						  mesg_size, &mesg_idx);
+                return_code += pack_fixed_records(md, bpm->values, bpm->num_keys, 
+						  bpm->value_size, *sendbuf, 
+						  mesg_size, &mesg_idx);
+        }
+
+        // For the each of the keys and data pack the chars plus two ints for key_len and data_len.
+        for (i=0; i < bpm->num_keys && !bpm->key_size; i++) {
                 return_code += MPI_Pack(&bpm->key_lens[i], 1, MPI_INT, 
 					*sendbuf, mesg_size, &mesg_idx, md->mdhim_comm);
                 return_code += MPI_Pack(bpm->keys[i], bpm->key_lens[i], MPI_CHAR, 
@@ -1131,6 +1362,13 @@ int unpack_bput_message(struct mdhim_t *md, void *message, int mesg_size, void *
 		return MDHIM_ERROR; 
         }
         
+        // Fixed-width messages carry one array of keys and one array of values
+        (*((struct mdhim_bputm_t **) bput))->records = NULL;
+        if ((*((struct mdhim_bputm_t **) bput))->key_size) {
+		return unpack_fixed_bput_records(md, message, mesg_size, &mesg_idx, 
+						 *((struct mdhim_bputm_t **) bput));
+        }
+
         // For the each of the keys and data unpack the chars plus two ints for key_lens[i] and data_lens[i].
         for (i=0; i < num_records; i++) {
 		// Unpack the key_lens[i]
@@ -2130,7 +2368,9 @@ void mdhim_full_release_msg(void *msg) {
 		free((struct mdhim_bgetrm_t *) msg);
 		break;
 	case MDHIM_BULK_PUT:
-		for (i = 0; i < ((struct mdhim_bputm_t *) msg)->num_keys; i++) {
+		//Fixed-width keys and values all live in the records buffer
+		for (i = 0; i < ((struct mdhim_bputm_t *) msg)->num_keys && 
+			     !((struct mdhim_bputm_t *) msg)->records; i++) {
 			if (((struct mdhim_bputm_t *) msg)->key_lens[i] && 
 			    ((struct mdhim_bputm_t *) msg)->keys[i]) {
 				free(((struct mdhim_bputm_t *) msg)->keys[i]);
@@ -2153,6 +2393,9 @@ void mdhim_full_release_msg(void *msg) {
 		if (((struct mdhim_bputm_t *) msg)->values) {
 			free(((struct mdhim_bputm_t *) msg)->values);	
 		}
+		if (((struct mdhim_bputm_t *) msg)->records) {
+			free(((struct mdhim_bputm_t *) msg)->records);	
+		}
 
 		free((struct mdhim_bputm_t *) msg);
 		break;
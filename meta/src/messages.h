@@ -96,6 +96,12 @@ extern "C"
 
 //Maximum size of messages allowed
 #define MDHIM_MAX_MSG_SIZE 2147483647
+
+//Number of back-to-back tests of pending requests before sleeping
+#define MDHIM_WAIT_SPINS 64
+//Bounds (in nanoseconds) of the backoff sleep between tests
+#define MDHIM_WAIT_MIN_NS 1000
+#define MDHIM_WAIT_MAX_NS 100000
 struct mdhim_t;
 
 /* Base message */
@@ -127,6 +133,12 @@ struct mdhim_bputm_t {
 	void **values;
 	int *value_lens;
 	int num_keys;
+	/* If nonzero, every key and value has this length and the message 
+	   carries one array of keys followed by one array of values */
+	int key_size;
+	int value_size;
+	//Buffer the fixed-width keys and values were unpacked into, or NULL
+	void *records;
 };
 
 /* Get record message */
@@ -203,6 +215,10 @@ struct mdhim_brm_t {
 };
 
 
+int wait_reqs(struct mdhim_t *md, MPI_Request **reqs, int count,
+	      MPI_Status *statuses, volatile int *cancel);
+int post_rangesrv_wakeup(struct mdhim_t *md, MPI_Request *req);
+void finish_rangesrv_wakeup(struct mdhim_t *md, MPI_Request *req);
 int send_rangesrv_work(struct mdhim_t *md, int dest, void *message);
 int send_all_rangesrv_work(struct mdhim_t *md, void **messages, int num_srvs);
 int receive_rangesrv_work(struct mdhim_t *md, int *src, void **message);
@@ -253,8 +253,10 @@ int verify_key(struct index_t *index, void *key,
 		ikey = *(double *)key;
 	}
 
+	//Long int keys past the last slice are folded back into range by
+	//get_slice_num, so they need no size check
 	size_check = ikey/index->mdhim_max_recs_per_slice;
-	if (size_check >= MDHIM_MAX_SLICES) {
+	if (key_type != MDHIM_LONG_INT_KEY && size_check >= MDHIM_MAX_SLICES) {
 		mlog(MDHIM_CLIENT_CRIT, "Error - Not enough slices for this key." 
 		     "  Try increasing the slice size.");
 		return MDHIM_ERROR;
@@ -393,7 +395,16 @@ int get_slice_num(struct mdhim_t *md, struct index_t *index, void *key, int key_
 
 
 	/* Convert the key to a slice number  */
-	slice_num = key_num/index->mdhim_max_recs_per_slice;
+	if (key_type == MDHIM_LONG_INT_KEY) {
+		/* 64-bit keys (e.g., hashed gfids) can exceed the slice range;
+		 * wrap them so the slice number fits in an int.  Keys in
+		 * wrapped slices still map to one server, but GET_NEXT order
+		 * across the wrap point is not preserved. */
+		slice_num = (int)((key_num/index->mdhim_max_recs_per_slice) %
+				  MDHIM_MAX_SLICES);
+	} else {
+		slice_num = key_num/index->mdhim_max_recs_per_slice;
+	}
 
 	if (key_type == MDHIM_UNIFYFS_KEY) {
 		unsigned long *meta_pair = get_meta_pair(key, key_len);
@@ -53,38 +53,8 @@
 #include "unifyfs_metadata.h"
 #include "uthash.h"
 
-int recv_counter = 0;
-
-struct timeval resp_put_comm_start, resp_put_comm_end;
-double resp_put_comm_time = 0;
-
-struct timeval resp_get_comm_start, resp_get_comm_end;
-double resp_get_comm_time = 0;
 struct index_t *tmp_index;
 
-struct timeval worker_start, worker_end;
-double worker_time=0;
-
-struct timeval worker_get_start, worker_get_end;
-double worker_get_time=0;
-
-struct timeval worker_put_start, worker_put_end;
-double worker_put_time=0;
-
-struct timeval stat_start, stat_end;
-double stat_time=0;
-
-struct timeval odbgetstart, odbgetend;
-double odbgettime=0;
-
-struct timeval bputstart, bputend;
-double bputtime=0;
-
-struct timeval statstart, statend;
-double starttime=0;
-
-int putflag = 1;
-
 int unifyfs_compare(const char* a, const char* b) {
 	int rc;
 	unifyfs_key_t *keya = (unifyfs_key_t *)a;
@@ -186,56 +156,135 @@ struct index_t * find_index_by_name(struct mdhim_t *md, struct mdhim_basem_t *ms
     return ret;
 }
 
+/**
+ * get_work_queue_num
+ * Returns the work queue a message is handled from.  Messages are assigned by the 
+ * slice of their first key, so records in different slices are handled in parallel.
+ * Messages are handled in arrival order only relative to other messages whose
+ * first key is in the same slice.  A bulk message with keys in several slices is
+ * queued by its first key alone, so it may run concurrently with, and in either
+ * order relative to, messages for its other slices that are queued elsewhere.
+ *
+ * @param md   Pointer to the main MDHIM structure
+ * @param msg  the message to assign
+ * @return the work queue number
+ */
+static int get_work_queue_num(struct mdhim_t *md, struct mdhim_basem_t *msg) {
+	struct index_t *index;
+	void *key = NULL;
+	int key_len = 0;
+	int slice_num;
+
+	if (md->mdhim_rs->num_workers <= 1) {
+		return 0;
+	}
+
+	switch(msg->mtype) {
+	case MDHIM_PUT:
+		key = ((struct mdhim_putm_t *) msg)->key;
+		key_len = ((struct mdhim_putm_t *) msg)->key_len;
+		break;
+	case MDHIM_BULK_PUT:
+		if (((struct mdhim_bputm_t *) msg)->num_keys > 0) {
+			key = ((struct mdhim_bputm_t *) msg)->keys[0];
+			key_len = ((struct mdhim_bputm_t *) msg)->key_lens[0];
+		}
+		break;
+	case MDHIM_BULK_GET:
+		if (((struct mdhim_bgetm_t *) msg)->num_keys > 0) {
+			key = ((struct mdhim_bgetm_t *) msg)->keys[0];
+			key_len = ((struct mdhim_bgetm_t *) msg)->key_lens[0];
+		}
+		break;
+	case MDHIM_DEL:
+		key = ((struct mdhim_delm_t *) msg)->key;
+		key_len = ((struct mdhim_delm_t *) msg)->key_len;
+		break;
+	case MDHIM_BULK_DEL:
+		if (((struct mdhim_bdelm_t *) msg)->num_keys > 0) {
+			key = ((struct mdhim_bdelm_t *) msg)->keys[0];
+			key_len = ((struct mdhim_bdelm_t *) msg)->key_lens[0];
+		}
+		break;
+	default:
+		break;
+	}
+
+	if (!key || key_len <= 0) {
+		return 0;
+	}
+
+	index = find_index(md, msg);
+	if (!index) {
+		return 0;
+	}
+
+	slice_num = get_slice_num(md, index, key, key_len);
+	if (slice_num < 0) {
+		return 0;
+	}
+
+	return slice_num % md->mdhim_rs->num_workers;
+}
+
 /**
  * range_server_add_work
- * Adds work to the work queue and signals the condition variable for the worker thread
+ * Adds work to a worker's work queue and signals the worker's condition variable
  *
  * @param md      Pointer to the main MDHIM structure
  * @param item    pointer to new work item that contains a message to handle
  * @return MDHIM_SUCCESS
  */
 int range_server_add_work(struct mdhim_t *md, work_item *item) {
+	int id;
+	work_queue_t *queue;
+
+	id = get_work_queue_num(md, (struct mdhim_basem_t *) item->message);
+	queue = &md->mdhim_rs->work_queue[id];
+
 	//Lock the work queue mutex
-	pthread_mutex_lock(md->mdhim_rs->work_queue_mutex);
+	pthread_mutex_lock(&md->mdhim_rs->work_queue_mutex[id]);
 	item->next = NULL;
 	item->prev = NULL;       
 	
 	//Add work to the tail of the work queue
-	if (md->mdhim_rs->work_queue->tail) {
-		md->mdhim_rs->work_queue->tail->next = item;
-		item->prev = md->mdhim_rs->work_queue->tail;
-		md->mdhim_rs->work_queue->tail = item;
+	if (queue->tail) {
+		queue->tail->next = item;
+		item->prev = queue->tail;
+		queue->tail = item;
 	} else {
-		md->mdhim_rs->work_queue->head = item;
-		md->mdhim_rs->work_queue->tail = item;
+		queue->head = item;
+		queue->tail = item;
 	}
 
 	//Signal the waiting thread that there is work available
-	pthread_mutex_unlock(md->mdhim_rs->work_queue_mutex);
-	pthread_cond_signal(md->mdhim_rs->work_ready_cv);
+	pthread_mutex_unlock(&md->mdhim_rs->work_queue_mutex[id]);
+	pthread_cond_signal(&md->mdhim_rs->work_ready_cv[id]);
 
 	return MDHIM_SUCCESS;
 }
 
 /**
  * get_work
- * Returns the next work item from the work queue
+ * Returns the work items from a worker's work queue
  *
  * @param md  Pointer to the main MDHIM structure
- * @return  the next work_item to process
+ * @param id  the worker's queue number
+ * @return  the list of work_items to process
  */
 
-work_item *get_work(struct mdhim_t *md) {
+work_item *get_work(struct mdhim_t *md, int id) {
 	work_item *item;
+	work_queue_t *queue = &md->mdhim_rs->work_queue[id];
 
-	item = md->mdhim_rs->work_queue->head;
+	item = queue->head;
 	if (!item) {
 		return NULL;
 	}
 
 	//Set the list head and tail to NULL
-	md->mdhim_rs->work_queue->head = NULL;
-	md->mdhim_rs->work_queue->tail = NULL;
+	queue->head = NULL;
+	queue->tail = NULL;
 
 	//Return the list
 	return item;
@@ -251,32 +300,43 @@ work_item *get_work(struct mdhim_t *md) {
 int range_server_stop(struct mdhim_t *md) {
 	int i, ret;
 	work_item *head, *temp_item;
+	MPI_Request wakeup_req;
 
 	//Signal to the listener thread that it needs to shutdown
 	md->shutdown = 1;
+	//Wake the listener if it is blocked waiting for a work message
+	post_rangesrv_wakeup(md, &wakeup_req);
 
 	/* Wait for the threads to finish */
-	pthread_cond_broadcast(md->mdhim_rs->work_ready_cv);
+	for (i = 0; i < md->mdhim_rs->num_workers; i++) {
+		pthread_mutex_lock(&md->mdhim_rs->work_queue_mutex[i]);
+		pthread_cond_broadcast(&md->mdhim_rs->work_ready_cv[i]);
+		pthread_mutex_unlock(&md->mdhim_rs->work_queue_mutex[i]);
+	}
 	pthread_join(md->mdhim_rs->listener, NULL);
+	finish_rangesrv_wakeup(md, &wakeup_req);
 	/* Wait for the threads to finish */
-	for (i = 0; i < md->db_opts->num_wthreads; i++) {
+	for (i = 0; i < md->mdhim_rs->num_workers; i++) {
 		pthread_join(*md->mdhim_rs->workers[i], NULL);
 		free(md->mdhim_rs->workers[i]);
 	}
 	free(md->mdhim_rs->workers);
+	free(md->mdhim_rs->worker_args);
 		
-	//Destroy the condition variables
-	if ((ret = pthread_cond_destroy(md->mdhim_rs->work_ready_cv)) != 0) {
-	  mlog(MDHIM_SERVER_DBG, "Rank: %d - Error destroying work cond variable", 
-	       md->mdhim_rank);
-	}
-	free(md->mdhim_rs->work_ready_cv);
+	for (i = 0; i < md->mdhim_rs->num_workers; i++) {
+		//Destroy the condition variables
+		if ((ret = pthread_cond_destroy(&md->mdhim_rs->work_ready_cv[i])) != 0) {
+		  mlog(MDHIM_SERVER_DBG, "Rank: %d - Error destroying work cond variable", 
+		       md->mdhim_rank);
+		}
 		
-	//Destroy the work queue mutex
-	if ((ret = pthread_mutex_destroy(md->mdhim_rs->work_queue_mutex)) != 0) {
-	  mlog(MDHIM_SERVER_DBG, "Rank: %d - Error destroying work queue mutex", 
-	       md->mdhim_rank);
+		//Destroy the work queue mutex
+		if ((ret = pthread_mutex_destroy(&md->mdhim_rs->work_queue_mutex[i])) != 0) {
+		  mlog(MDHIM_SERVER_DBG, "Rank: %d - Error destroying work queue mutex", 
+		       md->mdhim_rank);
+		}
 	}
+	free(md->mdhim_rs->work_ready_cv);
 	free(md->mdhim_rs->work_queue_mutex);
 		
 	//Clean outstanding sends
@@ -288,12 +348,14 @@ int range_server_stop(struct mdhim_t *md) {
 	}
 	free(md->mdhim_rs->out_req_mutex);
 		
-	//Free the work queue
-	head = md->mdhim_rs->work_queue->head;
-	while (head) {
-	  temp_item = head->next;
-	  free(head);
-	  head = temp_item;
+	//Free the work queues
+	for (i = 0; i < md->mdhim_rs->num_workers; i++) {
+		head = md->mdhim_rs->work_queue[i].head;
+		while (head) {
+		  temp_item = head->next;
+		  free(head);
+		  head = temp_item;
+		}
 	}
 	free(md->mdhim_rs->work_queue);
 		
@@ -389,11 +451,7 @@ int range_server_put(struct mdhim_t *md, struct mdhim_putm_t *im, int source) {
 	}
 
 	if (!exists && error == MDHIM_SUCCESS) {
-		gettimeofday(&stat_start, NULL);
 		update_stat(md, index, im->key, im->key_len);
-		gettimeofday(&stat_end, NULL);
-		stat_time += 1000000 * (stat_end.tv_sec - stat_start.tv_sec) + \
-			stat_end.tv_usec - stat_start.tv_usec;
 	}
 
 	gettimeofday(&end, NULL);
@@ -435,7 +493,6 @@ done:
  * @return    MDHIM_SUCCESS or MDHIM_ERROR on error
  */
 int range_server_bput(struct mdhim_t *md, struct mdhim_bputm_t *bim, int source) {
-	putflag = 1;
 	int i;
 	int ret;
 	int error = MDHIM_SUCCESS;
@@ -452,9 +509,11 @@ int range_server_bput(struct mdhim_t *md, struct mdhim_bputm_t *bim, int source)
 	struct timeval start, end;
 	int num_put = 0;
 	struct index_t *index;
+	void **stat_keys;
+	int *stat_key_lens;
+	int num_stat;
 
 	gettimeofday(&start, NULL);
-	gettimeofday(&bputstart, NULL);
 	exists = malloc(bim->num_keys * sizeof(int));
 	new_values = malloc(bim->num_keys * sizeof(void *));
 	new_value_lens = malloc(bim->num_keys * sizeof(int));
@@ -469,15 +528,11 @@ int range_server_bput(struct mdhim_t *md, struct mdhim_bputm_t *bim, int source)
 		error = MDHIM_ERROR;
 		goto done;
 	}
-	gettimeofday(&bputend, NULL);
-	bputtime+=1000000 * (bputend.tv_sec - bputstart.tv_sec)\
-			+ bputend.tv_usec - bputstart.tv_usec;
 
 	for (i = 0; i < bim->num_keys && i < MAX_BULK_OPS; i++) {	
 		*value = NULL;
 		*value_len = 0;
 
-		gettimeofday(&odbgetstart, NULL);
 /*		index->mdhim_store->get(index->mdhim_store->db_handle, 
 					       bim->keys[i], bim->key_lens[i], value, 
 					       value_len);
@@ -496,7 +551,7 @@ int range_server_bput(struct mdhim_t *md, struct mdhim_bputm_t *bim, int source)
 			new_value = malloc(new_value_len);
 			memcpy(new_value, old_value, old_value_len);
 			memcpy(new_value + old_value_len, bim->values[i], bim->value_lens[i]);		
-			if (exists[i] && source != md->mdhim_rank) {
+			if (exists[i] && source != md->mdhim_rank && !bim->records) {
 				free(bim->values[i]);
 			}
 
@@ -511,9 +566,6 @@ int range_server_bput(struct mdhim_t *md, struct mdhim_bputm_t *bim, int source)
 		if (*value) {
 			free(*value);
 		}	
-		gettimeofday(&odbgetend, NULL);
-		odbgettime+=1000000 * (odbgetend.tv_sec\
-				- odbgetstart.tv_sec) + odbgetend.tv_usec - odbgetstart.tv_usec;
 	}
 
 	//Put the record in the database
@@ -528,27 +580,36 @@ int range_server_bput(struct mdhim_t *md, struct mdhim_bputm_t *bim, int source)
 		num_put = bim->num_keys;
 	}
 
-	gettimeofday(&stat_start, NULL);
-	for (i = 0; i < bim->num_keys && i < MAX_BULK_OPS; i++) {
-		//Update the stats if this key didn't exist before
-		if (!exists[i] && error == MDHIM_SUCCESS) {
-			update_stat(md, index, bim->keys[i], bim->key_lens[i]);
+	//Update the stats of the keys that didn't exist before in one batch
+	if (error == MDHIM_SUCCESS) {
+		stat_keys = malloc(bim->num_keys * sizeof(void *));
+		stat_key_lens = malloc(bim->num_keys * sizeof(int));
+		num_stat = 0;
+		for (i = 0; i < bim->num_keys && i < MAX_BULK_OPS; i++) {
+			if (!exists[i]) {
+				stat_keys[num_stat] = bim->keys[i];
+				stat_key_lens[num_stat] = bim->key_lens[i];
+				num_stat++;
+			}
 		}
-	       
+		update_stats(md, index, stat_keys, stat_key_lens, num_stat);
+		free(stat_keys);
+		free(stat_key_lens);
+	}
+
+	for (i = 0; i < bim->num_keys && i < MAX_BULK_OPS; i++) {
 		if (exists[i] && md->db_opts->db_value_append == MDHIM_DB_APPEND) {
 			//Release the value created for appending the new and old value
 			free(new_values[i]);
 		}		
 
 		//Release the bput keys/value if the message isn't coming from myself
-		if (source != md->mdhim_rank) {
+		//and they were not unpacked into a single records buffer
+		if (source != md->mdhim_rank && !bim->records) {
 			free(bim->keys[i]);
 			free(bim->values[i]);
 		} 
 	}
-	gettimeofday(&stat_end, NULL);
-	stat_time += 1000000 * (stat_end.tv_sec - stat_start.tv_sec) + \
-		stat_end.tv_usec - stat_start.tv_usec;
 
 	free(exists);
 	free(new_values);
@@ -573,10 +634,10 @@ int range_server_bput(struct mdhim_t *md, struct mdhim_bputm_t *bim, int source)
 	free(bim->key_lens);
 	free(bim->values);
 	free(bim->value_lens);
+	free(bim->records);
 	free(bim);
 
 	//Send response
-	gettimeofday(&resp_put_comm_start, NULL);	
 	ret = send_locally_or_remote(md, source, brm);
 
 	return MDHIM_SUCCESS;
@@ -745,7 +806,6 @@ int range_server_commit(struct mdhim_t *md, struct mdhim_basem_t *im, int source
  * @return    MDHIM_SUCCESS or MDHIM_ERROR on error
  */
 int range_server_bget(struct mdhim_t *md, struct mdhim_bgetm_t *bgm, int source) {
-	putflag = 0;
 	int ret;
 	void **values = NULL;
 	int32_t *value_lens = NULL;
@@ -914,7 +974,6 @@ done:
 	bgrm->basem.index_type = index->type;
 
 	//Send response
-	gettimeofday(&resp_get_comm_start, NULL);
 	ret = send_locally_or_remote(md, source, bgrm);
 
 	//Release the bget message
@@ -934,7 +993,6 @@ done:
  * @return    MDHIM_SUCCESS or MDHIM_ERROR on error
  */
 int range_server_bget_op(struct mdhim_t *md, struct mdhim_bgetm_t *bgm, int source, int op) {
-	putflag = 0;
 	int error = 0;
 	void **values;
 	void **keys;
@@ -1144,7 +1202,6 @@ respond:
 	bgrm->basem.index_type = index->type;
        
 	//Send response
-	gettimeofday(&resp_get_comm_start, NULL);
 	ret = send_locally_or_remote(md, source, bgrm);
 	//Free stuff
 	if (source == md->mdhim_rank) {
@@ -1193,7 +1250,6 @@ void *listener_thread(void *data) {
 		}
 		//printf("Rank: %d - Received message from rank: %d of type: %d", 
 		//     md->mdhim_rank, source, mtype);
-		recv_counter++;
         //Create a new work item
 		item = malloc(sizeof(work_item));
 		memset(item, 0, sizeof(work_item));
@@ -1211,11 +1267,14 @@ void *listener_thread(void *data) {
 
 /*
  * worker_thread
- * Function for the thread that processes work in work queue
+ * Function for the thread that processes the work in its own work queue
  */
 void *worker_thread(void *data) {
 	//Mlog statements could cause a deadlock on range_server_stop due to canceling of threads
-	struct mdhim_t *md = (struct mdhim_t *) data;
+	worker_arg_t *arg = (worker_arg_t *) data;
+	struct mdhim_t *md = arg->md;
+	int id = arg->id;
+	pthread_mutex_t *queue_mutex = &md->mdhim_rs->work_queue_mutex[id];
 	work_item *item, *item_tmp;
 	int mtype;
 	int op, num_records, num_keys;
@@ -1225,27 +1284,26 @@ void *worker_thread(void *data) {
 			break;
 		}
 		//Lock the work queue mutex
-		pthread_mutex_lock(md->mdhim_rs->work_queue_mutex);
+		pthread_mutex_lock(queue_mutex);
 		pthread_cleanup_push((void (*)(void *)) pthread_mutex_unlock,
-				     (void *) md->mdhim_rs->work_queue_mutex);
+				     (void *) queue_mutex);
 
 		//Wait until there is work to be performed
-		if ((item = get_work(md)) == NULL) {
-			pthread_cond_wait(md->mdhim_rs->work_ready_cv, md->mdhim_rs->work_queue_mutex);
-			item = get_work(md);
+		if ((item = get_work(md, id)) == NULL && !md->shutdown) {
+			pthread_cond_wait(&md->mdhim_rs->work_ready_cv[id], queue_mutex);
+			item = get_work(md, id);
 		}
 	       
 		pthread_cleanup_pop(0);
 		if (!item) {
-			pthread_mutex_unlock(md->mdhim_rs->work_queue_mutex);			
+			pthread_mutex_unlock(queue_mutex);			
 			continue;
 		}
-		pthread_mutex_unlock(md->mdhim_rs->work_queue_mutex);
+		pthread_mutex_unlock(queue_mutex);
 
 		//Clean outstanding sends
 		range_server_clean_oreqs(md);
 
-		gettimeofday(&worker_start, NULL);
 		while (item) {
 			//Call the appropriate function depending on the message type			
 			//Get the message type
@@ -1260,15 +1318,11 @@ void *worker_thread(void *data) {
 				break;
 			case MDHIM_BULK_PUT:
 				//Pack the bulk put message and pass to range_server_put
-				gettimeofday(&worker_put_start, NULL);
 				range_server_bput(md, 
 						  item->message, 
 						  item->source);
-				gettimeofday(&worker_put_end, NULL);
-				worker_put_time += 1000000*(worker_put_end.tv_sec-worker_put_start.tv_sec)+worker_put_end.tv_usec-worker_put_start.tv_usec;
 				break;
 			case MDHIM_BULK_GET:
-				gettimeofday(&worker_get_start, NULL);
 				op = ((struct mdhim_bgetm_t *) item->message)->op;
 				num_records = ((struct mdhim_bgetm_t *) item->message)->num_recs;
 				num_keys = ((struct mdhim_bgetm_t *) item->message)->num_keys;
@@ -1283,8 +1337,6 @@ void *worker_thread(void *data) {
 							  item->source);
 				}
 
-				gettimeofday(&worker_get_end, NULL);
-				worker_get_time += 1000000*(worker_get_end.tv_sec-worker_get_start.tv_sec)+worker_get_end.tv_usec-worker_get_start.tv_usec;
 				break;
 			case MDHIM_DEL:
 				range_server_del(md, item->message, item->source);
@@ -1308,20 +1360,6 @@ void *worker_thread(void *data) {
 
 		//Clean outstanding sends
 		range_server_clean_oreqs(md);			
-		if (putflag == 0) {	
-			gettimeofday(&worker_end, NULL);
-			gettimeofday(&resp_get_comm_end, NULL);
-			resp_get_comm_time+=1000000*(resp_get_comm_end.tv_sec\
-			-resp_get_comm_start.tv_sec)+resp_get_comm_end.tv_usec\
-			-resp_get_comm_start.tv_usec;
-		}
-		else {
-			gettimeofday(&resp_put_comm_end, NULL);
-			resp_put_comm_time+=1000000*(resp_put_comm_end.tv_sec\
-			-resp_put_comm_start.tv_sec)+resp_put_comm_end.tv_usec\
-			-resp_put_comm_start.tv_usec;	
-		}
-		worker_time += 1000000*(worker_end.tv_sec-worker_start.tv_sec)+worker_end.tv_usec-worker_start.tv_usec;	
 	}
 	return NULL;
 }
@@ -1435,28 +1473,41 @@ int range_server_init(struct mdhim_t *md) {
 	md->mdhim_rs->get_time = 0;
 	md->mdhim_rs->num_put = 0;
 	md->mdhim_rs->num_get = 0;
-	//Initialize work queue
-	md->mdhim_rs->work_queue = malloc(sizeof(work_queue_t));
-	md->mdhim_rs->work_queue->head = NULL;
-	md->mdhim_rs->work_queue->tail = NULL;
-
-	//Initialize the outstanding request list
-	md->mdhim_rs->out_req_list = NULL;
 
-	//Initialize work queue mutex
-	md->mdhim_rs->work_queue_mutex = malloc(sizeof(pthread_mutex_t));
-	if (!md->mdhim_rs->work_queue_mutex) {
+	//Initialize one work queue with its mutex and condition variable per worker
+	md->mdhim_rs->num_workers = md->db_opts->num_wthreads;
+	md->mdhim_rs->work_queue = malloc(sizeof(work_queue_t) * md->mdhim_rs->num_workers);
+	md->mdhim_rs->work_queue_mutex = malloc(sizeof(pthread_mutex_t) * 
+						md->mdhim_rs->num_workers);
+	md->mdhim_rs->work_ready_cv = malloc(sizeof(pthread_cond_t) * 
+					     md->mdhim_rs->num_workers);
+	if (!md->mdhim_rs->work_queue || !md->mdhim_rs->work_queue_mutex ||
+	    !md->mdhim_rs->work_ready_cv) {
 		mlog(MDHIM_SERVER_CRIT, "MDHIM Rank: %d - " 
 		     "Error while allocating memory for range server", 
 		     md->mdhim_rank);
 		return MDHIM_ERROR;
 	}
-	if ((ret = pthread_mutex_init(md->mdhim_rs->work_queue_mutex, NULL)) != 0) {    
-		mlog(MDHIM_SERVER_CRIT, "MDHIM Rank: %d - " 
-		     "Error while initializing work queue mutex", md->mdhim_rank);
-		return MDHIM_ERROR;
+
+	for (i = 0; i < md->mdhim_rs->num_workers; i++) {
+		md->mdhim_rs->work_queue[i].head = NULL;
+		md->mdhim_rs->work_queue[i].tail = NULL;
+		if ((ret = pthread_mutex_init(&md->mdhim_rs->work_queue_mutex[i], NULL)) != 0) {    
+			mlog(MDHIM_SERVER_CRIT, "MDHIM Rank: %d - " 
+			     "Error while initializing work queue mutex", md->mdhim_rank);
+			return MDHIM_ERROR;
+		}
+		if ((ret = pthread_cond_init(&md->mdhim_rs->work_ready_cv[i], NULL)) != 0) {
+			mlog(MDHIM_SERVER_CRIT, "MDHIM Rank: %d - " 
+			     "Error while initializing condition variable", 
+			     md->mdhim_rank);
+			return MDHIM_ERROR;
+		}
 	}
 
+	//Initialize the outstanding request list
+	md->mdhim_rs->out_req_list = NULL;
+
 	//Initialize out req mutex
 	md->mdhim_rs->out_req_mutex = malloc(sizeof(pthread_mutex_t));
 	if (!md->mdhim_rs->out_req_mutex) {
@@ -1471,27 +1522,16 @@ int range_server_init(struct mdhim_t *md) {
 		return MDHIM_ERROR;
 	}
 
-	//Initialize the condition variables
-	md->mdhim_rs->work_ready_cv = malloc(sizeof(pthread_cond_t));
-	if (!md->mdhim_rs->work_ready_cv) {
-		mlog(MDHIM_SERVER_CRIT, "MDHIM Rank: %d - " 
-		     "Error while allocating memory for range server", 
-		     md->mdhim_rank);
-		return MDHIM_ERROR;
-	}
-	if ((ret = pthread_cond_init(md->mdhim_rs->work_ready_cv, NULL)) != 0) {
-		mlog(MDHIM_SERVER_CRIT, "MDHIM Rank: %d - " 
-		     "Error while initializing condition variable", 
-		     md->mdhim_rank);
-		return MDHIM_ERROR;
-	}
-	
 	//Initialize worker threads
-	md->mdhim_rs->workers = malloc(sizeof(pthread_t *) * md->db_opts->num_wthreads);
-	for (i = 0; i < md->db_opts->num_wthreads; i++) {
+	md->mdhim_rs->workers = malloc(sizeof(pthread_t *) * md->mdhim_rs->num_workers);
+	md->mdhim_rs->worker_args = malloc(sizeof(worker_arg_t) * md->mdhim_rs->num_workers);
+	for (i = 0; i < md->mdhim_rs->num_workers; i++) {
+		md->mdhim_rs->worker_args[i].md = md;
+		md->mdhim_rs->worker_args[i].id = i;
 		md->mdhim_rs->workers[i] = malloc(sizeof(pthread_t));
 		if ((ret = pthread_create(md->mdhim_rs->workers[i], NULL, 
-					  worker_thread, (void *) md)) != 0) {    
+					  worker_thread, 
+					  (void *) &md->mdhim_rs->worker_args[i])) != 0) {    
 			mlog(MDHIM_SERVER_CRIT, "MDHIM Rank: %d - " 
 			     "Error while initializing worker thread", 
 			     md->mdhim_rank);
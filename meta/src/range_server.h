@@ -67,13 +67,25 @@ struct out_req {
 	MPI_Request *message;
 };
 
+/* Argument passed to a worker thread */
+typedef struct worker_arg_t {
+	struct mdhim_t *md;
+	//The worker's index in the work queue arrays
+	int id;
+} worker_arg_t;
+
 /* Range server specific data */
 typedef struct mdhim_rs_t {
+	/* Arrays of num_workers work queues with their mutexes and condition 
+	   variables, one per worker thread.  Work is assigned to a queue by the 
+	   slice of its first key. */
 	work_queue_t *work_queue;
 	pthread_mutex_t *work_queue_mutex;
 	pthread_cond_t *work_ready_cv;
 	pthread_t listener;
 	pthread_t **workers;
+	worker_arg_t *worker_args;
+	int num_workers;
 	struct index *indexes; /* A linked list of remote indexes that is served 
 				  (partially for fully) by this range server */
 	//Records seconds spent on putting records
@@ -101,6 +101,16 @@ static void register_server_server_rpcs(margo_instance_id mid)
         MARGO_REGISTER(mid, "chunk_read_response_rpc",
                        chunk_read_response_in_t, chunk_read_response_out_t,
                        chunk_read_response_rpc);
+
+    unifyfsd_rpc_context->rpcs.fsync_flush_id =
+        MARGO_REGISTER(mid, "fsync_flush_rpc",
+                       fsync_flush_in_t, fsync_flush_out_t,
+                       fsync_flush_rpc);
+
+    unifyfsd_rpc_context->rpcs.extents_invalidate_id =
+        MARGO_REGISTER(mid, "extents_invalidate_rpc",
+                       extents_invalidate_in_t, extents_invalidate_out_t,
+                       extents_invalidate_rpc);
 }
 
 /* setup_local_target - Initializes the client-server margo target */
@@ -170,14 +180,6 @@ static void register_client_server_rpcs(margo_instance_id mid)
     MARGO_REGISTER(mid, "unifyfs_filesize_rpc",
                    unifyfs_filesize_in_t, unifyfs_filesize_out_t,
                    unifyfs_filesize_rpc);
-
-    MARGO_REGISTER(mid, "unifyfs_read_rpc",
-                   unifyfs_read_in_t, unifyfs_read_out_t,
-                   unifyfs_read_rpc)
-
-    MARGO_REGISTER(mid, "unifyfs_mread_rpc",
-                   unifyfs_mread_in_t, unifyfs_mread_out_t,
-                   unifyfs_mread_rpc);
 }
 
 /* margo_server_rpc_init
@@ -20,6 +20,8 @@ typedef struct ServerRpcIds {
     hg_id_t request_id;
     hg_id_t chunk_read_request_id;
     hg_id_t chunk_read_response_id;
+    hg_id_t fsync_flush_id;
+    hg_id_t extents_invalidate_id;
 } server_rpcs_t;
 
 typedef struct ServerRpcContext {
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+ * Produced at the Lawrence Livermore National Laboratory.
+ *
+ * Copyright 2017-2019, UT-Battelle, LLC.
+ *
+ * LLNL-CODE-741539
+ * All rights reserved.
+ *
+ * This is the license for UnifyFS.
+ * For details, see https://github.com/LLNL/UnifyFS.
+ * Please read https://github.com/LLNL/UnifyFS/LICENSE for full license text.
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "unifyfs_const.h"
+#include "unifyfs_log.h"
+#include "unifyfs_bufpool.h"
+
+/* number of size classes, BUFPOOL_MIN_SIZE << i for class i */
+#define BUFPOOL_NUM_CLASSES \
+    (BUFPOOL_MAX_SHIFT - BUFPOOL_MIN_SHIFT + 1)
+
+#define BUFPOOL_MIN_SIZE ((size_t)1 << BUFPOOL_MIN_SHIFT)
+#define BUFPOOL_MAX_SIZE ((size_t)1 << BUFPOOL_MAX_SHIFT)
+
+/* class of buffers that are not pooled */
+#define BUFPOOL_NO_CLASS (-1)
+
+/* header in front of each buffer, padded to keep the
+ * buffer aligned as well as malloc() would */
+typedef union bufpool_hdr {
+    struct {
+        int class_ndx;            /* size class of buffer */
+        union bufpool_hdr* next;  /* next cached buffer of class */
+    } h;
+    char pad[64];
+} bufpool_hdr_t;
+
+/* cached buffers of one size class */
+typedef struct {
+    pthread_mutex_t lock;
+    bufpool_hdr_t* head;
+    size_t num_cached;
+} bufpool_class_t;
+
+static bufpool_class_t bufpool_classes[BUFPOOL_NUM_CLASSES];
+
+/* bytes cached over all classes, kept below BUFPOOL_MAX_TOTAL */
+static size_t bufpool_cached_bytes; // = 0
+static pthread_once_t bufpool_once = PTHREAD_ONCE_INIT;
+/* set by bufpool_fini(), read under a class lock so that no buffer
+ * is cached in a class after it has been drained */
+static int bufpool_closed; // = 0
+
+static void bufpool_init_classes(void)
+{
+    int i;
+    for (i = 0; i < BUFPOOL_NUM_CLASSES; i++) {
+        pthread_mutex_init(&(bufpool_classes[i].lock), NULL);
+        bufpool_classes[i].head = NULL;
+        bufpool_classes[i].num_cached = 0;
+    }
+}
+
+/* return size class for size, or BUFPOOL_NO_CLASS if too large */
+static int bufpool_class_of(size_t size)
+{
+    if (size > BUFPOOL_MAX_SIZE) {
+        return BUFPOOL_NO_CLASS;
+    }
+    int ndx = 0;
+    size_t class_sz = BUFPOOL_MIN_SIZE;
+    while (class_sz < size) {
+        class_sz <<= 1;
+        ndx++;
+    }
+    return ndx;
+}
+
+void* bufpool_alloc(size_t size)
+{
+    pthread_once(&bufpool_once, bufpool_init_classes);
+
+    bufpool_hdr_t* hdr = NULL;
+    int ndx = bufpool_class_of(size);
+    if (ndx != BUFPOOL_NO_CLASS) {
+        /* reuse a cached buffer of the class if we have one */
+        bufpool_class_t* bc = bufpool_classes + ndx;
+        pthread_mutex_lock(&(bc->lock));
+        hdr = bc->head;
+        if (NULL != hdr) {
+            bc->head = hdr->h.next;
+            bc->num_cached--;
+            __atomic_sub_fetch(&bufpool_cached_bytes,
+                               (BUFPOOL_MIN_SIZE << ndx), __ATOMIC_RELAXED);
+        }
+        pthread_mutex_unlock(&(bc->lock));
+        if (NULL == hdr) {
+            hdr = (bufpool_hdr_t*)
+                malloc(sizeof(bufpool_hdr_t) + (BUFPOOL_MIN_SIZE << ndx));
+        }
+    } else {
+        hdr = (bufpool_hdr_t*) malloc(sizeof(bufpool_hdr_t) + size);
+    }
+    if (NULL == hdr) {
+        LOGERR("failed to allocate buffer of %zu bytes", size);
+        return NULL;
+    }
+    hdr->h.class_ndx = ndx;
+    hdr->h.next = NULL;
+    return (void*)(hdr + 1);
+}
+
+void bufpool_free(void* buf)
+{
+    if (NULL == buf) {
+        return;
+    }
+
+    bufpool_hdr_t* hdr = ((bufpool_hdr_t*)buf) - 1;
+    int ndx = hdr->h.class_ndx;
+    if (ndx != BUFPOOL_NO_CLASS) {
+        /* keep buffer for reuse unless class cache or the pool
+         * as a whole is full */
+        bufpool_class_t* bc = bufpool_classes + ndx;
+        size_t class_sz = BUFPOOL_MIN_SIZE << ndx;
+        size_t max_cached = BUFPOOL_MAX_CACHED / class_sz;
+        if (max_cached == 0) {
+            max_cached = 1;
+        }
+        pthread_mutex_lock(&(bc->lock));
+        if (!__atomic_load_n(&bufpool_closed, __ATOMIC_RELAXED) &&
+            (bc->num_cached < max_cached)) {
+            size_t total = __atomic_add_fetch(&bufpool_cached_bytes,
+                                              class_sz, __ATOMIC_RELAXED);
+            if (total <= BUFPOOL_MAX_TOTAL) {
+                hdr->h.next = bc->head;
+                bc->head = hdr;
+                bc->num_cached++;
+                hdr = NULL;
+            } else {
+                __atomic_sub_fetch(&bufpool_cached_bytes, class_sz,
+                                   __ATOMIC_RELAXED);
+            }
+        }
+        pthread_mutex_unlock(&(bc->lock));
+    }
+    if (NULL != hdr) {
+        free(hdr);
+    }
+}
+
+void bufpool_fini(void)
+{
+    pthread_once(&bufpool_once, bufpool_init_classes);
+
+    __atomic_store_n(&bufpool_closed, 1, __ATOMIC_RELAXED);
+    int i;
+    for (i = 0; i < BUFPOOL_NUM_CLASSES; i++) {
+        bufpool_class_t* bc = bufpool_classes + i;
+        pthread_mutex_lock(&(bc->lock));
+        while (NULL != bc->head) {
+            bufpool_hdr_t* hdr = bc->head;
+            bc->head = hdr->h.next;
+            free(hdr);
+            __atomic_sub_fetch(&bufpool_cached_bytes,
+                               (BUFPOOL_MIN_SIZE << i), __ATOMIC_RELAXED);
+        }
+        bc->num_cached = 0;
+        pthread_mutex_unlock(&(bc->lock));
+    }
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+ * Produced at the Lawrence Livermore National Laboratory.
+ *
+ * Copyright 2017-2019, UT-Battelle, LLC.
+ *
+ * LLNL-CODE-741539
+ * All rights reserved.
+ *
+ * This is the license for UnifyFS.
+ * For details, see https://github.com/LLNL/UnifyFS.
+ * Please read https://github.com/LLNL/UnifyFS/LICENSE for full license text.
+ */
+
+#ifndef UNIFYFS_BUFPOOL_H
+#define UNIFYFS_BUFPOOL_H
+
+#include <stddef.h>
+
+/* Pool of reusable buffers for the read path (chunk read requests
+ * and responses). Buffers are grouped in power-of-two size classes
+ * between BUFPOOL_MIN_SIZE and BUFPOOL_MAX_SIZE, and released buffers
+ * are kept for reuse up to BUFPOOL_MAX_CACHED bytes per class, and
+ * BUFPOOL_MAX_TOTAL bytes over all classes. Larger buffers are
+ * allocated and freed directly. Buffer contents are NOT zeroed. */
+
+/* allocate buffer of at least size bytes, returns NULL on failure */
+void* bufpool_alloc(size_t size);
+
+/* return buffer from bufpool_alloc() to pool, NULL is ignored */
+void bufpool_free(void* buf);
+
+/* free all cached buffers, buffers released afterwards are freed */
+void bufpool_fini(void);
+
+#endif // UNIFYFS_BUFPOOL_H
@@ -103,11 +103,19 @@ static int attach_to_shm(app_config_t* app_config,
         return (int)UNIFYFS_ERROR_SHMEM;
     }
     app_config->shm_recv_bufs[client_side_id] = addr;
-    shm_header_t* shm_hdr = (shm_header_t*)addr;
-    pthread_mutex_init(&(shm_hdr->sync), NULL);
-    shm_hdr->meta_cnt = 0;
-    shm_hdr->bytes = 0;
-    shm_hdr->state = SHMEM_REGION_EMPTY;
+    app_config->recv_slots[client_side_id] = 0;
+    app_config->fsync_rc[client_side_id] = (int)UNIFYFS_SUCCESS;
+    int slot;
+    for (slot = 0; slot < app_config->recv_buf_slots; slot++) {
+        shm_header_t* shm_hdr =
+            unifyfs_shm_recv_slot(addr, app_config->recv_buf_sz,
+                                  app_config->recv_buf_slots, slot);
+        pthread_mutex_init(&(shm_hdr->sync), NULL);
+        shm_hdr->meta_cnt = 0;
+        shm_hdr->bytes = 0;
+        shm_hdr->state = SHMEM_REGION_EMPTY;
+        shm_hdr->waiters = 0;
+    }
 
     /* copy name of request buffer region */
     strcpy(app_config->recv_buf_name[client_side_id], shm_name);
@@ -208,6 +216,10 @@ static void unifyfs_mount_rpc(hg_handle_t handle)
         /* record size of shared memory regions */
         tmp_config->req_buf_sz    = in.req_buf_sz;
         tmp_config->recv_buf_sz   = in.recv_buf_sz;
+        tmp_config->recv_buf_slots = in.recv_buf_slots;
+        if (tmp_config->recv_buf_slots < 1) {
+            tmp_config->recv_buf_slots = 1;
+        }
         tmp_config->superblock_sz = in.superblock_sz;
 
         /* record offset and size of index entries */
@@ -277,7 +289,7 @@ static void unifyfs_mount_rpc(hg_handle_t handle)
         ret = rc;
     }
 
-    /* create request manager thread */
+    /* create request manager state */
     reqmgr_thrd_t* rm_thrd = unifyfs_rm_thrd_create(app_id, client_id);
     if (rm_thrd != NULL) {
         /* TODO: seems like it would be cleaner to avoid thread_list
@@ -285,7 +297,7 @@ static void unifyfs_mount_rpc(hg_handle_t handle)
         /* remember id for thread control for this client */
         tmp_config->thrd_idxs[client_id] = rm_thrd->thrd_ndx;
     } else {
-        /* failed to create request manager thread */
+        /* failed to create request manager state */
         LOGERR("unifyfs_rm_thrd_create() failed for app_id=%d client_id=%d",
                app_id, client_id);
         ret = UNIFYFS_FAILURE;
@@ -295,6 +307,7 @@ static void unifyfs_mount_rpc(hg_handle_t handle)
     unifyfs_mount_out_t out;
     out.ret = ret;
     out.max_recs_per_slice = max_recs_per_slice;
+    out.bell_id = (int32_t) rm_ring_bell_id();
 
     /* send output back to caller */
     hret = margo_respond(handle, &out);
@@ -339,7 +352,8 @@ static void unifyfs_unmount_rpc(hg_handle_t handle)
     /* look up thread control structure */
     reqmgr_thrd_t* thrd_ctrl = rm_get_thread(thrd_id);
 
-    /* shutdown the delegator thread */
+    /* stop request manager work for this client, this waits for
+     * its queued tasks, so none touch the shared memory freed below */
     rm_cmd_exit(thrd_ctrl);
 
     /* detach from the request shared memory */
@@ -452,7 +466,8 @@ static void unifyfs_fsync_rpc(hg_handle_t handle)
 
     /* given global file id, read index metadata from client and
      * insert into global index key/value store */
-    int ret = rm_cmd_fsync(in.app_id, in.local_rank_idx, in.gfid);
+    int ret = rm_cmd_fsync(in.app_id, in.local_rank_idx, in.gfid,
+                           (int)in.async);
 
     /* build our output values */
     unifyfs_metaset_out_t out;
@@ -499,86 +514,3 @@ static void unifyfs_filesize_rpc(hg_handle_t handle)
 }
 DEFINE_MARGO_RPC_HANDLER(unifyfs_filesize_rpc)
 
-/* given an app_id, client_id, global file id, an offset, and a length,
- * initiate read operation to lookup and return data,
- * client synchronizes with server again later when data is available
- * to be copied into user buffers */
-static void unifyfs_read_rpc(hg_handle_t handle)
-{
-    /* get input params */
-    unifyfs_read_in_t in;
-    hg_return_t hret = margo_get_input(handle, &in);
-    assert(hret == HG_SUCCESS);
-
-    /* read data for a single read request from client,
-     * returns data to client through shared memory */
-    int ret = rm_cmd_read(in.app_id, in.local_rank_idx,
-                          in.gfid, in.offset, in.length);
-
-    /* build our output values */
-    unifyfs_read_out_t out;
-    out.ret = ret;
-
-    /* return to caller */
-    hret = margo_respond(handle, &out);
-    assert(hret == HG_SUCCESS);
-
-    /* free margo resources */
-    margo_free_input(handle, &in);
-    margo_destroy(handle);
-}
-DEFINE_MARGO_RPC_HANDLER(unifyfs_read_rpc)
-
-/* given an app_id, client_id, global file id, and a count
- * of read requests, follow by list of offset/length tuples
- * initiate read requests for data,
- * client synchronizes with server again later when data is available
- * to be copied into user buffers */
-static void unifyfs_mread_rpc(hg_handle_t handle)
-{
-    /* get input params */
-    unifyfs_mread_in_t in;
-    hg_return_t hret = margo_get_input(handle, &in);
-    assert(hret == HG_SUCCESS);
-
-    /* allocate buffer to hold array of read requests */
-    hg_size_t size = in.bulk_size;
-    void* buffer = (void*)malloc(size);
-    assert(buffer);
-
-    /* get pointer to mercury structures to set up bulk transfer */
-    const struct hg_info* hgi = margo_get_info(handle);
-    assert(hgi);
-    margo_instance_id mid = margo_hg_info_get_instance(hgi);
-    assert(mid != MARGO_INSTANCE_NULL);
-
-    /* register local target buffer for bulk access */
-    hg_bulk_t bulk_handle;
-    hret = margo_bulk_create(mid, 1, &buffer, &size,
-                             HG_BULK_WRITE_ONLY, &bulk_handle);
-    assert(hret == HG_SUCCESS);
-
-    /* get list of read requests */
-    hret = margo_bulk_transfer(mid, HG_BULK_PULL, hgi->addr,
-                               in.bulk_handle, 0, bulk_handle, 0, size);
-    assert(hret == HG_SUCCESS);
-
-    /* initiate read operations to fetch data for read requests */
-    int ret = rm_cmd_mread(in.app_id, in.local_rank_idx,
-                           in.read_count, buffer);
-
-    /* build our output values */
-    unifyfs_mread_out_t out;
-    out.ret = ret;
-
-    /* return to caller */
-    hret = margo_respond(handle, &out);
-    assert(hret == HG_SUCCESS);
-
-    /* free margo resources */
-    margo_free_input(handle, &in);
-    margo_bulk_free(bulk_handle);
-    free(buffer);
-    margo_destroy(handle);
-}
-DEFINE_MARGO_RPC_HANDLER(unifyfs_mread_rpc)
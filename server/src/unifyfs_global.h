@@ -79,6 +79,7 @@ typedef enum {
 } readreq_status_e;
 
 typedef struct {
+    uint64_t gfid;      /* global file id */
     size_t nbytes;      /* size of data chunk */
     size_t offset;      /* file offset */
     size_t log_offset;  /* remote log offset */
@@ -87,9 +88,14 @@ typedef struct {
 } chunk_read_req_t;
 
 typedef struct {
-    size_t offset;    /* file offset */
-    size_t nbytes;    /* requested read size */
-    ssize_t read_rc;  /* bytes read (or negative error code) */
+    uint64_t gfid;      /* global file id */
+    size_t offset;      /* file offset */
+    size_t nbytes;      /* requested read size */
+    ssize_t read_rc;    /* bytes read (or negative error code) */
+    int log_app_id;     /* local log application id (if log_client_id >= 0) */
+    int log_client_id;  /* local log client id holding data in its
+                         * superblock, or -1 if data is in response */
+    size_t log_offset;  /* superblock offset of data (if log_client_id >= 0) */
 } chunk_read_resp_t;
 
 typedef struct {
@@ -109,7 +115,7 @@ typedef struct {
 typedef struct {
     size_t length;  /* length of data to read */
     size_t offset;  /* file offset */
-    int gfid;       /* global file id */
+    uint64_t gfid;  /* global file id */
     int errcode;    /* request completion status */
 } client_read_req_t;
 
@@ -137,6 +143,7 @@ typedef struct {
     size_t data_size;     /* size of data log in bytes */
     size_t req_buf_sz;    /* buffer size for client to issue read requests */
     size_t recv_buf_sz;   /* buffer size for read replies to client */
+    int recv_buf_slots;   /* number of slots read reply buffer is split into */
 
     /* number of clients on the node */
     int num_procs_per_node;
@@ -145,6 +152,8 @@ typedef struct {
     int client_ranks[MAX_NUM_CLIENTS]; /* map to client id */
     int thrd_idxs[MAX_NUM_CLIENTS];    /* map to thread id */
     int dbg_ranks[MAX_NUM_CLIENTS];    /* map to client rank */
+    int recv_slots[MAX_NUM_CLIENTS];   /* read reply slot being filled */
+    int fsync_rc[MAX_NUM_CLIENTS];     /* error from async fsync */
 
     /* file descriptors */
     int spill_log_fds[MAX_NUM_CLIENTS];       /* spillover data */
@@ -169,7 +178,7 @@ typedef struct {
     char external_spill_dir[UNIFYFS_MAX_FILENAME];
 } app_config_t;
 
-typedef int fattr_key_t;
+typedef uint64_t fattr_key_t;
 
 int invert_sock_ids[MAX_NUM_CLIENTS];
 
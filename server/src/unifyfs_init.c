@@ -38,6 +38,7 @@
 
 // server components
 #include "unifyfs_global.h"
+#include "unifyfs_bufpool.h"
 #include "unifyfs_metadata.h"
 #include "unifyfs_request_manager.h"
 #include "unifyfs_service_manager.h"
@@ -286,6 +287,12 @@ int main(int argc, char* argv[])
         }
     }
 
+    /* select how request managers wait on client shmem regions */
+    rc = unifyfs_shm_wait_init(&server_cfg);
+    if (rc != (int)UNIFYFS_SUCCESS) {
+        exit(1);
+    }
+
     // setup clean termination by signal
     memset(&sa, 0, sizeof(struct sigaction));
     sa.sa_handler = exit_request;
@@ -394,7 +401,15 @@ int main(int argc, char* argv[])
 
     /* launch the service manager */
     LOGDBG("launching service manager thread");
-    rc = svcmgr_init();
+    rc = svcmgr_init(&server_cfg);
+    if (rc != (int)UNIFYFS_SUCCESS) {
+        LOGERR("launch failed - %s", unifyfs_error_enum_description(rc));
+        exit(1);
+    }
+
+    /* launch the request manager workers */
+    LOGDBG("launching request manager workers");
+    rc = rm_pool_init(&server_cfg);
     if (rc != (int)UNIFYFS_SUCCESS) {
         LOGERR("launch failed - %s", unifyfs_error_enum_description(rc));
         exit(1);
@@ -407,6 +422,13 @@ int main(int argc, char* argv[])
         exit(1);
     }
 
+    LOGDBG("launching fsync thread");
+    rc = rm_fsync_init();
+    if (rc != (int)UNIFYFS_SUCCESS) {
+        LOGERR("launch failed - %s", unifyfs_error_enum_description(rc));
+        exit(1);
+    }
+
     LOGDBG("finished service initialization");
 
     while (1) {
@@ -633,8 +655,8 @@ static int unifyfs_exit(void)
 
     /* TODO: notify the service threads to exit */
 
-    /* notify the request manager threads to exit*/
-    LOGDBG("stopping request manager threads");
+    /* stop request manager work for all clients */
+    LOGDBG("stopping request manager clients");
     int i, j;
     for (i = 0; i < arraylist_size(rm_thrd_list); i++) {
         /* request and wait for request manager thread exit */
@@ -642,7 +664,17 @@ static int unifyfs_exit(void)
             (reqmgr_thrd_t*) arraylist_get(rm_thrd_list, i);
         rm_cmd_exit(thrd_ctrl);
     }
+
+    /* drain remaining tasks and join the request manager workers */
+    LOGDBG("stopping request manager workers");
+    rm_pool_fini();
     arraylist_free(rm_thrd_list);
+    bufpool_fini();
+    unifyfs_shm_wait_log_stats("server");
+
+    /* publish any outstanding asynchronous fsync metadata */
+    LOGDBG("stopping fsync thread");
+    rm_fsync_fini();
 
     /* sanitize the shared memory and delete the log files
      * */
@@ -30,10 +30,10 @@
 // NOTE: following two lines needed for nftw(), MUST COME FIRST IN FILE
 #define _XOPEN_SOURCE 500
 #include <ftw.h>
+#include <time.h>
 
 // common headers
 #include "unifyfs_client_rpcs.h"
-#include "ucr_read_builder.h"
 
 // server headers
 #include "unifyfs_global.h"
@@ -52,20 +52,82 @@ struct mdhim_t* md;
 #define IDX_FILE_ATTR    (1)
 struct index_t* unifyfs_indexes[2];
 
+/* The MDHIM client is not thread safe: replies from the local range
+ * server come back through a single slot in md, and replies from
+ * remote range servers are matched by message tag only.  Request
+ * manager workers look up extents while the fsync thread publishes,
+ * so this lock serializes the MDHIM calls themselves, nothing else
+ * is done while holding it.  Lookups pass their index explicitly,
+ * puts select it through md->primary_index under the lock. */
+static pthread_mutex_t meta_lock = PTHREAD_MUTEX_INITIALIZER;
+
 size_t max_recs_per_slice;
 
+/* Extent cache: extents for a global file id are fetched with one
+ * range query and kept on this server, so repeated reads of a file
+ * skip the MDHIM round trip. Extents of laminated files never change,
+ * so those entries are pinned and hold all extents up to the laminated
+ * size. Other files are only cached when meta.extent_cache_ttl is set,
+ * and then only for the range that was read. Their entries are dropped
+ * when new extents are stored through any server (see
+ * unifyfs_invalidate_cached_extents), and expire after the ttl.
+ * Marker entries with no extents remember that a file was not
+ * laminated, which avoids repeating the attribute lookup on every read
+ * of an unlaminated file. The interval before a marker is rechecked
+ * doubles each time the file is still not laminated. */
+typedef struct {
+    uint64_t gfid;             /* global file id (hash key) */
+    int pinned;                /* file is laminated, never expires */
+    time_t expire;             /* expiration time when not pinned */
+    int recheck_secs;          /* lifetime of a marker entry */
+    int has_extents;           /* entry holds extents, not a marker */
+    size_t start;              /* first file offset covered by extents */
+    size_t end;                /* last file offset covered by extents */
+    int num_extents;           /* number of extents in list */
+    unifyfs_keyval_t* extents; /* extents sorted by offset, or NULL */
+    UT_hash_handle hh;
+} extent_cache_entry_t;
+
+typedef struct {
+    size_t hits;          /* ranges served from cache */
+    size_t misses;        /* lookups that fetched extents from MDHIM */
+    size_t bypass;        /* lookups sent to MDHIM without caching */
+    size_t invalidations; /* entries dropped due to new extents */
+} extent_cache_stats_t;
+
+/* seconds before first rechecking whether an unlaminated file
+ * has been laminated, and the limit the interval grows to */
+#define EXTENT_CACHE_RECHECK_SECS (1)
+#define EXTENT_CACHE_RECHECK_MAX_SECS (64)
+
+/* largest offset used in extent range queries */
+#define EXTENT_MAX_OFFSET ((SIZE_MAX >> 1) - 2)
+
+static extent_cache_entry_t* extent_cache;
+static pthread_mutex_t extent_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+static extent_cache_stats_t extent_cache_stats;
+static unsigned long extent_cache_gen; /* bumped on each invalidation */
+static int extent_cache_enabled;
+static long extent_cache_ttl;
+
+/* Counters bumped once new extents of a file have been stored, hashed
+ * by gfid, see unifyfs_get_extents_gen(). Files sharing a bucket just
+ * see some extra changes. */
+#define EXTENT_GEN_BUCKETS (1024)
+static unsigned long extent_gens[EXTENT_GEN_BUCKETS];
+
 void debug_log_key_val(const char* ctx,
                        unifyfs_key_t* key,
                        unifyfs_val_t* val)
 {
     if ((key != NULL) && (val != NULL)) {
-        LOGDBG("@%s - key(fid=%d, offset=%lu), "
+        LOGDBG("@%s - key(fid=%" PRIu64 ", offset=%lu), "
                "val(del=%d, len=%lu, addr=%lu, app=%d, rank=%d)",
                ctx, key->fid, key->offset,
                val->delegator_rank, val->len, val->addr,
                val->app_id, val->rank);
     } else if (key != NULL) {
-        LOGDBG("@%s - key(fid=%d, offset=%lu)",
+        LOGDBG("@%s - key(fid=%" PRIu64 ", offset=%lu)",
                ctx, key->fid, key->offset);
     }
 }
@@ -94,7 +156,7 @@ int meta_init_store(unifyfs_cfg_t* cfg)
     int rc, ratio;
     MPI_Comm comm = MPI_COMM_WORLD;
     size_t path_len;
-    long svr_ratio, range_sz;
+    long svr_ratio, range_sz, num_workers;
     struct stat ss;
     char db_path[UNIFYFS_MAX_FILENAME] = {0};
 
@@ -143,6 +205,22 @@ int meta_init_store(unifyfs_cfg_t* cfg)
     max_recs_per_slice = (size_t) range_sz;
     mdhim_options_set_max_recs_per_slice(db_opts, (uint64_t)range_sz);
 
+    /* range server work is spread over worker threads by slice */
+    num_workers = META_DEFAULT_NUM_WORKERS;
+    configurator_int_val(cfg->meta_num_workers, &num_workers);
+    mdhim_options_set_num_worker_threads(db_opts, (int) num_workers);
+
+    /* enable caching of file extents from range queries */
+    bool use_cache = true;
+    configurator_bool_val(cfg->meta_extent_cache, &use_cache);
+    extent_cache_enabled = (int) use_cache;
+
+    extent_cache_ttl = 0;
+    configurator_int_val(cfg->meta_extent_cache_ttl, &extent_cache_ttl);
+    if (extent_cache_ttl < 0) {
+        extent_cache_ttl = 0;
+    }
+
     md = mdhimInit(&comm, db_opts);
 
     /* index for storing file extent metadata */
@@ -150,7 +228,7 @@ int meta_init_store(unifyfs_cfg_t* cfg)
 
     /* index for storing file attribute metadata */
     unifyfs_indexes[IDX_FILE_ATTR] = create_global_index(md,
-        ratio, 1, LEVELDB, MDHIM_INT_KEY, "file_attr");
+        ratio, 1, LEVELDB, MDHIM_LONG_INT_KEY, "file_attr");
 
     return 0;
 }
@@ -161,13 +239,216 @@ void print_fsync_indices(unifyfs_key_t** keys,
 {
     size_t i;
     for (i = 0; i < num_entries; i++) {
-        LOGDBG("fid:%d, offset:%lu, addr:%lu, len:%lu, del_id:%d",
+        LOGDBG("fid:%" PRIu64 ", offset:%lu, addr:%lu, len:%lu, del_id:%d",
                keys[i]->fid, keys[i]->offset,
                vals[i]->addr, vals[i]->len,
                vals[i]->delegator_rank);
     }
 }
 
+/* free an extent cache entry, caller must hold extent_cache_lock */
+static void extent_cache_remove(extent_cache_entry_t* entry)
+{
+    HASH_DEL(extent_cache, entry);
+    if (NULL != entry->extents) {
+        free(entry->extents);
+    }
+    free(entry);
+}
+
+/* find the cache entry for the given file, ignoring it if expired
+ * (expired entries are replaced by the next fill), caller must hold
+ * extent_cache_lock */
+static extent_cache_entry_t* extent_cache_find(uint64_t gfid)
+{
+    extent_cache_entry_t* entry = NULL;
+    HASH_FIND(hh, extent_cache, &gfid, sizeof(uint64_t), entry);
+    if ((NULL != entry) && !entry->pinned) {
+        if (time(NULL) >= entry->expire) {
+            entry = NULL;
+        }
+    }
+    return entry;
+}
+
+/* drop any cached extents for the given file */
+static void extent_cache_invalidate(uint64_t gfid)
+{
+    pthread_mutex_lock(&extent_cache_lock);
+    extent_cache_gen++;
+    extent_cache_entry_t* entry = NULL;
+    HASH_FIND(hh, extent_cache, &gfid, sizeof(uint64_t), entry);
+    if (NULL != entry) {
+        extent_cache_remove(entry);
+        extent_cache_stats.invalidations++;
+    }
+    pthread_mutex_unlock(&extent_cache_lock);
+}
+
+/* pin cached extents once we learn a file has been laminated */
+static void extent_cache_laminate(uint64_t gfid)
+{
+    pthread_mutex_lock(&extent_cache_lock);
+    extent_cache_entry_t* entry = NULL;
+    HASH_FIND(hh, extent_cache, &gfid, sizeof(uint64_t), entry);
+    if (NULL != entry) {
+        if (!entry->has_extents || (entry->start != 0) ||
+            (entry->end != EXTENT_MAX_OFFSET)) {
+            /* drop marker or partial range so next lookup
+             * caches all the extents */
+            extent_cache_remove(entry);
+        } else {
+            entry->pinned = 1;
+        }
+    }
+    pthread_mutex_unlock(&extent_cache_lock);
+}
+
+/* insert a new entry, replacing any existing entry for the file,
+ * the entry (and its extents) is owned by the cache after this call.
+ * The entry is discarded if any extents were invalidated since gen
+ * was read. */
+static void extent_cache_insert(extent_cache_entry_t* entry,
+                                unsigned long gen)
+{
+    pthread_mutex_lock(&extent_cache_lock);
+    if (gen != extent_cache_gen) {
+        /* lost a race with an fsync */
+        pthread_mutex_unlock(&extent_cache_lock);
+        if (NULL != entry->extents) {
+            free(entry->extents);
+        }
+        free(entry);
+        return;
+    }
+    extent_cache_entry_t* old = NULL;
+    HASH_FIND(hh, extent_cache, &(entry->gfid), sizeof(uint64_t), old);
+    if (NULL != old) {
+        /* expired, a marker, or a different range */
+        extent_cache_remove(old);
+    }
+    HASH_ADD(hh, extent_cache, gfid, sizeof(uint64_t), entry);
+    pthread_mutex_unlock(&extent_cache_lock);
+}
+
+/* free all cached extents and log cache statistics */
+static void extent_cache_clear(void)
+{
+    extent_cache_entry_t* entry;
+    extent_cache_entry_t* tmp;
+
+    pthread_mutex_lock(&extent_cache_lock);
+    LOGDBG("extent cache - hits=%zu misses=%zu bypass=%zu invalidations=%zu",
+           extent_cache_stats.hits, extent_cache_stats.misses,
+           extent_cache_stats.bypass, extent_cache_stats.invalidations);
+    HASH_ITER(hh, extent_cache, entry, tmp) {
+        extent_cache_remove(entry);
+    }
+    pthread_mutex_unlock(&extent_cache_lock);
+}
+
+/* sort keyvals by logical file offset */
+static int compare_kv_offset(const void* a, const void* b)
+{
+    const unifyfs_keyval_t* kva = a;
+    const unifyfs_keyval_t* kvb = b;
+    return unifyfs_key_compare((unifyfs_key_t*)&(kva->key),
+                               (unifyfs_key_t*)&(kvb->key));
+}
+
+/* append a copy of kv to the growable list in kvs */
+static int append_kv(unifyfs_keyval_t** kvs, size_t* count, size_t* cap,
+                     unifyfs_keyval_t* kv)
+{
+    if (*count == *cap) {
+        size_t new_cap = (*cap == 0) ? 64 : (*cap * 2);
+        unifyfs_keyval_t* new_kvs = realloc(*kvs,
+            new_cap * sizeof(unifyfs_keyval_t));
+        if (NULL == new_kvs) {
+            return (int)UNIFYFS_ERROR_NOMEM;
+        }
+        *kvs = new_kvs;
+        *cap = new_cap;
+    }
+    (*kvs)[*count] = *kv;
+    (*count)++;
+    return UNIFYFS_SUCCESS;
+}
+
+/* append the slice [start, end] of an extent to the output list */
+static int append_slice(unifyfs_keyval_t** kvs, size_t* count, size_t* cap,
+                        unifyfs_keyval_t* ext, size_t start, size_t end)
+{
+    unifyfs_keyval_t kv = *ext;
+    size_t ext_end = ext->key.offset + ext->val.len - 1;
+    if (start > ext->key.offset) {
+        kv.key.offset = start;
+        kv.val.addr  += start - ext->key.offset;
+    }
+    if (end > ext_end) {
+        end = ext_end;
+    }
+    kv.val.len = end - kv.key.offset + 1;
+    return append_kv(kvs, count, cap, &kv);
+}
+
+/* given a list of extents sorted by offset, append the pieces that
+ * cover [start, end] to the output list, following the semantics of
+ * the MDHIM range query (see leveldb_process_range) */
+static int extent_list_range(unifyfs_keyval_t* exts, int num,
+                             size_t start, size_t end,
+                             unifyfs_keyval_t** kvs,
+                             size_t* count, size_t* cap)
+{
+    int rc;
+
+    if (num == 0) {
+        return UNIFYFS_SUCCESS;
+    }
+
+    /* binary search for first extent with offset >= start */
+    int lo = 0;
+    int hi = num;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (exts[mid].key.offset < start) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    /* include tail of preceding extent if it overlaps start */
+    if ((lo > 0) && !((lo < num) && (exts[lo].key.offset == start))) {
+        unifyfs_keyval_t* prev = &exts[lo - 1];
+        size_t prev_end = prev->key.offset + prev->val.len - 1;
+        if (start <= prev_end) {
+            rc = append_slice(kvs, count, cap, prev, start, end);
+            if ((rc != UNIFYFS_SUCCESS) || (end <= prev_end)) {
+                return rc;
+            }
+        }
+    }
+
+    /* add following extents until we pass end */
+    int i;
+    for (i = lo; i < num; i++) {
+        unifyfs_keyval_t* ext = &exts[i];
+        if (ext->key.offset > end) {
+            break;
+        }
+        rc = append_slice(kvs, count, cap, ext, ext->key.offset, end);
+        if (rc != UNIFYFS_SUCCESS) {
+            return rc;
+        }
+        if ((ext->key.offset + ext->val.len - 1) >= end) {
+            break;
+        }
+    }
+
+    return UNIFYFS_SUCCESS;
+}
+
 static int remove_cb(const char* fpath, const struct stat* sb,
                      int typeflag, struct FTW* ftwbuf)
 {
@@ -190,6 +471,8 @@ int meta_sanitize(void)
     int rc;
     char db_path[UNIFYFS_MAX_FILENAME] = {0};
 
+    extent_cache_clear();
+
     // capture db_path before closing MDHIM
     snprintf(db_path, sizeof(db_path), "%s", md->db_opts->db_path);
 
@@ -214,20 +497,26 @@ int unifyfs_set_file_attribute(unifyfs_file_attr_t* fattr_ptr)
     int rc = UNIFYFS_SUCCESS;
 
     /* select index for file attributes */
+    pthread_mutex_lock(&meta_lock);
     md->primary_index = unifyfs_indexes[IDX_FILE_ATTR];
 
     /* insert file attribute for given global file id */
-    int gfid = fattr_ptr->gfid;
+    fattr_key_t gfid = fattr_ptr->gfid;
     struct mdhim_brm_t* brm = mdhimPut(md,
-        &gfid, sizeof(int),
+        &gfid, sizeof(fattr_key_t),
         fattr_ptr, sizeof(unifyfs_file_attr_t),
         NULL, NULL);
+    pthread_mutex_unlock(&meta_lock);
 
     if (!brm || brm->error) {
         LOGERR("Error inserting file attribute into MDHIM");
         rc = (int)UNIFYFS_ERROR_MDHIM;
     }
 
+    if ((rc == UNIFYFS_SUCCESS) && fattr_ptr->is_laminated) {
+        extent_cache_laminate(gfid);
+    }
+
     if (brm) {
         mdhim_full_release_msg(brm);
     }
@@ -245,6 +534,7 @@ int unifyfs_set_file_attributes(int num_entries,
     int rc = UNIFYFS_SUCCESS;
 
     /* select index for file attributes */
+    pthread_mutex_lock(&meta_lock);
     md->primary_index = unifyfs_indexes[IDX_FILE_ATTR];
 
     /* put list of key/value pairs */
@@ -252,6 +542,7 @@ int unifyfs_set_file_attributes(int num_entries,
         (void**)keys, key_lens,
         (void**)fattr_ptr, val_lens,
         num_entries, NULL, NULL);
+    pthread_mutex_unlock(&meta_lock);
 
     /* check for errors and free resources */
     if (!brm) {
@@ -277,21 +568,33 @@ int unifyfs_set_file_attributes(int num_entries,
         }
     }
 
+    /* pin cached extents for any newly laminated files */
+    if (rc == UNIFYFS_SUCCESS) {
+        int i;
+        for (i = 0; i < num_entries; i++) {
+            if (fattr_ptr[i]->is_laminated) {
+                extent_cache_laminate(fattr_ptr[i]->gfid);
+            }
+        }
+    }
+
     return rc;
 }
 
 /* given a global file id, lookup and return file attributes */
 int unifyfs_get_file_attribute(
-    int gfid,
+    uint64_t gfid,
     unifyfs_file_attr_t* attr)
 {
     int rc = UNIFYFS_SUCCESS;
 
     /* select index holding file attributes,
      * execute lookup for given file id */
-    md->primary_index = unifyfs_indexes[IDX_FILE_ATTR];
-    struct mdhim_bgetrm_t* bgrm = mdhimGet(md, md->primary_index,
-        &gfid, sizeof(int), MDHIM_GET_EQ);
+    pthread_mutex_lock(&meta_lock);
+    struct mdhim_bgetrm_t* bgrm = mdhimGet(md,
+        unifyfs_indexes[IDX_FILE_ATTR],
+        &gfid, sizeof(fattr_key_t), MDHIM_GET_EQ);
+    pthread_mutex_unlock(&meta_lock);
 
     if (!bgrm || bgrm->error) {
         /* failed to find info for this file id */
@@ -310,12 +613,10 @@ int unifyfs_get_file_attribute(
     return rc;
 }
 
-/*
- *
- */
-int unifyfs_get_file_extents(int num_keys, unifyfs_key_t** keys,
-                             int* key_lens, int* num_values,
-                             unifyfs_keyval_t** keyvals)
+/* execute range query for file extents in MDHIM */
+static int mdhim_get_file_extents(int num_keys, unifyfs_key_t** keys,
+                                  int* key_lens, int* num_values,
+                                  unifyfs_keyval_t** keyvals)
 {
     /*
      * This is using a modified version of mdhim. The function will return all
@@ -328,12 +629,12 @@ int unifyfs_get_file_extents(int num_keys, unifyfs_key_t** keys,
     *num_values = 0;
     *keyvals = NULL;
 
-    /* select index for file extents */
-    md->primary_index = unifyfs_indexes[IDX_FILE_EXTENTS];
-
-    /* execute range query */
-    struct mdhim_bgetrm_t* bkvlist = mdhimBGet(md, md->primary_index,
+    /* execute range query on index for file extents */
+    pthread_mutex_lock(&meta_lock);
+    struct mdhim_bgetrm_t* bkvlist = mdhimBGet(md,
+        unifyfs_indexes[IDX_FILE_EXTENTS],
         (void**)keys, key_lens, num_keys, MDHIM_RANGE_BGET);
+    pthread_mutex_unlock(&meta_lock);
 
     /* iterate over each item in list, check for errors
      * and sum up total number of key/value pairs we got back */
@@ -396,6 +697,188 @@ int unifyfs_get_file_extents(int num_keys, unifyfs_key_t** keys,
     return rc;
 }
 
+/* look up whether a file is laminated, and if it is fetch and cache
+ * all of its extents, or if unlaminated files may be cached fetch and
+ * cache those in [start, end] */
+static void extent_cache_fill(uint64_t gfid, size_t start, size_t end)
+{
+    /* read generation before any lookups, so that an fsync
+     * racing with us prevents caching stale extents, and back off
+     * the recheck of a file we found unlaminated before */
+    int recheck_secs = EXTENT_CACHE_RECHECK_SECS;
+    pthread_mutex_lock(&extent_cache_lock);
+    unsigned long gen = extent_cache_gen;
+    extent_cache_entry_t* old = NULL;
+    HASH_FIND(hh, extent_cache, &gfid, sizeof(uint64_t), old);
+    if ((NULL != old) && !old->has_extents) {
+        recheck_secs = 2 * old->recheck_secs;
+        if (recheck_secs > EXTENT_CACHE_RECHECK_MAX_SECS) {
+            recheck_secs = EXTENT_CACHE_RECHECK_MAX_SECS;
+        }
+    }
+    pthread_mutex_unlock(&extent_cache_lock);
+
+    int laminated = 0;
+    unifyfs_file_attr_t attr;
+    int rc = unifyfs_get_file_attribute(gfid, &attr);
+    if ((rc == UNIFYFS_SUCCESS) && attr.is_laminated) {
+        laminated = 1;
+    }
+
+    extent_cache_entry_t* entry = calloc(1, sizeof(extent_cache_entry_t));
+    if (NULL == entry) {
+        return;
+    }
+    entry->gfid = gfid;
+
+    time_t now = time(NULL);
+    if (!laminated && (extent_cache_ttl == 0)) {
+        /* remember this file is not laminated for a while */
+        entry->recheck_secs = recheck_secs;
+        entry->expire = now + recheck_secs;
+        extent_cache_insert(entry, gen);
+        return;
+    }
+
+    if (laminated) {
+        /* all extents of a laminated file lie within its size */
+        entry->pinned = 1;
+        entry->start = 0;
+        entry->end = EXTENT_MAX_OFFSET;
+        start = 0;
+        end = (attr.size > 0) ? (size_t)(attr.size - 1) : 0;
+        if (end > EXTENT_MAX_OFFSET) {
+            end = EXTENT_MAX_OFFSET;
+        }
+    } else {
+        entry->expire = now + extent_cache_ttl;
+        entry->start = start;
+        entry->end = end;
+    }
+    entry->has_extents = 1;
+
+    int num_vals = 0;
+    unifyfs_keyval_t* kvs = NULL;
+    if (!laminated || (attr.size > 0)) {
+        /* request extents of this file in [start, end] */
+        unifyfs_key_t key1, key2;
+        key1.fid    = gfid;
+        key1.offset = start;
+        key2.fid    = gfid;
+        key2.offset = end;
+
+        unifyfs_key_t* range_keys[2] = {&key1, &key2};
+        int range_key_lens[2] = {sizeof(unifyfs_key_t),
+                                 sizeof(unifyfs_key_t)};
+
+        rc = mdhim_get_file_extents(2, range_keys, range_key_lens,
+                                    &num_vals, &kvs);
+        if (rc != UNIFYFS_SUCCESS) {
+            free(entry);
+            return;
+        }
+    }
+
+    if (num_vals > 1) {
+        qsort(kvs, (size_t)num_vals, sizeof(unifyfs_keyval_t),
+              compare_kv_offset);
+    }
+    entry->num_extents = num_vals;
+    entry->extents = kvs;
+
+    extent_cache_insert(entry, gen);
+}
+
+/* serve the range [start, end] of a file from the extent cache,
+ * returns 1 on a hit, 0 if the range must be looked up in MDHIM,
+ * or a negative value on error */
+static int extent_cache_lookup(uint64_t gfid, size_t start, size_t end,
+                               unifyfs_keyval_t** kvs,
+                               size_t* count, size_t* cap)
+{
+    int attempt;
+    for (attempt = 0; attempt < 2; attempt++) {
+        pthread_mutex_lock(&extent_cache_lock);
+        extent_cache_entry_t* entry = extent_cache_find(gfid);
+        if ((NULL != entry) && entry->has_extents &&
+            ((start < entry->start) || (end > entry->end))) {
+            /* cached range does not cover this one */
+            entry = NULL;
+        }
+        if (NULL != entry) {
+            int ret = 0;
+            if (entry->has_extents) {
+                int rc = extent_list_range(entry->extents,
+                                           entry->num_extents,
+                                           start, end, kvs, count, cap);
+                ret = (rc == UNIFYFS_SUCCESS) ? 1 : -1;
+                extent_cache_stats.hits++;
+            } else {
+                extent_cache_stats.bypass++;
+            }
+            pthread_mutex_unlock(&extent_cache_lock);
+            return ret;
+        }
+        if (attempt == 0) {
+            extent_cache_stats.misses++;
+        }
+        pthread_mutex_unlock(&extent_cache_lock);
+
+        if (attempt == 0) {
+            extent_cache_fill(gfid, start, end);
+        }
+    }
+
+    /* could not cache this file (e.g., lost a race with an fsync) */
+    return 0;
+}
+
+/*
+ *
+ */
+int unifyfs_get_file_extents(int num_keys, unifyfs_key_t** keys,
+                             int* key_lens, int* num_values,
+                             unifyfs_keyval_t** keyvals)
+{
+    /* keys come in (start, end) pairs for each range */
+    if (!extent_cache_enabled || (num_keys % 2)) {
+        return mdhim_get_file_extents(num_keys, keys, key_lens,
+                                      num_values, keyvals);
+    }
+
+    /* initialize output values */
+    *num_values = 0;
+    *keyvals = NULL;
+
+    size_t count = 0;
+    size_t cap = 0;
+    unifyfs_keyval_t* kvs = NULL;
+
+    int i;
+    for (i = 0; i < num_keys; i += 2) {
+        int ret = extent_cache_lookup(keys[i]->fid,
+                                      keys[i]->offset, keys[i + 1]->offset,
+                                      &kvs, &count, &cap);
+        if (ret != 1) {
+            /* fall back to querying MDHIM for the full set of ranges */
+            if (NULL != kvs) {
+                free(kvs);
+            }
+            if (ret < 0) {
+                LOGERR("failed to allocate keyvals");
+                return (int)UNIFYFS_ERROR_NOMEM;
+            }
+            return mdhim_get_file_extents(num_keys, keys, key_lens,
+                                          num_values, keyvals);
+        }
+    }
+
+    *num_values = (int) count;
+    *keyvals = kvs;
+
+    return UNIFYFS_SUCCESS;
+}
+
 /*
  *
  */
@@ -404,8 +887,10 @@ int unifyfs_set_file_extents(int num_entries,
                              unifyfs_val_t** vals, int* val_lens)
 {
     int rc = UNIFYFS_SUCCESS;
+    int i;
 
     /* select index for file extents */
+    pthread_mutex_lock(&meta_lock);
     md->primary_index = unifyfs_indexes[IDX_FILE_EXTENTS];
 
     /* put list of key/value pairs */
@@ -413,6 +898,7 @@ int unifyfs_set_file_extents(int num_entries,
         (void**)(keys), key_lens,
         (void**)(vals), val_lens,
         num_entries, NULL, NULL);
+    pthread_mutex_unlock(&meta_lock);
 
     /* check for errors and free resources */
     if (!brm) {
@@ -438,6 +924,35 @@ int unifyfs_set_file_extents(int num_entries,
         }
     }
 
+    /* the new extents are visible now (even if only some of them
+     * went in), so cached extents and data read using the old ones
+     * are stale. A lookup that started before the put cannot cache
+     * its result, since invalidating bumps the cache generation. */
+    for (i = 0; i < num_entries; i++) {
+        if ((i == 0) || (keys[i]->fid != keys[i - 1]->fid)) {
+            extent_cache_invalidate(keys[i]->fid);
+            __atomic_add_fetch(
+                extent_gens + (keys[i]->fid % EXTENT_GEN_BUCKETS),
+                1, __ATOMIC_RELEASE);
+        }
+    }
+
     return rc;
 }
 
+void unifyfs_invalidate_cached_extents(uint64_t gfid)
+{
+    extent_cache_invalidate(gfid);
+}
+
+int unifyfs_caches_unlaminated_extents(void)
+{
+    return (extent_cache_enabled && (extent_cache_ttl > 0));
+}
+
+unsigned long unifyfs_get_extents_gen(uint64_t gfid)
+{
+    return __atomic_load_n(extent_gens + (gfid % EXTENT_GEN_BUCKETS),
+                           __ATOMIC_ACQUIRE);
+}
+
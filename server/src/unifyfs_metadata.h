@@ -40,7 +40,7 @@
  */
 typedef struct {
     /** global file id */
-    int fid;
+    uint64_t fid;
     /** logical file offset */
     size_t offset;
 } unifyfs_key_t;
@@ -90,7 +90,7 @@ void print_fsync_indices(unifyfs_key_t** unifyfs_keys,
  * @param[out] *ptr_attr_val
  * @return UNIFYFS_SUCCESS on success
  */
-int unifyfs_get_file_attribute(int gfid,
+int unifyfs_get_file_attribute(uint64_t gfid,
                                unifyfs_file_attr_t* ptr_attr_val);
 
 /**
@@ -142,4 +142,32 @@ int unifyfs_set_file_extents(int num_entries, unifyfs_key_t** keys,
                              int* key_lens, unifyfs_val_t** vals,
                              int* val_lens);
 
+/**
+ * Get the publication counter of the extents of a file. The counter
+ * changes once new extents of the file have been stored through this
+ * server, so data cached from an earlier extent lookup is stale when
+ * the counter read before that lookup no longer matches.
+ *
+ * @param[in] gfid global file id
+ * @return current counter value
+ */
+unsigned long unifyfs_get_extents_gen(uint64_t gfid);
+
+/**
+ * Drop any extents of a file cached by this server, used when new
+ * extents of the file have been stored through another server.
+ *
+ * @param[in] gfid global file id
+ */
+void unifyfs_invalidate_cached_extents(uint64_t gfid);
+
+/**
+ * Returns whether this server caches extents of files that have not
+ * been laminated (meta.extent_cache_ttl is set), in which case other
+ * servers must tell it about new extents.
+ *
+ * @return 1 if extents of unlaminated files are cached, 0 otherwise
+ */
+int unifyfs_caches_unlaminated_extents(void);
+
 #endif
@@ -37,6 +37,7 @@
 // general support
 #include "unifyfs_global.h"
 #include "unifyfs_log.h"
+#include "unifyfs_bufpool.h"
 
 // server components
 #include "unifyfs_request_manager.h"
@@ -46,7 +47,6 @@
 // margo rpcs
 #include "unifyfs_server_rpcs.h"
 #include "margo_server.h"
-#include "ucr_read_builder.h"
 
 
 #define RM_LOCK(rm) \
@@ -63,107 +63,204 @@ do { \
 
 arraylist_t* rm_thrd_list;
 
-/* One request manager thread is created for each client that a
- * delegator serves.  The main thread of the delegator assigns
- * work to the request manager thread to retrieve data and send
- * it back to the client.
+/* A request manager state structure is created for each client that
+ * a delegator serves, and a fixed pool of worker threads is shared
+ * by all clients to retrieve data and send it back to the clients.
  *
- * To start, given a read request from the client (via rpc)
- * the handler function on the main delegator first queries the
+ * To start, a read request from the client (posted to the request
+ * ring in its shared memory, see rm_ring_poll_client) is taken by
+ * the ring poller thread and handed to a worker, which queries the
  * key/value store using the given file id and byte range to obtain
  * the meta data on the physical location of the file data.  This
  * meta data provides the host delegator rank, the app/client
  * ids that specify the log file on the remote delegator, the
  * offset within the log file and the length of data.  The rpc
  * handler function sorts the meta data by host delegator rank,
- * generates read requests, and inserts those into a list on a
- * data structure shared with the request manager (del_req_set).
+ * generates read requests, and records those in the client state.
  *
- * The request manager thread coordinates with the main thread
- * using a lock and a condition variable to protect the shared data
- * structure and impose flow control.  When assigned work, the
- * request manager thread packs and sends request messages to
- * service manager threads on remote delegators via MPI send.
- * It waits for data to be sent back, and unpacks the read replies
- * in each message into a shared memory buffer for the client.
- * When the shared memory is full or all data has been received,
- * it signals the client process to process the read replies.
- * It iterates with the client until all incoming read replies
- * have been transferred. */
-/* create a request manager thread for the given app_id
- * and client_id, returns pointer to thread control structure
- * on success and NULL on failure */
-
-/* Create Request Manager thread for application client */
+ * For each remote delegator of a read request, the rpc handler
+ * then submits a task to the worker pool that packs and sends the
+ * request message to the service manager on that delegator.  When
+ * the data is sent back, the rpc handler posts the responses and
+ * submits another task that unpacks the read replies into a shared
+ * memory buffer for the client.  When the shared memory is full or
+ * all data has been received, the worker signals the client process
+ * to process the read replies.  It iterates with the client until
+ * all incoming read replies have been transferred.  Response tasks
+ * of one client are serialized, since they share the client receive
+ * slots: a worker that takes one while another worker runs one for
+ * the same client chains it behind the running one instead of
+ * blocking, see rm_run_shm_tasks.
+ *
+ * Each worker has its own deque of tasks.  A worker pushes and pops
+ * tasks at the tail of its own deque, so tasks it creates itself
+ * (e.g., responses to local chunk reads) are handled while their
+ * data is still warm, and idle workers steal from the head of the
+ * deques of other workers.  Tasks submitted by other threads (rpc
+ * handlers) are distributed to the deques in round-robin order. */
+
+typedef enum {
+    RM_TASK_SEND_CHUNKS = 0,  /* send chunk read requests to a delegator */
+    RM_TASK_CHUNK_RESPONSES,  /* copy chunk read responses to client */
+    RM_TASK_PREFETCH,         /* start chunk reads for a read-ahead window */
+    RM_TASK_READAHEAD,        /* copy read-ahead window data to client */
+    RM_TASK_RING_READ         /* start a read operation from request ring */
+} rm_task_type_e;
+
+/* unit of work for request manager worker threads */
+typedef struct rm_task {
+    rm_task_type_e type;
+    reqmgr_thrd_t* thrd_ctrl; /* client request manager state */
+    int req_ndx;              /* index in client read_reqs array */
+    int remote_ndx;           /* index in read request remote_reads array */
+    client_read_req_t* reqs;  /* extents of ring read operation */
+    size_t num_reqs;          /* number of extents in reqs */
+    uint64_t ring_op;         /* sequence number of ring read operation */
+    int ring_rc;              /* error while taking ring read operation */
+    struct rm_task* prev;
+    struct rm_task* next;
+} rm_task_t;
+
+/* task deque of one worker thread */
+typedef struct {
+    pthread_mutex_t lock;
+    rm_task_t* head;
+    rm_task_t* tail;
+} rm_deque_t;
+
+typedef struct {
+    pthread_t* thrds;
+    rm_deque_t* deques;
+    int num_deques;
+    int num_workers;
+
+    /* lock and condition variable for idle workers */
+    pthread_mutex_t sync;
+    pthread_cond_t cond;
+
+    /* number of tasks in all deques, protected by sync */
+    int num_tasks;
+
+    /* next deque for tasks submitted by non-worker threads,
+     * protected by sync */
+    int next_deque;
+
+    /* flag set to indicate worker threads should exit */
+    int exit_flag;
+} rm_pool_t;
+
+static rm_pool_t rm_pool;
+
+/* index of worker within pool for worker threads, -1 otherwise */
+static __thread int rm_worker_ndx = -1;
+
+/* When a client reads a file sequentially with single-extent reads,
+ * the data following its reads is prefetched into read-ahead windows
+ * held in the client state.  Prefetch requests are read requests that
+ * run through the usual chunk read pipeline, except their responses
+ * are stored in the window instead of the client receive slots.  A
+ * read that falls entirely within prefetched data is then copied to
+ * the client from the window by a worker, without a metadata lookup
+ * or any remote chunk reads.  The next window is started once the
+ * data left ahead of the reads drops below half a window, so it
+ * is usually in place before the client gets to it.
+ *
+ * Only laminated files are prefetched. Extents of other files may be
+ * added through any server at any time, and this server would not
+ * learn that its windows are stale. */
+
+/* size of read-ahead windows, 0 disables read-ahead */
+static size_t rm_readahead_size = UNIFYFS_READAHEAD_SIZE;
+
+/* state of the thread that polls the read request rings of all
+ * clients, the lock protects rm_thrd_list and the ring fields of
+ * the client states, it is only held while descriptors are copied
+ * out of the rings, the reads themselves are run by the workers.
+ * The poller blocks on the doorbell region (bell) while clients
+ * are idle, its id is handed to clients at mount. */
+typedef struct {
+    pthread_t thrd;
+    pthread_mutex_t sync;
+    int started;
+    int exit_flag;
+    shm_header_t* bell;
+    int bell_id;
+    char bell_name[GEN_STR_LEN];
+} rm_ring_poller_t;
+
+static rm_ring_poller_t rm_ring = {
+    .sync = PTHREAD_MUTEX_INITIALIZER,
+    .bell_id = -1,
+};
+
+/* read-ahead counters, logged when the worker pool stops */
+static uint64_t rm_ra_hits;       /* sequential reads served from windows */
+static uint64_t rm_ra_misses;     /* sequential reads not in a window */
+static uint64_t rm_ra_prefetches; /* read-ahead windows started */
+
+/* Create Request Manager state for application client,
+ * returns pointer to state structure on success and
+ * NULL on failure */
 reqmgr_thrd_t* unifyfs_rm_thrd_create(int app_id, int client_id)
 {
-    /* allocate a new thread control structure */
+    /* allocate a new state structure */
     reqmgr_thrd_t* thrd_ctrl = (reqmgr_thrd_t*)
         calloc(1, sizeof(reqmgr_thrd_t));
     if (thrd_ctrl == NULL) {
         LOGERR("Failed to allocate structure for request "
-               "manager thread for app_id=%d client_id=%d",
+               "manager state for app_id=%d client_id=%d",
                app_id, client_id);
         return NULL;
     }
 
     /* initialize lock for shared data structures between
-     * main thread and request delegator thread */
+     * rpc handlers and request manager workers */
     pthread_mutexattr_t attr;
     pthread_mutexattr_init(&attr);
     pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
     int rc = pthread_mutex_init(&(thrd_ctrl->thrd_lock), &attr);
     if (rc != 0) {
         LOGERR("pthread_mutex_init failed for request "
-               "manager thread app_id=%d client_id=%d rc=%d (%s)",
-               app_id, client_id, rc, strerror(rc));
-        free(thrd_ctrl);
-        return NULL;
-    }
-
-    /* initailize condition variable to flow control
-     * work between main thread and request delegator thread */
-    rc = pthread_cond_init(&(thrd_ctrl->thrd_cond), NULL);
-    if (rc != 0) {
-        LOGERR("pthread_cond_init failed for request "
-               "manager thread app_id=%d client_id=%d rc=%d (%s)",
+               "manager state app_id=%d client_id=%d rc=%d (%s)",
                app_id, client_id, rc, strerror(rc));
-        pthread_mutex_destroy(&(thrd_ctrl->thrd_lock));
         free(thrd_ctrl);
         return NULL;
     }
+    pthread_mutex_init(&(thrd_ctrl->shm_lock), NULL);
+    pthread_mutex_init(&(thrd_ctrl->task_lock), NULL);
+    pthread_cond_init(&(thrd_ctrl->task_cond), NULL);
+    thrd_ctrl->num_tasks = 0;
 
-    /* record app and client id this thread will be serving */
+    /* record app and client id this state will be serving */
     thrd_ctrl->app_id    = app_id;
     thrd_ctrl->client_id = client_id;
+    thrd_ctrl->exit_flag = 0;
 
-    /* initialize flow control flags */
-    thrd_ctrl->exit_flag              = 0;
-    thrd_ctrl->exited                 = 0;
-    thrd_ctrl->has_waiting_delegator  = 0;
-    thrd_ctrl->has_waiting_dispatcher = 0;
+    /* poll the read request ring in the request region of the client */
+    app_config_t* app_config =
+        (app_config_t*)arraylist_get(app_config_list, app_id);
+    if ((NULL != app_config) &&
+        (NULL != app_config->shm_req_bufs[client_id])) {
+        thrd_ctrl->req_ring =
+            (shm_req_ring_t*) app_config->shm_req_bufs[client_id];
+        thrd_ctrl->ring_cap =
+            unifyfs_shm_req_ring_capacity(app_config->req_buf_sz);
+    }
+    thrd_ctrl->ring_rc = (int)UNIFYFS_SUCCESS;
 
-    /* insert our thread control structure into our list of
-     * active request manager threads, important to do this before
-     * launching thread since it uses list to lookup its structure */
+    /* insert our state structure into our list of active clients,
+     * which the ring poller walks */
+    pthread_mutex_lock(&(rm_ring.sync));
     rc = arraylist_add(rm_thrd_list, thrd_ctrl);
-    if (rc != 0) {
-        pthread_cond_destroy(&(thrd_ctrl->thrd_cond));
-        pthread_mutex_destroy(&(thrd_ctrl->thrd_lock));
-        free(thrd_ctrl);
-        return NULL;
+    if (rc == 0) {
+        thrd_ctrl->thrd_ndx = arraylist_size(rm_thrd_list) - 1;
     }
-    thrd_ctrl->thrd_ndx = arraylist_size(rm_thrd_list) - 1;
-
-    /* launch request manager thread */
-    rc = pthread_create(&(thrd_ctrl->thrd), NULL,
-                        rm_delegate_request_thread, (void*)thrd_ctrl);
+    pthread_mutex_unlock(&(rm_ring.sync));
     if (rc != 0) {
-        LOGERR("failed to create request manager thread for "
-               "app_id=%d client_id=%d - rc=%d (%s)",
-               app_id, client_id, rc, strerror(rc));
-        pthread_cond_destroy(&(thrd_ctrl->thrd_cond));
         pthread_mutex_destroy(&(thrd_ctrl->thrd_lock));
+        pthread_mutex_destroy(&(thrd_ctrl->shm_lock));
+        pthread_mutex_destroy(&(thrd_ctrl->task_lock));
+        pthread_cond_destroy(&(thrd_ctrl->task_cond));
         free(thrd_ctrl);
         return NULL;
     }
@@ -183,8 +280,8 @@ static int compare_kv_gfid_rank(const void* a, const void* b)
     const unifyfs_keyval_t* kv_a = a;
     const unifyfs_keyval_t* kv_b = b;
 
-    int gfid_a = kv_a->key.fid;
-    int gfid_b = kv_b->key.fid;
+    uint64_t gfid_a = kv_a->key.fid;
+    uint64_t gfid_b = kv_b->key.fid;
     if (gfid_a == gfid_b) {
         int rank_a = kv_a->val.delegator_rank;
         int rank_b = kv_b->val.delegator_rank;
@@ -202,6 +299,45 @@ static int compare_kv_gfid_rank(const void* a, const void* b)
     }
 }
 
+/* order keyvals by host delegator rank, then gfid */
+static int compare_kv_rank_gfid(const void* a, const void* b)
+{
+    const unifyfs_keyval_t* kv_a = a;
+    const unifyfs_keyval_t* kv_b = b;
+
+    int rank_a = kv_a->val.delegator_rank;
+    int rank_b = kv_b->val.delegator_rank;
+    if (rank_a != rank_b) {
+        return (rank_a < rank_b) ? -1 : 1;
+    }
+    uint64_t gfid_a = kv_a->key.fid;
+    uint64_t gfid_b = kv_b->key.fid;
+    if (gfid_a != gfid_b) {
+        return (gfid_a < gfid_b) ? -1 : 1;
+    }
+    return 0;
+}
+
+/* return whether keyvals sorted by gfid contain the given gfid */
+static int bsearch_kv_gfid(unifyfs_keyval_t* keyvals, int num_vals,
+                           uint64_t gfid)
+{
+    int lo = 0;
+    int hi = num_vals - 1;
+    while (lo <= hi) {
+        int mid = lo + ((hi - lo) / 2);
+        uint64_t mid_gfid = keyvals[mid].key.fid;
+        if (mid_gfid == gfid) {
+            return 1;
+        } else if (mid_gfid < gfid) {
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return 0;
+}
+
 unifyfs_key_t** alloc_key_array(int elems)
 {
     int size = elems * (sizeof(unifyfs_key_t*) + sizeof(unifyfs_key_t));
@@ -268,7 +404,7 @@ void free_attr_key_array(fattr_key_t** array)
 static void debug_print_read_req(server_read_req_t* req)
 {
     if (NULL != req) {
-        LOGDBG("server_read_req[%d] status=%d, gfid=%d, num_remote=%d",
+        LOGDBG("server_read_req[%d] status=%d, gfid=%" PRIu64 ", num_remote=%d",
                req->req_ndx, req->status, req->extent.gfid,
                req->num_remote_reads);
     }
@@ -314,10 +450,13 @@ static int release_read_req(reqmgr_thrd_t* thrd_ctrl,
             thrd_ctrl->next_rdreq_ndx--;
         }
         if (NULL != rdreq->chunks) {
-            free(rdreq->chunks);
+            bufpool_free(rdreq->chunks);
         }
         if (NULL != rdreq->remote_reads) {
-            free(rdreq->remote_reads);
+            bufpool_free(rdreq->remote_reads);
+        }
+        if (NULL != rdreq->failed_reads) {
+            free(rdreq->failed_reads);
         }
         memset((void*)rdreq, 0, sizeof(server_read_req_t));
         thrd_ctrl->num_read_reqs--;
@@ -332,38 +471,152 @@ static int release_read_req(reqmgr_thrd_t* thrd_ctrl,
     return rc;
 }
 
-static void signal_new_requests(reqmgr_thrd_t* thrd_ctrl)
+/* append task at tail of deque */
+static void rm_deque_push(rm_deque_t* dq, rm_task_t* task)
+{
+    pthread_mutex_lock(&(dq->lock));
+    task->next = NULL;
+    task->prev = dq->tail;
+    if (NULL != dq->tail) {
+        dq->tail->next = task;
+    } else {
+        dq->head = task;
+    }
+    dq->tail = task;
+    pthread_mutex_unlock(&(dq->lock));
+}
+
+/* remove task from tail (steal == 0) or head (steal != 0) of deque,
+ * returns NULL if deque is empty */
+static rm_task_t* rm_deque_pop(rm_deque_t* dq, int steal)
+{
+    rm_task_t* task = NULL;
+    pthread_mutex_lock(&(dq->lock));
+    if (steal) {
+        task = dq->head;
+        if (NULL != task) {
+            dq->head = task->next;
+            if (NULL != dq->head) {
+                dq->head->prev = NULL;
+            } else {
+                dq->tail = NULL;
+            }
+        }
+    } else {
+        task = dq->tail;
+        if (NULL != task) {
+            dq->tail = task->prev;
+            if (NULL != dq->tail) {
+                dq->tail->next = NULL;
+            } else {
+                dq->head = NULL;
+            }
+        }
+    }
+    pthread_mutex_unlock(&(dq->lock));
+    return task;
+}
+
+/* add delta to the count of tasks of a client, waking up an
+ * unmount waiting for the count to drop to zero */
+static void rm_count_tasks(reqmgr_thrd_t* thrd_ctrl, int delta)
+{
+    if (NULL == thrd_ctrl) {
+        return;
+    }
+    pthread_mutex_lock(&(thrd_ctrl->task_lock));
+    thrd_ctrl->num_tasks += delta;
+    if (0 == thrd_ctrl->num_tasks) {
+        pthread_cond_broadcast(&(thrd_ctrl->task_cond));
+    }
+    pthread_mutex_unlock(&(thrd_ctrl->task_lock));
+}
+
+/* queue an allocated task in the request manager worker pool,
+ * the task is freed on failure */
+static int rm_queue_task(rm_task_t* task)
 {
-    // NOTE: this fn assumes thrd_ctrl->thrd_lock is locked
+    /* workers keep their own tasks, other threads spread them out */
+    int dq_ndx = rm_worker_ndx;
+    pthread_mutex_lock(&(rm_pool.sync));
+    if (rm_pool.exit_flag || (0 == rm_pool.num_workers)) {
+        pthread_mutex_unlock(&(rm_pool.sync));
+        LOGERR("request manager worker pool is not running");
+        free(task);
+        return (int)UNIFYFS_FAILURE;
+    }
+    rm_count_tasks(task->thrd_ctrl, 1);
+    if (dq_ndx < 0) {
+        dq_ndx = rm_pool.next_deque;
+        rm_pool.next_deque = (dq_ndx + 1) % rm_pool.num_workers;
+    }
+
+    /* count the task as it becomes visible, workers decrement
+     * the count only after taking a task from a deque */
+    rm_pool.num_tasks++;
+    rm_deque_push(rm_pool.deques + dq_ndx, task);
 
-    /* wake up the request manager thread for the requesting client */
-    if (!thrd_ctrl->has_waiting_delegator) {
-        /* delegator thread is not waiting, but we are in critical
-         * section, we just added requests so we must wait for delegator
-         * to signal us that it's reached the critical section before
-         * we escape so we don't overwrite these requests before it
-         * has had a chance to process them */
-        thrd_ctrl->has_waiting_dispatcher = 1;
-        pthread_cond_wait(&thrd_ctrl->thrd_cond, &thrd_ctrl->thrd_lock);
+    /* wake up an idle worker */
+    pthread_cond_signal(&(rm_pool.cond));
+    pthread_mutex_unlock(&(rm_pool.sync));
+
+    return (int)UNIFYFS_SUCCESS;
+}
 
-        /* delegator thread has signaled us that it's now waiting */
-        thrd_ctrl->has_waiting_dispatcher = 0;
+/* submit a task to the request manager worker pool */
+static int rm_submit_task(rm_task_type_e type,
+                          reqmgr_thrd_t* thrd_ctrl,
+                          int req_ndx,
+                          int remote_ndx)
+{
+    rm_task_t* task = (rm_task_t*) calloc(1, sizeof(rm_task_t));
+    if (NULL == task) {
+        LOGERR("failed to allocate request manager task");
+        return (int)UNIFYFS_ERROR_NOMEM;
     }
-    /* have a delegator thread waiting on condition variable,
-     * signal it to begin processing the requests we just added */
-    pthread_cond_signal(&thrd_ctrl->thrd_cond);
+    task->type       = type;
+    task->thrd_ctrl  = thrd_ctrl;
+    task->req_ndx    = req_ndx;
+    task->remote_ndx = remote_ndx;
+
+    return rm_queue_task(task);
 }
 
-static void signal_new_responses(reqmgr_thrd_t* thrd_ctrl)
+/* Chunk reads of a read request are sent to each delegator in
+ * windows of at most MAX_META_PER_SEND chunks and SENDRECV_BUF_LEN
+ * bytes of data (a larger single chunk gets a window of its own).
+ * Up to RECV_BUF_CNT windows per delegator are in flight, and the
+ * responses to each window are handled as they arrive, so the size
+ * of a read is not limited by the size of a single message. */
+
+/* return whether the chunk read for curr_del with len bytes
+ * starts a new window */
+static int new_chunk_window(int prev_del, int curr_del,
+                            int win_chunks, size_t win_sz, size_t len)
 {
-    // NOTE: this fn assumes thrd_ctrl->thrd_lock is locked
+    if ((prev_del == -1) || (curr_del != prev_del)) {
+        return 1;
+    }
+    if (win_chunks >= MAX_META_PER_SEND) {
+        return 1;
+    }
+    if ((win_sz + len) > SENDRECV_BUF_LEN) {
+        return 1;
+    }
+    return 0;
+}
 
-    /* wake up the request manager thread */
-    if (thrd_ctrl->has_waiting_delegator) {
-        /* have a delegator thread waiting on condition variable,
-         * signal it to begin processing the responses we just added */
-        pthread_cond_signal(&thrd_ctrl->thrd_cond);
+/* return whether window win_ndx of a read request must wait for
+ * the responses of an earlier window of the same delegator,
+ * windows of a delegator are adjacent in remote_reads */
+static int wait_chunk_window(server_read_req_t* rdreq, int win_ndx)
+{
+    if (win_ndx < RECV_BUF_CNT) {
+        return 0;
     }
+    remote_chunk_reads_t* rcr = rdreq->remote_reads + win_ndx;
+    remote_chunk_reads_t* prev = rcr - RECV_BUF_CNT;
+    return (prev->rank == rcr->rank);
 }
 
 /* issue remote chunk read requests for extent chunks
@@ -377,8 +630,9 @@ int create_chunk_requests(reqmgr_thrd_t* thrd_ctrl,
     int app_id = thrd_ctrl->app_id;
     int client_id = thrd_ctrl->client_id;
 
+    /* every field of the chunk-reads is set below */
     chunk_read_req_t* all_chunk_reads = (chunk_read_req_t*)
-        calloc((size_t)num_vals, sizeof(chunk_read_req_t));
+        bufpool_alloc((size_t)num_vals * sizeof(chunk_read_req_t));
     if (NULL == all_chunk_reads) {
         LOGERR("failed to allocate chunk-reads array");
         return UNIFYFS_ERROR_NOMEM;
@@ -405,6 +659,7 @@ int create_chunk_requests(reqmgr_thrd_t* thrd_ctrl,
         /* create chunk-reads */
         debug_log_key_val(__func__, &keyvals[i].key, &keyvals[i].val);
         chk_read = all_chunk_reads + i;
+        chk_read->gfid = keyvals[i].key.fid;
         chk_read->nbytes = keyvals[i].val.len;
         chk_read->offset = keyvals[i].key.offset;
         chk_read->log_offset = keyvals[i].val.addr;
@@ -412,60 +667,91 @@ int create_chunk_requests(reqmgr_thrd_t* thrd_ctrl,
         chk_read->log_client_id = keyvals[i].val.rank;
     }
 
-    /* allocate per-delgator chunk-reads */
-    int num_dels = del_ndx + 1;
-    rdreq->num_remote_reads = num_dels;
+    /* allocate per-delegator chunk-read windows */
+    int num_wins = 0;
+    int win_chunks = 0;
+    size_t win_sz = 0;
+    prev_del = -1;
+    for (i = 0; i < num_vals; i++) {
+        curr_del = keyvals[i].val.delegator_rank;
+        if (new_chunk_window(prev_del, curr_del, win_chunks, win_sz,
+                             keyvals[i].val.len)) {
+            num_wins++;
+            win_chunks = 0;
+            win_sz = 0;
+        }
+        prev_del = curr_del;
+        win_chunks++;
+        win_sz += keyvals[i].val.len;
+    }
+    rdreq->num_remote_reads = num_wins;
     rdreq->remote_reads = (remote_chunk_reads_t*)
-        calloc((size_t)num_dels, sizeof(remote_chunk_reads_t));
+        bufpool_alloc((size_t)num_wins * sizeof(remote_chunk_reads_t));
     if (NULL == rdreq->remote_reads) {
         LOGERR("failed to allocate remote-reads array");
         RM_UNLOCK(thrd_ctrl);
         return UNIFYFS_ERROR_NOMEM;
     }
 
-    /* populate per-delegator chunk-reads info */
-    size_t del_data_sz = 0;
-    remote_chunk_reads_t* del_reads;
+    /* populate chunk-read windows info */
+    remote_chunk_reads_t* del_reads = NULL;
+    int win_ndx = -1;
+    win_chunks = 0;
+    win_sz = 0;
     prev_del = -1;
-    del_ndx = 0;
     for (i = 0; i < num_vals; i++) {
         curr_del = keyvals[i].val.delegator_rank;
-        if ((prev_del != -1) && (curr_del != prev_del)) {
-            /* record total data for previous delegator */
-            del_reads = rdreq->remote_reads + del_ndx;
-            del_reads->total_sz = del_data_sz;
-            /* advance to next delegator */
-            del_ndx++;
-            del_data_sz = 0;
-        }
-        prev_del = curr_del;
-
-        /* update total data size for current delegator */
-        del_data_sz += keyvals[i].val.len;
-
-        del_reads = rdreq->remote_reads + del_ndx;
-        if (0 == del_reads->num_chunks) {
-            /* initialize structure */
+        if (new_chunk_window(prev_del, curr_del, win_chunks, win_sz,
+                             keyvals[i].val.len)) {
+            /* initialize structure for next window */
+            win_ndx++;
+            win_chunks = 0;
+            win_sz = 0;
+            del_reads = rdreq->remote_reads + win_ndx;
+            memset(del_reads, 0, sizeof(remote_chunk_reads_t));
             del_reads->rank = curr_del;
-            del_reads->rdreq_id = rdreq->req_ndx;
+            del_reads->rdreq_id = RM_CHUNK_READS_ID(rdreq->req_ndx,
+                                                    win_ndx);
             del_reads->reqs = all_chunk_reads + i;
             del_reads->resp = NULL;
+            del_reads->status = READREQ_INIT;
         }
+        prev_del = curr_del;
+        win_chunks++;
+        win_sz += keyvals[i].val.len;
+
         del_reads->num_chunks++;
+        del_reads->total_sz += keyvals[i].val.len;
     }
-    del_reads = rdreq->remote_reads + del_ndx;
-    del_reads->total_sz = del_data_sz;
+    LOGDBG("rdreq %d has %d chunk-read windows for %d chunks",
+           rdreq->req_ndx, num_wins, num_vals);
 
-    /* wake up the request manager thread for the requesting client */
-    signal_new_requests(thrd_ctrl);
+    /* hand off a send task for the first windows of each delegator
+     * to the workers, the remaining windows are sent as responses
+     * come back. The workers wait for the lock, so the request is
+     * fully started before any responses can be handled. */
+    int rc;
+    int ret = (int)UNIFYFS_SUCCESS;
+    rdreq->status = READREQ_STARTED;
+    for (i = 0; i < num_wins; i++) {
+        if (wait_chunk_window(rdreq, i)) {
+            continue;
+        }
+        rdreq->remote_reads[i].status = READREQ_STARTED;
+        rc = rm_submit_task(RM_TASK_SEND_CHUNKS, thrd_ctrl,
+                            rdreq->req_ndx, i);
+        if (rc != (int)UNIFYFS_SUCCESS) {
+            ret = rc;
+        }
+    }
     RM_UNLOCK(thrd_ctrl);
 
-    return UNIFYFS_SUCCESS;
+    return ret;
 }
 
 /************************
  * These functions are called by the rpc handler to assign work
- * to the request manager thread
+ * to the request manager workers
  ***********************/
 
 /* given an app_id, client_id and global file id,
@@ -474,13 +760,23 @@ int create_chunk_requests(reqmgr_thrd_t* thrd_ctrl,
 int rm_cmd_filesize(
     int app_id,    /* app_id for requesting client */
     int client_id, /* client_id for requesting client */
-    int gfid,      /* global file id of read request */
+    uint64_t gfid, /* global file id of read request */
     size_t* outsize) /* output file size */
 {
     /* initialize output file size to something deterministic,
      * in case we drop out with an error */
     *outsize = 0;
 
+    /* file size is needed to laminate, which is a barrier for any
+     * asynchronous fsyncs that have not been published yet, and the
+     * extents of the file may have been synced through any server */
+    int rc = rm_fsync_flush_all(app_id);
+    if (UNIFYFS_SUCCESS != rc) {
+        LOGERR("failed to flush asynchronous fsyncs for app_id=%d",
+               app_id);
+        return rc;
+    }
+
     /* set offset and length to request *all* key/value pairs
      * for this file */
     size_t offset = 0;
@@ -508,8 +804,8 @@ int rm_cmd_filesize(
     /* look up all entries in this range */
     int num_vals = 0;
     unifyfs_keyval_t* keyvals = NULL;
-    int rc = unifyfs_get_file_extents(2, unifyfs_keys, key_lens,
-                                      &num_vals, &keyvals);
+    rc = unifyfs_get_file_extents(2, unifyfs_keys, key_lens,
+                                  &num_vals, &keyvals);
     if (UNIFYFS_SUCCESS != rc) {
         /* failed to look up extents, bail with error */
         return UNIFYFS_FAILURE;
@@ -542,8 +838,41 @@ int rm_cmd_filesize(
     return rc;
 }
 
+/* create a read request for the file extents of one gfid,
+ * keyvals must be sorted by delegator rank */
+static int create_keyval_chunk_reads(reqmgr_thrd_t* thrd_ctrl,
+                                     uint64_t gfid, int app_id,
+                                     int client_id, int num_vals,
+                                     unifyfs_keyval_t* keyvals)
+{
+    /* TODO: if there are file extents not accounted for we should
+     * either return 0 for that data (holes) or EOF if reading past
+     * the end of the file */
+    if (num_vals == 0) {
+        /* failed to find any key / value pairs */
+        return UNIFYFS_FAILURE;
+    }
+
+    int rc;
+    server_read_req_t* rdreq = reserve_read_req(thrd_ctrl);
+    if (NULL == rdreq) {
+        rc = UNIFYFS_FAILURE;
+    } else {
+        rdreq->app_id         = app_id;
+        rdreq->client_id      = client_id;
+        rdreq->extent.gfid    = gfid;
+        rdreq->extent.errcode = EINPROGRESS;
+        rc = create_chunk_requests(thrd_ctrl, rdreq,
+                                   num_vals, keyvals);
+        if (rc != (int)UNIFYFS_SUCCESS) {
+            release_read_req(thrd_ctrl, rdreq);
+        }
+    }
+    return rc;
+}
+
 int create_gfid_chunk_reads(reqmgr_thrd_t* thrd_ctrl,
-                            int gfid, int app_id, int client_id,
+                            uint64_t gfid, int app_id, int client_id,
                             int num_keys, unifyfs_key_t** keys, int* keylens)
 {
     /* lookup all key/value pairs for given range */
@@ -551,23 +880,7 @@ int create_gfid_chunk_reads(reqmgr_thrd_t* thrd_ctrl,
     unifyfs_keyval_t* keyvals = NULL;
     int rc = unifyfs_get_file_extents(num_keys, keys, keylens,
                                       &num_vals, &keyvals);
-
-    /* this is to maintain limits imposed in previous code
-     * that would throw fatal errors */
-    if (num_vals >= UNIFYFS_MAX_SPLIT_CNT ||
-        num_vals >= MAX_META_PER_SEND) {
-        LOGERR("too many key/values returned in range lookup");
-        if (NULL != keyvals) {
-            free(keyvals);
-            keyvals = NULL;
-        }
-        return UNIFYFS_ERROR_NOMEM;
-    }
-
-    /* TODO: if there are file extents not accounted for we should
-     * either return 0 for that data (holes) or EOF if reading past
-     * the end of the file */
-    if (UNIFYFS_SUCCESS != rc || num_vals == 0) {
+    if (UNIFYFS_SUCCESS != rc) {
         /* failed to find any key / value pairs */
         rc = UNIFYFS_FAILURE;
     } else {
@@ -576,44 +889,284 @@ int create_gfid_chunk_reads(reqmgr_thrd_t* thrd_ctrl,
             qsort(keyvals, (size_t)num_vals, sizeof(unifyfs_keyval_t),
                   compare_kv_gfid_rank);
         }
+        rc = create_keyval_chunk_reads(thrd_ctrl, gfid, app_id, client_id,
+                                       num_vals, keyvals);
+    }
 
-        server_read_req_t* rdreq = reserve_read_req(thrd_ctrl);
-        if (NULL == rdreq) {
-            rc = UNIFYFS_FAILURE;
+    /* free off key/value buffer returned from get_file_extents */
+    if (NULL != keyvals) {
+        free(keyvals);
+        keyvals = NULL;
+    }
+
+    return rc;
+}
+
+/* return whether read-ahead window is not in use by a prefetch
+ * or by reads being served from it */
+static int ra_window_idle(rm_ra_window_t* win)
+{
+    return ((win->status != READREQ_STARTED) && (0 == win->users));
+}
+
+/* drop the data of an idle read-ahead window */
+static void ra_window_reset(rm_ra_window_t* win)
+{
+    if (NULL != win->data) {
+        bufpool_free(win->data);
+    }
+    if (NULL != win->chunks) {
+        bufpool_free(win->chunks);
+    }
+    memset(win, 0, sizeof(rm_ra_window_t));
+}
+
+/* return whether new extents of the file were stored since
+ * the data of a read-ahead window was looked up */
+static int ra_window_outdated(rm_ra_window_t* win)
+{
+    return (win->meta_gen != unifyfs_get_extents_gen(win->gfid));
+}
+
+/* drop the read-ahead window data of a client for the given file
+ * (or all files if gfid is 0), windows in use are dropped once the
+ * prefetch or reads using them are done */
+static void ra_invalidate(reqmgr_thrd_t* thrd_ctrl, uint64_t gfid)
+{
+    int i;
+    RM_LOCK(thrd_ctrl);
+    for (i = 0; i < RM_READAHEAD_WINDOWS; i++) {
+        rm_ra_window_t* win = thrd_ctrl->ra_wins + i;
+        if ((win->status == READREQ_INIT) ||
+            ((gfid != 0) && (win->gfid != gfid))) {
+            continue;
+        }
+        if (ra_window_idle(win)) {
+            ra_window_reset(win);
         } else {
-            rdreq->app_id         = app_id;
-            rdreq->client_id      = client_id;
+            win->stale = 1;
+        }
+    }
+    RM_UNLOCK(thrd_ctrl);
+}
+
+/* order read-ahead chunks by file offset */
+static int compare_ra_chunk(const void* a, const void* b)
+{
+    const rm_ra_chunk_t* chk_a = a;
+    const rm_ra_chunk_t* chk_b = b;
+    if (chk_a->offset == chk_b->offset) {
+        return 0;
+    }
+    return (chk_a->offset < chk_b->offset) ? -1 : 1;
+}
+
+/* return index of the read-ahead window holding all data of the
+ * given extent, or -1 if there is none */
+static int ra_window_lookup(reqmgr_thrd_t* thrd_ctrl, uint64_t gfid,
+                            size_t offset, size_t length)
+{
+    int i, j;
+    size_t end = offset + length;
+    for (i = 0; i < RM_READAHEAD_WINDOWS; i++) {
+        rm_ra_window_t* win = thrd_ctrl->ra_wins + i;
+        if ((win->status == READREQ_COMPLETE) && ra_window_outdated(win)) {
+            win->stale = 1;
+        }
+        if ((win->status != READREQ_COMPLETE) || win->stale ||
+            (win->gfid != gfid) || (offset < win->offset) ||
+            (end > (win->offset + win->length))) {
+            continue;
+        }
+
+        /* chunks are sorted by offset, make sure there are no holes */
+        size_t pos = offset;
+        for (j = 0; (j < win->num_chunks) && (pos < end); j++) {
+            rm_ra_chunk_t* chk = win->chunks + j;
+            if ((chk->offset + chk->nbytes) <= pos) {
+                continue;
+            }
+            if (chk->offset > pos) {
+                break;
+            }
+            pos = chk->offset + chk->nbytes;
+        }
+        if (pos >= end) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* start prefetching data of the file following offset next, unless
+ * there is enough data ahead of it in the read-ahead windows already,
+ * called with client state locked */
+static void ra_prefetch_next(reqmgr_thrd_t* thrd_ctrl, uint64_t gfid,
+                             size_t next)
+{
+    int i, pass;
+
+    /* one prefetch at a time per client */
+    for (i = 0; i < RM_READAHEAD_WINDOWS; i++) {
+        rm_ra_window_t* win = thrd_ctrl->ra_wins + i;
+        if ((win->status == READREQ_COMPLETE) && ra_window_outdated(win)) {
+            win->stale = 1;
+        }
+        if (win->stale && ra_window_idle(win)) {
+            ra_window_reset(win);
+        }
+        if (win->status == READREQ_STARTED) {
+            return;
+        }
+    }
+
+    /* find end of the data that is already prefetched from next on */
+    size_t ra_end = next;
+    for (pass = 0; pass < RM_READAHEAD_WINDOWS; pass++) {
+        for (i = 0; i < RM_READAHEAD_WINDOWS; i++) {
+            rm_ra_window_t* win = thrd_ctrl->ra_wins + i;
+            size_t win_end = win->offset + win->length;
+            if ((win->status == READREQ_COMPLETE) && !win->stale &&
+                (win->gfid == gfid) && (win->offset <= ra_end) &&
+                (win_end > ra_end)) {
+                ra_end = win_end;
+            }
+        }
+    }
+    if ((ra_end - next) >= (rm_readahead_size / 2)) {
+        return;
+    }
+
+    /* pick a window that holds no data we may still need */
+    int ra_ndx = -1;
+    for (i = 0; i < RM_READAHEAD_WINDOWS; i++) {
+        rm_ra_window_t* win = thrd_ctrl->ra_wins + i;
+        if (!ra_window_idle(win)) {
+            continue;
+        }
+        if ((win->status == READREQ_INIT) ||
+            (win->gfid != gfid) ||
+            ((win->offset + win->length) <= next)) {
+            ra_ndx = i;
+            break;
+        }
+    }
+    if (ra_ndx == -1) {
+        return;
+    }
+
+    server_read_req_t* rdreq = reserve_read_req(thrd_ctrl);
+    if (NULL == rdreq) {
+        return;
+    }
+    rm_ra_window_t* win = thrd_ctrl->ra_wins + ra_ndx;
+    ra_window_reset(win);
+    win->status = READREQ_STARTED;
+    win->gfid   = gfid;
+    win->offset = ra_end;
+    win->length = rm_readahead_size;
+
+    rdreq->app_id         = thrd_ctrl->app_id;
+    rdreq->client_id      = thrd_ctrl->client_id;
+    rdreq->extent.gfid    = gfid;
+    rdreq->extent.offset  = win->offset;
+    rdreq->extent.length  = win->length;
+    rdreq->extent.errcode = EINPROGRESS;
+    rdreq->prefetch       = 1;
+    rdreq->ra_ndx         = ra_ndx;
+
+    /* the metadata lookup is left to a worker, so the read
+     * that triggered the prefetch is not held up by it */
+    int rc = rm_submit_task(RM_TASK_PREFETCH, thrd_ctrl,
+                            rdreq->req_ndx, 0);
+    if (rc != (int)UNIFYFS_SUCCESS) {
+        ra_window_reset(win);
+        release_read_req(thrd_ctrl, rdreq);
+        return;
+    }
+    __atomic_add_fetch(&rm_ra_prefetches, 1, __ATOMIC_RELAXED);
+    LOGDBG("prefetching gfid=%" PRIu64 " offset=%zu length=%zu "
+           "into read-ahead window %d", gfid, win->offset, win->length,
+           ra_ndx);
+}
+
+/* track sequential reads of a client, hand the read to a worker to
+ * copy its data from a read-ahead window if possible, and prefetch
+ * the data following it. Returns 1 if the read is served from a
+ * read-ahead window, 0 if it must be read as usual. */
+static int ra_client_read(reqmgr_thrd_t* thrd_ctrl, uint64_t gfid,
+                          size_t offset, size_t length)
+{
+    int served = 0;
+
+    RM_LOCK(thrd_ctrl);
+
+    if ((gfid == thrd_ctrl->seq_gfid) && (offset == thrd_ctrl->seq_offset)) {
+        thrd_ctrl->seq_reads++;
+    } else {
+        if (gfid != thrd_ctrl->seq_gfid) {
+            thrd_ctrl->seq_unlaminated = 0;
+        }
+        thrd_ctrl->seq_gfid = gfid;
+        thrd_ctrl->seq_reads = 0;
+    }
+    thrd_ctrl->seq_offset = offset + length;
+
+    int ra_ndx = ra_window_lookup(thrd_ctrl, gfid, offset, length);
+    if (ra_ndx != -1) {
+        server_read_req_t* rdreq = reserve_read_req(thrd_ctrl);
+        if (NULL != rdreq) {
+            rdreq->app_id         = thrd_ctrl->app_id;
+            rdreq->client_id      = thrd_ctrl->client_id;
             rdreq->extent.gfid    = gfid;
+            rdreq->extent.offset  = offset;
+            rdreq->extent.length  = length;
             rdreq->extent.errcode = EINPROGRESS;
-            rc = create_chunk_requests(thrd_ctrl, rdreq,
-                                       num_vals, keyvals);
-            if (rc != (int)UNIFYFS_SUCCESS) {
+            rdreq->ra_ndx         = ra_ndx;
+            rdreq->status         = READREQ_STARTED;
+            thrd_ctrl->ra_wins[ra_ndx].users++;
+            int rc = rm_submit_task(RM_TASK_READAHEAD, thrd_ctrl,
+                                    rdreq->req_ndx, 0);
+            if (rc == (int)UNIFYFS_SUCCESS) {
+                served = 1;
+            } else {
+                thrd_ctrl->ra_wins[ra_ndx].users--;
                 release_read_req(thrd_ctrl, rdreq);
             }
         }
     }
 
-    /* free off key/value buffer returned from get_file_extents */
-    if (NULL != keyvals) {
-        free(keyvals);
-        keyvals = NULL;
+    if ((thrd_ctrl->seq_reads >= RM_READAHEAD_MIN_SEQ) &&
+        !thrd_ctrl->seq_unlaminated) {
+        if (served) {
+            __atomic_add_fetch(&rm_ra_hits, 1, __ATOMIC_RELAXED);
+        } else {
+            __atomic_add_fetch(&rm_ra_misses, 1, __ATOMIC_RELAXED);
+        }
+        ra_prefetch_next(thrd_ctrl, gfid, offset + length);
     }
 
-    return rc;
+    RM_UNLOCK(thrd_ctrl);
+
+    return served;
 }
 
 /* read function for one requested extent,
- * called from rpc handler to fill shared data structures
- * with read requests to be handled by the delegator thread
+ * called by a worker for a read operation taken from the request
+ * ring to fill shared data structures with read requests,
  * returns before requests are handled
  */
 int rm_cmd_read(
     int app_id,    /* app_id for requesting client */
     int client_id, /* client_id for requesting client */
-    int gfid,      /* global file id of read request */
+    uint64_t gfid, /* global file id of read request */
     size_t offset, /* logical file offset of read request */
     size_t length) /* number of bytes to read */
 {
+    /* make sure extents from asynchronous fsyncs of this
+     * client are visible */
+    rm_fsync_wait(app_id, client_id);
+
     /* get pointer to app structure for this app id */
     app_config_t* app_config =
         (app_config_t*)arraylist_get(app_config_list, app_id);
@@ -624,6 +1177,12 @@ int rm_cmd_read(
     /* look up thread control structure */
     reqmgr_thrd_t* thrd_ctrl = rm_get_thread(thrd_id);
 
+    /* serve sequential reads from prefetched data when we can */
+    if ((rm_readahead_size > 0) &&
+        ra_client_read(thrd_ctrl, gfid, offset, length)) {
+        return (int)UNIFYFS_SUCCESS;
+    }
+
     /* get chunks corresponding to requested client read extent
      *
      * Generate a pair of keys for the read request, representing the start
@@ -652,17 +1211,24 @@ int rm_cmd_read(
                                    2, unifyfs_keys, key_lens);
 }
 
-/* send the read requests to the remote delegators
+/* send the read requests of a list of extents to the remote delegators,
+ * the chunk reads of all files go into a single read request, so the
+ * client is told the operation is complete once all of them are done.
+ * Requested extents of files without any extents are failed with an
+ * error reply at that point, the other extents are still read.
  *
  * @param app_id: application id
  * @param client_id: client id for requesting process
- * @param gfid: global file id
  * @param req_num: number of read requests
- * @param reqbuf: read requests buffer
+ * @param reqs: read request extents
  * @return success/error code */
-int rm_cmd_mread(int app_id, int client_id,
-                 size_t req_num, void* reqbuf)
+static int rm_read_extents(int app_id, int client_id,
+                           size_t req_num, client_read_req_t* reqs)
 {
+    /* make sure extents from asynchronous fsyncs of this
+     * client are visible */
+    rm_fsync_wait(app_id, client_id);
+
     /* get pointer to app structure for this app id */
     app_config_t* app_config =
         (app_config_t*)arraylist_get(app_config_list, app_id);
@@ -676,13 +1242,6 @@ int rm_cmd_mread(int app_id, int client_id,
     /* get debug rank for this client */
     int cli_rank = app_config->dbg_ranks[client_id];
 
-     /* get the locations of all the read requests from the key-value store */
-    unifyfs_ReadRequest_table_t readRequest =
-        unifyfs_ReadRequest_as_root(reqbuf);
-    unifyfs_Extent_vec_t extents = unifyfs_ReadRequest_extents(readRequest);
-    size_t extents_len = unifyfs_Extent_vec_len(extents);
-    assert(extents_len == req_num);
-
     // allocate key storage
     unifyfs_key_t** unifyfs_keys;
     int* key_lens;
@@ -697,141 +1256,255 @@ int rm_cmd_mread(int app_id, int client_id,
         return (int)UNIFYFS_ERROR_NOMEM;
     }
 
-    /* get chunks corresponding to requested client read extents */
-    int rc, num_keys;
-    int fid = -1;
-    int last_fid = -1;
-    int ndx = 0;
+    /* Generate a pair of keys for each read request, representing
+     * the start and end offsets. MDHIM returns all key-value pairs that
+     * fall within the offset range.
+     *
+     * TODO: this is specific to the MDHIM in the source tree and not
+     *       portable to other KV-stores. This needs to be revisited to
+     *       utilize some other mechanism to retrieve all relevant KV
+     *       pairs from the KV-store.
+     */
+    int rc;
+    uint64_t fid;
     size_t j, eoff, elen;
     for (j = 0; j < req_num; j++) {
-        fid = unifyfs_Extent_fid(unifyfs_Extent_vec_at(extents, j));
-        if (j && (fid != last_fid)) {
-            // create requests for all extents of last_fid
-            num_keys = ndx;
-            rc = create_gfid_chunk_reads(thrd_ctrl, last_fid, app_id,
-                                         client_id, num_keys,
-                                         unifyfs_keys, key_lens);
-            if (rc != UNIFYFS_SUCCESS) {
-                LOGERR("Error creating chunk reads for gfid=%d", last_fid);
-            }
-            // reset ndx for current fid
-            ndx = 0;
-        }
-
-        eoff = unifyfs_Extent_offset(unifyfs_Extent_vec_at(extents, j));
-        elen = unifyfs_Extent_length(unifyfs_Extent_vec_at(extents, j));
-        LOGDBG("gfid:%d, offset:%zu, length:%zu", fid, eoff, elen);
-
-        /* Generate a pair of keys for each read request, representing
-         * the start and end offsets. MDHIM returns all key-value pairs that
-         * fall within the offset range.
-         *
-         * TODO: this is specific to the MDHIM in the source tree and not
-         *       portable to other KV-stores. This needs to be revisited to
-         *       utilize some other mechanism to retrieve all relevant KV
-         *       pairs from the KV-store.
-         */
-        key_lens[ndx] = sizeof(unifyfs_key_t);
-        key_lens[ndx + 1] = sizeof(unifyfs_key_t);
+        fid = reqs[j].gfid;
+        eoff = reqs[j].offset;
+        elen = reqs[j].length;
+        LOGDBG("gfid:%" PRIu64 ", offset:%zu, length:%zu", fid, eoff, elen);
+
+        key_lens[2 * j] = sizeof(unifyfs_key_t);
+        key_lens[2 * j + 1] = sizeof(unifyfs_key_t);
 
         /* create key to describe first byte we'll read */
-        unifyfs_keys[ndx]->fid = fid;
-        unifyfs_keys[ndx]->offset = eoff;
+        unifyfs_keys[2 * j]->fid = fid;
+        unifyfs_keys[2 * j]->offset = eoff;
 
         /* create key to describe last byte we'll read */
-        unifyfs_keys[ndx + 1]->fid = fid;
-        unifyfs_keys[ndx + 1]->offset = eoff + elen - 1;
-
-        ndx += 2;
-        last_fid = fid;
+        unifyfs_keys[2 * j + 1]->fid = fid;
+        unifyfs_keys[2 * j + 1]->offset = eoff + elen - 1;
     }
 
-    // create requests for all extents of last_fid
-    num_keys = ndx;
-    rc = create_gfid_chunk_reads(thrd_ctrl, last_fid, app_id,
-                                 client_id, num_keys,
-                                 unifyfs_keys, key_lens);
-    if (rc != UNIFYFS_SUCCESS) {
-        LOGERR("Error creating chunk reads for gfid=%d", last_fid);
-    }
+    /* look up the extents of all files at once, the key-value store
+     * groups the ranges by range server and queries all of the
+     * servers in parallel, rather than one round trip per file */
+    int num_vals = 0;
+    unifyfs_keyval_t* keyvals = NULL;
+    rc = unifyfs_get_file_extents((int)key_cnt, unifyfs_keys, key_lens,
+                                  &num_vals, &keyvals);
 
     // cleanup
     free_key_array(unifyfs_keys);
     free(key_lens);
 
-    return rc;
-}
-
-/* function called by main thread to instruct
- * resource manager thread to exit,
- * returns UNIFYFS_SUCCESS on success */
-int rm_cmd_exit(reqmgr_thrd_t* thrd_ctrl)
-{
-    /* grab the lock */
-    RM_LOCK(thrd_ctrl);
-
-    if (thrd_ctrl->exited) {
-        /* already done */
-        RM_UNLOCK(thrd_ctrl);
-        return UNIFYFS_SUCCESS;
+    if (UNIFYFS_SUCCESS != rc) {
+        LOGERR("Error looking up extents of %zu read requests", req_num);
+        return UNIFYFS_FAILURE;
     }
 
-    /* if delegator thread is not waiting in critical
-     * section, let's wait on it to come back */
-    if (!thrd_ctrl->has_waiting_delegator) {
-        /* delegator thread is not in critical section,
-         * tell it we've got something and signal it */
-        thrd_ctrl->has_waiting_dispatcher = 1;
-        pthread_cond_wait(&thrd_ctrl->thrd_cond, &thrd_ctrl->thrd_lock);
-
-        /* we're no longer waiting */
-        thrd_ctrl->has_waiting_dispatcher = 0;
+    /* sort keyvals by gfid to find files without any extents */
+    if (num_vals > 1) {
+        qsort(keyvals, (size_t)num_vals, sizeof(unifyfs_keyval_t),
+              compare_kv_gfid_rank);
+    }
+    size_t num_failed = 0;
+    client_read_req_t* failed = NULL;
+    for (j = 0; j < req_num; j++) {
+        fid = reqs[j].gfid;
+        if (bsearch_kv_gfid(keyvals, num_vals, fid)) {
+            continue;
+        }
+        LOGERR("no extents to read for gfid=%" PRIu64, fid);
+        if (NULL == failed) {
+            failed = (client_read_req_t*)
+                calloc(req_num, sizeof(client_read_req_t));
+            if (NULL == failed) {
+                LOGERR("failed to allocate failed read requests");
+                rc = (int)UNIFYFS_ERROR_NOMEM;
+                break;
+            }
+        }
+        failed[num_failed] = reqs[j];
+        failed[num_failed].errcode = EIO;
+        num_failed++;
+    }
+    if ((rc != UNIFYFS_SUCCESS) || (0 == num_vals)) {
+        /* nothing to read for any of the requests */
+        if (NULL != failed) {
+            free(failed);
+        }
+        if (NULL != keyvals) {
+            free(keyvals);
+        }
+        return UNIFYFS_FAILURE;
     }
 
-    /* inform delegator thread that it's time to exit */
-    thrd_ctrl->exit_flag = 1;
+    /* one read request for all files, grouped by delegator */
+    if (num_vals > 1) {
+        qsort(keyvals, (size_t)num_vals, sizeof(unifyfs_keyval_t),
+              compare_kv_rank_gfid);
+    }
+    server_read_req_t* rdreq = reserve_read_req(thrd_ctrl);
+    if (NULL == rdreq) {
+        rc = UNIFYFS_FAILURE;
+        if (NULL != failed) {
+            free(failed);
+        }
+    } else {
+        rdreq->app_id           = app_id;
+        rdreq->client_id        = client_id;
+        rdreq->extent.gfid      = keyvals[0].key.fid;
+        rdreq->extent.errcode   = EINPROGRESS;
+        rdreq->failed_reads     = failed;
+        rdreq->num_failed_reads = (int)num_failed;
+        rc = create_chunk_requests(thrd_ctrl, rdreq, num_vals, keyvals);
+        if (rc != (int)UNIFYFS_SUCCESS) {
+            release_read_req(thrd_ctrl, rdreq);
+        }
+    }
+    LOGDBG("created chunk reads for %zu read requests (%zu failed)",
+           req_num, num_failed);
 
-    /* signal delegator thread */
-    pthread_cond_signal(&thrd_ctrl->thrd_cond);
+    free(keyvals);
 
-    /* release the lock */
+    return rc;
+}
+
+/* function called by main thread to stop serving a client,
+ * tasks for the client still queued in the worker pool are dropped,
+ * returns once no task for the client is queued or running, so the
+ * caller may then free the client shared memory,
+ * returns UNIFYFS_SUCCESS on success */
+int rm_cmd_exit(reqmgr_thrd_t* thrd_ctrl)
+{
+    /* queued tasks see this and drop their work */
+    RM_LOCK(thrd_ctrl);
+    thrd_ctrl->exit_flag = 1;
     RM_UNLOCK(thrd_ctrl);
 
-    /* wait for delegator thread to exit */
-    void* status;
-    pthread_join(thrd_ctrl->thrd, &status);
-    thrd_ctrl->exited = 1;
+    /* stop polling the request ring before the region is detached,
+     * the poller queues no more read tasks for the client after this */
+    pthread_mutex_lock(&(rm_ring.sync));
+    thrd_ctrl->req_ring = NULL;
+    if (NULL != thrd_ctrl->ring_reqs) {
+        free(thrd_ctrl->ring_reqs);
+        thrd_ctrl->ring_reqs = NULL;
+    }
+    thrd_ctrl->ring_num_reqs = 0;
+    thrd_ctrl->ring_max_reqs = 0;
+    pthread_mutex_unlock(&(rm_ring.sync));
+
+    /* wait for queued and running tasks, a task already waiting on
+     * the client recv buffer finishes once client_wait times out */
+    pthread_mutex_lock(&(thrd_ctrl->task_lock));
+    while (thrd_ctrl->num_tasks > 0) {
+        pthread_cond_wait(&(thrd_ctrl->task_cond),
+                          &(thrd_ctrl->task_lock));
+    }
+    pthread_mutex_unlock(&(thrd_ctrl->task_lock));
+
+    /* free read-ahead data */
+    ra_invalidate(thrd_ctrl, 0);
 
     return UNIFYFS_SUCCESS;
 }
 
-/*
- * synchronize all the indices and file attributes
- * to the key-value store
- *
- * @param app_id: the application id
- * @param client_side_id: client rank in app
- * @param gfid: global file id
- * @return success/error code
- */
-int rm_cmd_fsync(int app_id, int client_side_id, int gfid)
+/* file extents and attributes copied out of a client superblock
+ * by fsync, these are published to the key-value store either
+ * directly by the rpc handler or later by the fsync thread */
+typedef struct fsync_job {
+    int app_id;    /* app id of client */
+    int client_id; /* client id of client */
+
+    /* index header in client superblock, and the number of index
+     * entries that will be synced once this job is published */
+    unifyfs_index_hdr_t* idx_hdr;
+    size_t synced_end;
+
+    int attempts; /* failed attempts to publish the job */
+
+    /* file extent key/values */
+    size_t num_extents;
+    unifyfs_key_t** keys;
+    unifyfs_val_t** vals;
+    int* key_lens;
+    int* val_lens;
+
+    /* file attribute key/values */
+    size_t num_attrs;
+    fattr_key_t** attr_keys;
+    unifyfs_file_attr_t* attrs;
+    unifyfs_file_attr_t** attr_vals;
+    int* attr_key_lens;
+    int* attr_val_lens;
+
+    struct fsync_job* next;
+} fsync_job_t;
+
+/* state of the fsync thread, which publishes snapshots from
+ * asynchronous fsync calls in the order they were received */
+typedef struct {
+    pthread_t thrd;
+    pthread_mutex_t sync;
+    pthread_cond_t cond;  /* signaled on new and completed jobs */
+    fsync_job_t* head;    /* queue of jobs waiting to be published */
+    fsync_job_t* tail;
+    fsync_job_t* active;  /* job currently being published */
+    int initialized;
+    int time_to_exit;
+} fsync_mgr_t;
+
+static fsync_mgr_t fsync_mgr;
+
+static void fsync_job_free(fsync_job_t* job)
 {
-    size_t i;
+    if (NULL != job->keys) {
+        free_key_array(job->keys);
+    }
+    if (NULL != job->vals) {
+        free_value_array(job->vals);
+    }
+    if (NULL != job->key_lens) {
+        free(job->key_lens);
+    }
+    if (NULL != job->val_lens) {
+        free(job->val_lens);
+    }
+    if (NULL != job->attr_keys) {
+        free_attr_key_array(job->attr_keys);
+    }
+    if (NULL != job->attrs) {
+        free(job->attrs);
+    }
+    if (NULL != job->attr_vals) {
+        free(job->attr_vals);
+    }
+    if (NULL != job->attr_key_lens) {
+        free(job->attr_key_lens);
+    }
+    if (NULL != job->attr_val_lens) {
+        free(job->attr_val_lens);
+    }
+    free(job);
+}
 
-    /* assume we'll succeed */
-    int ret = (int)UNIFYFS_SUCCESS;
+/* copy the index entries and file attributes of a client from
+ * its superblock into a new fsync job */
+static int fsync_job_create(int app_id, int client_side_id,
+                            fsync_job_t** pjob)
+{
+    size_t i;
 
-    /* pointers to memory we'll dynamically allocate for file extents */
-    unifyfs_key_t** unifyfs_keys = NULL;
-    unifyfs_val_t** unifyfs_vals = NULL;
-    int* unifyfs_key_lens        = NULL;
-    int* unifyfs_val_lens        = NULL;
+    *pjob = NULL;
 
-    /* pointers to memory we'll dynamically allocate for file attributes */
-    fattr_key_t** fattr_keys         = NULL;
-    unifyfs_file_attr_t** fattr_vals = NULL;
-    int* fattr_key_lens              = NULL;
-    int* fattr_val_lens              = NULL;
+    fsync_job_t* job = (fsync_job_t*) calloc(1, sizeof(fsync_job_t));
+    if (NULL == job) {
+        LOGERR("failed to allocate fsync job");
+        return (int)UNIFYFS_ERROR_NOMEM;
+    }
+    job->app_id    = app_id;
+    job->client_id = client_side_id;
 
     /* get memory page size on this machine */
     int page_sz = getpagesize();
@@ -849,65 +1522,66 @@ int rm_cmd_fsync(int app_id, int client_side_id, int gfid)
     /* get pointer to start of file attribute region in superblock */
     char* fmeta = superblk + app_config->fmeta_offset;
 
-    /* get number of file extent index values client has for us,
-     * stored as a size_t value in meta region of shared memory */
-    size_t extent_num_entries = *(size_t*)(meta);
+    /* get number of file extent index values client has written,
+     * and how many of those we have already synced, both stored
+     * in a header at the start of meta region of shared memory */
+    unifyfs_index_hdr_t* idx_hdr = (unifyfs_index_hdr_t*)(meta);
+    size_t index_end   = idx_hdr->num_entries;
+    size_t index_start = idx_hdr->synced_entries;
+    if (index_start > index_end) {
+        index_start = 0;
+    }
+    size_t extent_num_entries = index_end - index_start;
+    job->idx_hdr    = idx_hdr;
+    job->synced_end = index_end;
 
     /* indices are stored in the superblock shared memory
      * created by the client, these are stored as index_t
-     * structs starting one page size offset into meta region */
+     * structs starting one page size offset into meta region,
+     * we only take the ones added since the last fsync */
     char* ptr_extents = meta + page_sz;
-    unifyfs_index_t* meta_payload = (unifyfs_index_t*)(ptr_extents);
+    unifyfs_index_t* meta_payload =
+        (unifyfs_index_t*)(ptr_extents) + index_start;
 
     /* allocate storage for file extent key/values */
-    /* TODO: possibly get this from memory pool */
-    unifyfs_keys     = alloc_key_array(extent_num_entries);
-    unifyfs_vals     = alloc_value_array(extent_num_entries);
-    unifyfs_key_lens = calloc(extent_num_entries, sizeof(int));
-    unifyfs_val_lens = calloc(extent_num_entries, sizeof(int));
-    if ((NULL == unifyfs_keys) ||
-        (NULL == unifyfs_vals) ||
-        (NULL == unifyfs_key_lens) ||
-        (NULL == unifyfs_val_lens)) {
+    job->num_extents = extent_num_entries;
+    job->keys        = alloc_key_array(extent_num_entries);
+    job->vals        = alloc_value_array(extent_num_entries);
+    job->key_lens    = calloc(extent_num_entries, sizeof(int));
+    job->val_lens    = calloc(extent_num_entries, sizeof(int));
+    if ((NULL == job->keys) ||
+        (NULL == job->vals) ||
+        (NULL == job->key_lens) ||
+        (NULL == job->val_lens)) {
         LOGERR("failed to allocate memory for file extents");
-        ret = (int)UNIFYFS_ERROR_NOMEM;
-        goto rm_cmd_fsync_exit;
+        fsync_job_free(job);
+        return (int)UNIFYFS_ERROR_NOMEM;
     }
 
     /* create file extent key/values for insertion into MDHIM */
     for (i = 0; i < extent_num_entries; i++) {
         /* for a key, we store the global file id and logical file offset */
-        unifyfs_key_t* key = unifyfs_keys[i];
+        unifyfs_key_t* key = job->keys[i];
         key->fid    = meta_payload[i].fid;
         key->offset = meta_payload[i].file_pos;
 
         /* for the value, we store the log position, the length,
          * the host server (delegator rank), the mount point id (app id),
          * and the client id (rank) */
-        unifyfs_val_t* val = unifyfs_vals[i];
+        unifyfs_val_t* val = job->vals[i];
         val->addr           = meta_payload[i].log_pos;
         val->len            = meta_payload[i].length;
         val->delegator_rank = glb_pmi_rank;
         val->app_id         = app_id;
         val->rank           = client_side_id;
 
-        LOGDBG("extent - fid:%d, offset:%zu, length:%zu, app:%d, clid:%d",
-               key->fid, key->offset,
+        LOGDBG("extent - fid:%" PRIu64 ", offset:%zu, length:%zu, "
+               "app:%d, clid:%d", key->fid, key->offset,
                val->len, val->app_id, val->rank);
 
         /* MDHIM needs to know the byte size of each key and value */
-        unifyfs_key_lens[i] = sizeof(unifyfs_key_t);
-        unifyfs_val_lens[i] = sizeof(unifyfs_val_t);
-    }
-
-    /* batch insert file extent key/values into MDHIM */
-    ret = unifyfs_set_file_extents((int)extent_num_entries,
-                                   unifyfs_keys, unifyfs_key_lens,
-                                   unifyfs_vals, unifyfs_val_lens);
-    if (ret != UNIFYFS_SUCCESS) {
-        /* TODO: need proper error handling */
-        LOGERR("unifyfs_set_file_extents() failed");
-        goto rm_cmd_fsync_exit;
+        job->key_lens[i] = sizeof(unifyfs_key_t);
+        job->val_lens[i] = sizeof(unifyfs_val_t);
     }
 
     /* get number of file attribute values client has for us,
@@ -919,84 +1593,504 @@ int rm_cmd_fsync(int app_id, int client_side_id, int gfid)
     char* ptr_fattr = fmeta + page_sz;
     unifyfs_file_attr_t* attr_payload = (unifyfs_file_attr_t*)(ptr_fattr);
 
-    /* allocate storage for file attribute key/values */
-    /* TODO: possibly get this from memory pool */
-    fattr_keys     = alloc_attr_key_array(attr_num_entries);
-    fattr_vals     = calloc(attr_num_entries, sizeof(unifyfs_file_attr_t*));
-    fattr_key_lens = calloc(attr_num_entries, sizeof(int));
-    fattr_val_lens = calloc(attr_num_entries, sizeof(int));
-    if ((NULL == fattr_keys) ||
-        (NULL == fattr_vals) ||
-        (NULL == fattr_key_lens) ||
-        (NULL == fattr_val_lens)) {
+    /* allocate storage for file attribute key/values, we copy the
+     * attributes since the client may modify them once we return */
+    job->num_attrs     = attr_num_entries;
+    job->attr_keys     = alloc_attr_key_array(attr_num_entries);
+    job->attrs         = calloc(attr_num_entries,
+                                sizeof(unifyfs_file_attr_t));
+    job->attr_vals     = calloc(attr_num_entries,
+                                sizeof(unifyfs_file_attr_t*));
+    job->attr_key_lens = calloc(attr_num_entries, sizeof(int));
+    job->attr_val_lens = calloc(attr_num_entries, sizeof(int));
+    if ((NULL == job->attr_keys) ||
+        (NULL == job->attrs) ||
+        (NULL == job->attr_vals) ||
+        (NULL == job->attr_key_lens) ||
+        (NULL == job->attr_val_lens)) {
         LOGERR("failed to allocate memory for file attributes");
-        ret = (int)UNIFYFS_ERROR_NOMEM;
-        goto rm_cmd_fsync_exit;
+        fsync_job_free(job);
+        return (int)UNIFYFS_ERROR_NOMEM;
     }
+    memcpy(job->attrs, attr_payload,
+           attr_num_entries * sizeof(unifyfs_file_attr_t));
 
     /* create file attribute key/values for insertion into MDHIM */
     for (i = 0; i < attr_num_entries; i++) {
         /* for a key, we use the global file id */
-        *fattr_keys[i] = attr_payload[i].gfid;
+        *(job->attr_keys[i]) = job->attrs[i].gfid;
 
         /* for the value, we'll store a file_attr structure */
-        fattr_vals[i] = &(attr_payload[i]);
+        job->attr_vals[i] = &(job->attrs[i]);
 
         /* MDHIM needs to know the byte size of each key and value */
-        fattr_key_lens[i] = sizeof(fattr_key_t);
-        fattr_val_lens[i] = sizeof(unifyfs_file_attr_t);
+        job->attr_key_lens[i] = sizeof(fattr_key_t);
+        job->attr_val_lens[i] = sizeof(unifyfs_file_attr_t);
+    }
+
+    *pjob = job;
+    return (int)UNIFYFS_SUCCESS;
+}
+
+/* tell all other servers to drop their cached extents of the files
+ * with new extents in an fsync job, only needed when servers cache
+ * extents of unlaminated files (meta.extent_cache_ttl) */
+static int rm_invalidate_peer_extents(fsync_job_t* job)
+{
+    int ret = (int)UNIFYFS_SUCCESS;
+    size_t i, j;
+    hg_return_t hret;
+
+    size_t num_peers = (glb_num_servers > 0) ? (glb_num_servers - 1) : 0;
+    if ((0 == num_peers) || (0 == job->num_extents)) {
+        return ret;
+    }
+
+    /* collect distinct files, an fsync covers few files */
+    uint64_t* gfids = (uint64_t*) calloc(job->num_extents, sizeof(uint64_t));
+    hg_handle_t* handles = (hg_handle_t*)
+        calloc(num_peers, sizeof(hg_handle_t));
+    margo_request* reqs = (margo_request*)
+        calloc(num_peers, sizeof(margo_request));
+    if ((NULL == gfids) || (NULL == handles) || (NULL == reqs)) {
+        free(gfids);
+        free(handles);
+        free(reqs);
+        return (int)UNIFYFS_ERROR_NOMEM;
+    }
+    size_t num_gfids = 0;
+    for (i = 0; i < job->num_extents; i++) {
+        uint64_t gfid = job->keys[i]->fid;
+        for (j = 0; j < num_gfids; j++) {
+            if (gfids[j] == gfid) {
+                break;
+            }
+        }
+        if (j == num_gfids) {
+            gfids[num_gfids++] = gfid;
+        }
+    }
+
+    extents_invalidate_in_t in;
+    in.src_rank = (int32_t)glb_pmi_rank;
+    in.num_gfids = (int32_t)num_gfids;
+    in.bulk_size = (hg_size_t)(num_gfids * sizeof(uint64_t));
+    void* buf = (void*)gfids;
+    hret = margo_bulk_create(unifyfsd_rpc_context->svr_mid, 1,
+                             &buf, &in.bulk_size,
+                             HG_BULK_READ_ONLY, &in.bulk_handle);
+    if (hret != HG_SUCCESS) {
+        LOGERR("failed to register extents-invalidate buffer");
+        free(gfids);
+        free(handles);
+        free(reqs);
+        return (int)UNIFYFS_FAILURE;
+    }
+
+    /* send to all other servers at once */
+    size_t n = 0;
+    for (i = 0; i < glb_num_servers; i++) {
+        if ((int)i == glb_pmi_rank) {
+            continue;
+        }
+        hret = margo_create(unifyfsd_rpc_context->svr_mid,
+                            glb_servers[i].margo_svr_addr,
+                            unifyfsd_rpc_context->rpcs.extents_invalidate_id,
+                            &(handles[n]));
+        if (hret != HG_SUCCESS) {
+            LOGERR("failed to create extents-invalidate rpc for server %zu",
+                   i);
+            ret = (int)UNIFYFS_FAILURE;
+            continue;
+        }
+        hret = margo_iforward(handles[n], &in, &(reqs[n]));
+        if (hret != HG_SUCCESS) {
+            LOGERR("failed to forward extents-invalidate rpc to server %zu",
+                   i);
+            margo_destroy(handles[n]);
+            ret = (int)UNIFYFS_FAILURE;
+            continue;
+        }
+        n++;
+    }
+
+    for (i = 0; i < n; i++) {
+        hret = margo_wait(reqs[i]);
+        if (hret == HG_SUCCESS) {
+            extents_invalidate_out_t out;
+            hret = margo_get_output(handles[i], &out);
+            if (hret == HG_SUCCESS) {
+                if (out.ret != (int32_t)UNIFYFS_SUCCESS) {
+                    ret = (int)out.ret;
+                }
+                margo_free_output(handles[i], &out);
+            }
+        }
+        if (hret != HG_SUCCESS) {
+            LOGERR("extents-invalidate rpc failed");
+            ret = (int)UNIFYFS_FAILURE;
+        }
+        margo_destroy(handles[i]);
+    }
+
+    margo_bulk_free(in.bulk_handle);
+    free(gfids);
+    free(handles);
+    free(reqs);
+    return ret;
+}
+
+/* insert the extents of an fsync job into the key-value store in
+ * batches of RM_FSYNC_BATCH_SIZE, followed by its file attributes,
+ * then drop the extents other servers cached for its files */
+static int fsync_job_publish(fsync_job_t* job)
+{
+    int ret;
+    size_t off;
+
+    /* batch insert file extent key/values into MDHIM */
+    for (off = 0; off < job->num_extents; off += RM_FSYNC_BATCH_SIZE) {
+        size_t cnt = job->num_extents - off;
+        if (cnt > RM_FSYNC_BATCH_SIZE) {
+            cnt = RM_FSYNC_BATCH_SIZE;
+        }
+        ret = unifyfs_set_file_extents((int)cnt,
+                                       job->keys + off, job->key_lens + off,
+                                       job->vals + off, job->val_lens + off);
+        if (ret != UNIFYFS_SUCCESS) {
+            /* TODO: need proper error handling */
+            LOGERR("unifyfs_set_file_extents() failed");
+            return ret;
+        }
     }
 
     /* batch insert file attribute key/values into MDHIM */
-    ret = unifyfs_set_file_attributes((int)attr_num_entries,
-                                      fattr_keys, fattr_key_lens,
-                                      fattr_vals, fattr_val_lens);
-    if (ret != UNIFYFS_SUCCESS) {
-        /* TODO: need proper error handling */
-        LOGERR("unifyfs_set_file_attributes() failed");
-        goto rm_cmd_fsync_exit;
+    if (job->num_attrs > 0) {
+        ret = unifyfs_set_file_attributes((int)job->num_attrs,
+                                          job->attr_keys, job->attr_key_lens,
+                                          job->attr_vals, job->attr_val_lens);
+        if (ret != UNIFYFS_SUCCESS) {
+            /* TODO: need proper error handling */
+            LOGERR("unifyfs_set_file_attributes() failed");
+            return ret;
+        }
+    }
+
+    /* other servers may hold extents of these files in their cache,
+     * the extents are already stored, so a failure to reach them
+     * does not fail the fsync */
+    if (unifyfs_caches_unlaminated_extents()) {
+        ret = rm_invalidate_peer_extents(job);
+        if (ret != UNIFYFS_SUCCESS) {
+            LOGERR("failed to invalidate cached extents on other servers"
+                   " - rc=%d", ret);
+        }
+    }
+
+    return (int)UNIFYFS_SUCCESS;
+}
+
+/* returns 1 if a job for the given client is queued or being
+ * published, client_id of -1 matches any client,
+ * caller must hold fsync_mgr.sync */
+static int fsync_job_pending(int app_id, int client_id)
+{
+    fsync_job_t* job = fsync_mgr.active;
+    if ((NULL != job) &&
+        ((client_id < 0) ||
+         ((job->app_id == app_id) && (job->client_id == client_id)))) {
+        return 1;
+    }
+    for (job = fsync_mgr.head; NULL != job; job = job->next) {
+        if ((client_id < 0) ||
+            ((job->app_id == app_id) && (job->client_id == client_id))) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* fsync thread main, publishes queued jobs until told to exit,
+ * and drains the queue before exiting */
+static void* rm_fsync_thread(void* arg)
+{
+    pthread_mutex_lock(&(fsync_mgr.sync));
+    while (1) {
+        while ((NULL == fsync_mgr.head) && !fsync_mgr.time_to_exit) {
+            pthread_cond_wait(&(fsync_mgr.cond), &(fsync_mgr.sync));
+        }
+
+        /* take next job off queue, we only get here with an
+         * empty queue once we've been told to exit */
+        fsync_job_t* job = fsync_mgr.head;
+        if (NULL == job) {
+            break;
+        }
+        fsync_mgr.head = job->next;
+        if (NULL == fsync_mgr.head) {
+            fsync_mgr.tail = NULL;
+        }
+        fsync_mgr.active = job;
+        pthread_mutex_unlock(&(fsync_mgr.sync));
+
+        int rc = fsync_job_publish(job);
+
+        pthread_mutex_lock(&(fsync_mgr.sync));
+        fsync_mgr.active = NULL;
+        if ((rc != UNIFYFS_SUCCESS) &&
+            (++(job->attempts) < RM_FSYNC_MAX_ATTEMPTS)) {
+            /* the client has dropped these entries from its index,
+             * so this copy is the only one, put the job back at the
+             * head of the queue to retry it before any later job
+             * (whose extents may overwrite these) */
+            int attempts = job->attempts;
+            LOGERR("failed to publish fsync job of app_id=%d client=%d "
+                   "(attempt %d of %d)", job->app_id, job->client_id,
+                   attempts, RM_FSYNC_MAX_ATTEMPTS);
+            job->next = fsync_mgr.head;
+            fsync_mgr.head = job;
+            if (NULL == fsync_mgr.tail) {
+                fsync_mgr.tail = job;
+            }
+            pthread_mutex_unlock(&(fsync_mgr.sync));
+            usleep((useconds_t)(RM_FSYNC_RETRY_USEC * attempts));
+            pthread_mutex_lock(&(fsync_mgr.sync));
+            continue;
+        }
+        if (rc != UNIFYFS_SUCCESS) {
+            /* save error to be reported on next synchronous fsync */
+            app_config_t* app_config = (app_config_t*)
+                arraylist_get(app_config_list, job->app_id);
+            if (NULL != app_config) {
+                app_config->fsync_rc[job->client_id] = rc;
+            }
+        }
+        fsync_job_free(job);
+
+        /* wake anyone waiting for this job to complete */
+        pthread_cond_broadcast(&(fsync_mgr.cond));
+    }
+    pthread_mutex_unlock(&(fsync_mgr.sync));
+
+    LOGDBG("fsync thread exiting");
+    return NULL;
+}
+
+/* launch the fsync thread */
+int rm_fsync_init(void)
+{
+    memset(&fsync_mgr, 0, sizeof(fsync_mgr));
+
+    int rc = pthread_mutex_init(&(fsync_mgr.sync), NULL);
+    if (rc != 0) {
+        LOGERR("failed to initialize fsync mutex!");
+        return (int)UNIFYFS_ERROR_THRDINIT;
     }
 
-rm_cmd_fsync_exit:
-    /* clean up memory */
+    rc = pthread_cond_init(&(fsync_mgr.cond), NULL);
+    if (rc != 0) {
+        LOGERR("failed to initialize fsync condition variable!");
+        pthread_mutex_destroy(&(fsync_mgr.sync));
+        return (int)UNIFYFS_ERROR_THRDINIT;
+    }
+
+    rc = pthread_create(&(fsync_mgr.thrd), NULL, rm_fsync_thread, NULL);
+    if (rc != 0) {
+        LOGERR("failed to create fsync thread");
+        pthread_cond_destroy(&(fsync_mgr.cond));
+        pthread_mutex_destroy(&(fsync_mgr.sync));
+        return (int)UNIFYFS_ERROR_THRDINIT;
+    }
+
+    fsync_mgr.initialized = 1;
+    return (int)UNIFYFS_SUCCESS;
+}
+
+/* publish any queued fsync jobs, then join the fsync thread */
+int rm_fsync_fini(void)
+{
+    if (fsync_mgr.initialized) {
+        pthread_mutex_lock(&(fsync_mgr.sync));
+        fsync_mgr.time_to_exit = 1;
+        pthread_cond_broadcast(&(fsync_mgr.cond));
+        pthread_mutex_unlock(&(fsync_mgr.sync));
+
+        pthread_join(fsync_mgr.thrd, NULL);
 
-    if (NULL != unifyfs_keys) {
-        free_key_array(unifyfs_keys);
+        pthread_cond_destroy(&(fsync_mgr.cond));
+        pthread_mutex_destroy(&(fsync_mgr.sync));
+        fsync_mgr.initialized = 0;
     }
+    return (int)UNIFYFS_SUCCESS;
+}
 
-    if (NULL != unifyfs_vals) {
-        free_value_array(unifyfs_vals);
+/* wait until all asynchronous fsync jobs for the given client have
+ * been published, client_id of -1 waits for all clients */
+int rm_fsync_wait(int app_id, int client_id)
+{
+    if (fsync_mgr.initialized) {
+        pthread_mutex_lock(&(fsync_mgr.sync));
+        while (fsync_job_pending(app_id, client_id)) {
+            pthread_cond_wait(&(fsync_mgr.cond), &(fsync_mgr.sync));
+        }
+        pthread_mutex_unlock(&(fsync_mgr.sync));
     }
+    return (int)UNIFYFS_SUCCESS;
+}
 
-    if (NULL != unifyfs_key_lens) {
-        free(unifyfs_key_lens);
+/* wait until the asynchronous fsyncs of an app queued at this server
+ * and at all other servers have been published, the other servers
+ * are asked to flush in parallel with fsync_flush_rpc */
+int rm_fsync_flush_all(int app_id)
+{
+    int ret = (int)UNIFYFS_SUCCESS;
+    size_t i;
+    hg_return_t hret;
+
+    size_t num_peers = (glb_num_servers > 0) ? (glb_num_servers - 1) : 0;
+    hg_handle_t* handles = NULL;
+    margo_request* reqs = NULL;
+    if (num_peers > 0) {
+        handles = (hg_handle_t*) calloc(num_peers, sizeof(hg_handle_t));
+        reqs = (margo_request*) calloc(num_peers, sizeof(margo_request));
+        if ((NULL == handles) || (NULL == reqs)) {
+            free(handles);
+            free(reqs);
+            return (int)UNIFYFS_ERROR_NOMEM;
+        }
     }
 
-    if (NULL != unifyfs_val_lens) {
-        free(unifyfs_val_lens);
+    /* start the flush at the other servers */
+    fsync_flush_in_t in;
+    in.src_rank = (int32_t)glb_pmi_rank;
+    in.app_id = (int32_t)app_id;
+    size_t n = 0;
+    for (i = 0; i < glb_num_servers; i++) {
+        if ((int)i == glb_pmi_rank) {
+            continue;
+        }
+        hret = margo_create(unifyfsd_rpc_context->svr_mid,
+                            glb_servers[i].margo_svr_addr,
+                            unifyfsd_rpc_context->rpcs.fsync_flush_id,
+                            &(handles[n]));
+        if (hret != HG_SUCCESS) {
+            LOGERR("failed to create fsync-flush rpc for server %zu", i);
+            ret = (int)UNIFYFS_FAILURE;
+            continue;
+        }
+        hret = margo_iforward(handles[n], &in, &(reqs[n]));
+        if (hret != HG_SUCCESS) {
+            LOGERR("failed to forward fsync-flush rpc to server %zu", i);
+            margo_destroy(handles[n]);
+            ret = (int)UNIFYFS_FAILURE;
+            continue;
+        }
+        n++;
+    }
+
+    /* flush our own queue while the others work */
+    rm_fsync_wait(app_id, -1);
+
+    for (i = 0; i < n; i++) {
+        hret = margo_wait(reqs[i]);
+        if (hret == HG_SUCCESS) {
+            fsync_flush_out_t out;
+            hret = margo_get_output(handles[i], &out);
+            if (hret == HG_SUCCESS) {
+                if (out.ret != (int32_t)UNIFYFS_SUCCESS) {
+                    ret = (int)out.ret;
+                }
+                margo_free_output(handles[i], &out);
+            }
+        }
+        if (hret != HG_SUCCESS) {
+            LOGERR("fsync-flush rpc failed");
+            ret = (int)UNIFYFS_FAILURE;
+        }
+        margo_destroy(handles[i]);
     }
 
-    if (NULL != fattr_keys) {
-        free_attr_key_array(fattr_keys);
+    free(handles);
+    free(reqs);
+    return ret;
+}
+
+/* return and clear any error from publishing asynchronous
+ * fsync jobs of the given client */
+static int fsync_take_error(int app_id, int client_id)
+{
+    int ret = (int)UNIFYFS_SUCCESS;
+    app_config_t* app_config = (app_config_t*)
+        arraylist_get(app_config_list, app_id);
+    if (NULL != app_config) {
+        pthread_mutex_lock(&(fsync_mgr.sync));
+        ret = app_config->fsync_rc[client_id];
+        app_config->fsync_rc[client_id] = (int)UNIFYFS_SUCCESS;
+        pthread_mutex_unlock(&(fsync_mgr.sync));
     }
+    return ret;
+}
 
-    if (NULL != fattr_vals) {
-        free(fattr_vals);
+/*
+ * synchronize all the indices and file attributes
+ * to the key-value store
+ *
+ * @param app_id: the application id
+ * @param client_side_id: client rank in app
+ * @param gfid: global file id
+ * @param async: if set, return once the indices and file attributes
+ *               have been copied, and publish them in the background
+ * @return success/error code
+ */
+int rm_cmd_fsync(int app_id, int client_side_id, uint64_t gfid, int async)
+{
+    /* copy indices and file attributes out of client superblock */
+    fsync_job_t* job = NULL;
+    int ret = fsync_job_create(app_id, client_side_id, &job);
+    if (ret != UNIFYFS_SUCCESS) {
+        return ret;
     }
 
-    if (NULL != fattr_key_lens) {
-        free(fattr_key_lens);
+    if (async && fsync_mgr.initialized) {
+        /* we hold a copy of these entries now, so the client
+         * may drop them from its index, the fsync thread retries
+         * the job if publishing it fails and reports the error on
+         * the next synchronous fsync if it keeps failing */
+        job->idx_hdr->synced_entries = job->synced_end;
+
+        /* hand job to fsync thread */
+        pthread_mutex_lock(&(fsync_mgr.sync));
+        if (NULL == fsync_mgr.tail) {
+            fsync_mgr.head = job;
+        } else {
+            fsync_mgr.tail->next = job;
+        }
+        fsync_mgr.tail = job;
+        pthread_cond_broadcast(&(fsync_mgr.cond));
+        pthread_mutex_unlock(&(fsync_mgr.sync));
+        return (int)UNIFYFS_SUCCESS;
     }
 
-    if (NULL != fattr_val_lens) {
-        free(fattr_val_lens);
+    /* a synchronous fsync acts as a barrier for earlier
+     * asynchronous ones, so they must be published first */
+    rm_fsync_wait(app_id, client_side_id);
+    ret = fsync_take_error(app_id, client_side_id);
+
+    int rc = fsync_job_publish(job);
+    if (rc == UNIFYFS_SUCCESS) {
+        /* entries are in the key-value store, so the client may
+         * drop them, on failure they are sent again next time */
+        job->idx_hdr->synced_entries = job->synced_end;
+    } else if (ret == UNIFYFS_SUCCESS) {
+        ret = rc;
     }
+    fsync_job_free(job);
 
     return ret;
 }
 
 /************************
- * These functions define the logic of the request manager thread
+ * These functions define the logic of the request manager workers
  ***********************/
 
 /* pack the chunk read requests for a single remote delegator.
@@ -1016,11 +2110,10 @@ static size_t rm_pack_chunk_requests(char* req_msg_buf,
     size_t reqs_sz = req_cnt * sizeof(chunk_read_req_t);
     size_t packed_size = (2 * sizeof(int)) + sizeof(size_t) + reqs_sz;
 
-    assert(req_cnt < MAX_META_PER_SEND);
+    assert(req_cnt <= MAX_META_PER_SEND);
 
-    /* get pointer to start of send buffer */
+    /* get pointer to start of send buffer, all bytes are set below */
     char* ptr = req_msg_buf;
-    memset(ptr, 0, packed_size);
 
     /* pack command */
     int cmd = (int)SVC_CMD_RDREQ_CHK;
@@ -1043,102 +2136,199 @@ static size_t rm_pack_chunk_requests(char* req_msg_buf,
     return packed_size;
 }
 
-/* send the chunk read requests to remote delegators
+/* complete a chunk-read window whose requests could not be served
+ * by posting an error response for each chunk, so the read fails
+ * instead of waiting on responses that will never arrive
  *
- * @param thrd_ctrl : reqmgr thread control structure
+ * @param thrd_ctrl  : client request manager state
+ * @param req_ndx    : index of read request
+ * @param remote_ndx : index of remote delegator reads in read request
+ * @param errcode    : error returned to the client for each chunk
  * @return success/error code
  */
-static int rm_request_remote_chunks(reqmgr_thrd_t* thrd_ctrl)
+static int rm_fail_remote_chunks(reqmgr_thrd_t* thrd_ctrl,
+                                 int req_ndx,
+                                 int remote_ndx,
+                                 int errcode)
 {
-    // NOTE: this fn assumes thrd_ctrl->thrd_lock is locked
+    RM_LOCK(thrd_ctrl);
 
-    int i, j, rc;
-    int ret = (int)UNIFYFS_SUCCESS;
+    server_read_req_t* req = thrd_ctrl->read_reqs + req_ndx;
+    if (thrd_ctrl->exit_flag ||
+        (remote_ndx >= req->num_remote_reads) ||
+        (req->remote_reads[remote_ndx].status != READREQ_STARTED)) {
+        /* client is gone or responses were already handled */
+        RM_UNLOCK(thrd_ctrl);
+        return (int)UNIFYFS_SUCCESS;
+    }
 
-    /* get pointer to send buffer */
-    char* sendbuf = thrd_ctrl->del_req_msg_buf;
-
-    /* iterate over each active read request */
-    for (i = 0; i < RM_MAX_ACTIVE_REQUESTS; i++) {
-        server_read_req_t* req = thrd_ctrl->read_reqs + i;
-        if (req->num_remote_reads > 0) {
-            LOGDBG("read req %d is active", i);
-            debug_print_read_req(req);
-            if (req->status == READREQ_INIT) {
-                req->status = READREQ_STARTED;
-                /* iterate over each delegator we need to send requests to */
-                remote_chunk_reads_t* remote_reads;
-                size_t packed_sz;
-                for (j = 0; j < req->num_remote_reads; j++) {
-                    remote_reads = req->remote_reads + j;
-                    remote_reads->status = READREQ_STARTED;
-
-                    /* pack requests into send buffer, get packed size */
-                    packed_sz = rm_pack_chunk_requests(sendbuf, remote_reads);
-
-                    /* get rank of target delegator */
-                    int del_rank = remote_reads->rank;
-
-                    /* send requests */
-                    LOGDBG("[%d of %d] sending %d chunk requests to server %d",
-                           j, req->num_remote_reads,
-                           remote_reads->num_chunks, del_rank);
-                    rc = invoke_chunk_read_request_rpc(del_rank, req,
-                                                       remote_reads->num_chunks,
-                                                       sendbuf, packed_sz);
-                    if (rc != (int)UNIFYFS_SUCCESS) {
-                        ret = rc;
-                        LOGERR("server request rpc to %d failed - %s",
-                               del_rank,
-                               unifyfs_error_enum_str((unifyfs_error_e)rc));
-                    }
-                }
-            } else {
-                /* already started */
-                LOGDBG("read req %d already processed", i);
-            }
+    /* responses are laid out as if data had been returned, so the
+     * response handler walks the buffer as usual */
+    remote_chunk_reads_t* remote_reads = req->remote_reads + remote_ndx;
+    int num_chunks = remote_reads->num_chunks;
+    size_t resp_sz = (num_chunks * sizeof(chunk_read_resp_t)) +
+                     remote_reads->total_sz;
+    chunk_read_resp_t* resp = (chunk_read_resp_t*) bufpool_alloc(resp_sz);
+    if (NULL == resp) {
+        LOGERR("failed to allocate chunk read error responses");
+        RM_UNLOCK(thrd_ctrl);
+        return (int)UNIFYFS_ERROR_NOMEM;
+    }
+    memset(resp, 0, num_chunks * sizeof(chunk_read_resp_t));
+
+    int i;
+    for (i = 0; i < num_chunks; i++) {
+        chunk_read_req_t* rreq = remote_reads->reqs + i;
+        resp[i].gfid = rreq->gfid;
+        resp[i].offset = rreq->offset;
+        resp[i].nbytes = rreq->nbytes;
+        resp[i].read_rc = (ssize_t)(-errcode);
+        resp[i].log_app_id = -1;
+        resp[i].log_client_id = -1;
+    }
+    int app_id = req->app_id;
+    int client_id = req->client_id;
+    int del_rank = remote_reads->rank;
+    int req_id = RM_CHUNK_READS_ID(req_ndx, remote_ndx);
+
+    RM_UNLOCK(thrd_ctrl);
+
+    int rc = rm_post_chunk_read_responses(app_id, client_id, del_rank,
+                                          req_id, num_chunks, resp_sz,
+                                          (char*)resp);
+    if (rc != (int)UNIFYFS_SUCCESS) {
+        bufpool_free(resp);
+    }
+    return rc;
+}
+
+/* send the chunk read requests of a read request to one
+ * remote delegator
+ *
+ * The worker running this task is held for the full request rpc,
+ * which returns only after the remote server has read the chunks and
+ * pushed the responses. This bounds the remote reads in flight to
+ * the number of workers, at the cost of a worker per outstanding
+ * window; the windows of a read request are already limited to
+ * RECV_BUF_CNT per remote server (see wait_chunk_window).
+ *
+ * If the rpc fails, the window is completed with an error response
+ * for each chunk so the client read fails rather than timing out.
+ *
+ * @param thrd_ctrl  : client request manager state
+ * @param req_ndx    : index of read request
+ * @param remote_ndx : index of remote delegator reads in read request
+ * @return success/error code
+ */
+static int rm_request_remote_chunks(reqmgr_thrd_t* thrd_ctrl,
+                                    int req_ndx,
+                                    int remote_ndx)
+{
+    RM_LOCK(thrd_ctrl);
+
+    server_read_req_t* req = thrd_ctrl->read_reqs + req_ndx;
+    if (thrd_ctrl->exit_flag ||
+        (remote_ndx >= req->num_remote_reads) ||
+        (req->remote_reads[remote_ndx].status != READREQ_STARTED)) {
+        /* client is gone or request was released */
+        RM_UNLOCK(thrd_ctrl);
+        return (int)UNIFYFS_SUCCESS;
+    }
+    debug_print_read_req(req);
+
+    /* pack requests into a send buffer, the lock is not held while
+     * sending so each send gets its own buffer */
+    remote_chunk_reads_t* remote_reads = req->remote_reads + remote_ndx;
+    size_t packed_sz = (2 * sizeof(int)) + sizeof(size_t) +
+        (remote_reads->num_chunks * sizeof(chunk_read_req_t));
+    char* sendbuf = (char*) bufpool_alloc(packed_sz);
+    if (NULL == sendbuf) {
+        LOGERR("failed to allocate chunk requests buffer");
+        RM_UNLOCK(thrd_ctrl);
+        return (int)UNIFYFS_ERROR_NOMEM;
+    }
+    packed_sz = rm_pack_chunk_requests(sendbuf, remote_reads);
+
+    /* get rank of target delegator */
+    int del_rank = remote_reads->rank;
+    int num_chunks = remote_reads->num_chunks;
+
+    /* size of responses (headers and data) to this window */
+    size_t resp_sz = (num_chunks * sizeof(chunk_read_resp_t)) +
+                     remote_reads->total_sz;
+    LOGDBG("[%d of %d] sending %d chunk requests to server %d",
+           remote_ndx, req->num_remote_reads, num_chunks, del_rank);
+
+    RM_UNLOCK(thrd_ctrl);
+
+    /* send requests, the read request cannot be released before
+     * the responses to this send have been handled */
+    int rc = invoke_chunk_read_request_rpc(del_rank, req, remote_ndx,
+                                           num_chunks, sendbuf, packed_sz,
+                                           resp_sz);
+    if (rc != (int)UNIFYFS_SUCCESS) {
+        LOGERR("server request rpc to %d failed - %s",
+               del_rank, unifyfs_error_enum_str((unifyfs_error_e)rc));
+        int fail_rc = rm_fail_remote_chunks(thrd_ctrl, req_ndx,
+                                            remote_ndx, EIO);
+        if (fail_rc != (int)UNIFYFS_SUCCESS) {
+            LOGERR("failed to post chunk read errors for window %d",
+                   remote_ndx);
         }
     }
+    bufpool_free(sendbuf);
 
-    return ret;
+    return rc;
 }
 
-/* send the chunk read requests to remote delegators
+/* process the chunk read responses of a read request from one
+ * remote delegator
  *
- * @param thrd_ctrl : reqmgr thread control structure
+ * @param thrd_ctrl  : client request manager state
+ * @param req_ndx    : index of read request
+ * @param remote_ndx : index of remote delegator reads in read request
  * @return success/error code
  */
-static int rm_process_remote_chunk_responses(reqmgr_thrd_t* thrd_ctrl)
+static int rm_process_remote_chunk_responses(reqmgr_thrd_t* thrd_ctrl,
+                                             int req_ndx,
+                                             int remote_ndx)
 {
-    // NOTE: this fn assumes thrd_ctrl->thrd_lock is locked
+    int rc = (int)UNIFYFS_SUCCESS;
+    remote_chunk_reads_t* rcr = NULL;
 
-    int i, j, rc;
-    int ret = (int)UNIFYFS_SUCCESS;
+    /* writers of the client recv buffer go one at a time, the client
+     * lock is dropped by the handler while it waits on the client */
+    pthread_mutex_lock(&(thrd_ctrl->shm_lock));
+    RM_LOCK(thrd_ctrl);
 
-    /* iterate over each active read request */
-    for (i = 0; i < RM_MAX_ACTIVE_REQUESTS; i++) {
-        server_read_req_t* req = thrd_ctrl->read_reqs + i;
-        if ((req->num_remote_reads > 0) &&
-            (req->status == READREQ_STARTED)) {
-            /* iterate over each delegator we need to send requests to */
-            remote_chunk_reads_t* rcr;
-            for (j = 0; j < req->num_remote_reads; j++) {
-                rcr = req->remote_reads + j;
-                if (NULL == rcr->resp) {
-                    continue;
-                }
-                LOGDBG("found read req %d responses from delegator %d",
-                       i, rcr->rank);
-                rc = rm_handle_chunk_read_responses(thrd_ctrl, req, rcr);
-                if (rc != (int)UNIFYFS_SUCCESS) {
-                    LOGERR("failed to handle chunk read responses");
-                    ret = rc;
-                }
-            }
+    server_read_req_t* req = thrd_ctrl->read_reqs + req_ndx;
+    if (remote_ndx < req->num_remote_reads) {
+        rcr = req->remote_reads + remote_ndx;
+        if (NULL == rcr->resp) {
+            rcr = NULL;
+        } else if (thrd_ctrl->exit_flag) {
+            /* client is gone, drop the data */
+            bufpool_free(rcr->resp);
+            rcr->resp = NULL;
+            rcr = NULL;
+        } else {
+            LOGDBG("found read req %d responses from delegator %d",
+                   req_ndx, rcr->rank);
         }
     }
 
-    return ret;
+    RM_UNLOCK(thrd_ctrl);
+
+    if (NULL != rcr) {
+        rc = rm_handle_chunk_read_responses(thrd_ctrl, req, rcr);
+        if (rc != (int)UNIFYFS_SUCCESS) {
+            LOGERR("failed to handle chunk read responses");
+        }
+    }
+
+    pthread_mutex_unlock(&(thrd_ctrl->shm_lock));
+
+    return rc;
 }
 
 /* signal the client process for it to start processing read
@@ -1151,79 +2341,398 @@ static int client_signal(shm_header_t* hdr,
     } else if (flag == SHMEM_REGION_DATA_COMPLETE) {
         LOGDBG("setting data-complete");
     }
-    hdr->state = flag;
-    /* TODO: MEM_FLUSH */
+    unifyfs_shm_set_state(hdr, flag);
     return UNIFYFS_SUCCESS;
 }
 
 /* wait until client has processed all read data in shared memory */
 static int client_wait(shm_header_t* hdr)
 {
-    int rc = (int)UNIFYFS_SUCCESS;
+    /* wait for client to set flag to 0 */
+    int rc = unifyfs_shm_wait_state(hdr, SHMEM_REGION_EMPTY, 1,
+                                    10000); // 10s
+    if (rc != (int)UNIFYFS_SUCCESS) {
+        LOGERR("timed out waiting for empty");
+    }
+
+    /* reset header to reflect empty state */
+    hdr->meta_cnt = 0;
+    hdr->bytes = 0;
+    return rc;
+}
 
-    /* specify time to sleep between checking flag in shared
-     * memory indicating client has processed data */
-    struct timespec shm_wait_tm;
-    shm_wait_tm.tv_sec  = 0;
-    shm_wait_tm.tv_nsec = SHM_WAIT_INTERVAL;
+/* returns header of the recv buffer slot currently being filled
+ * for the given client */
+static shm_header_t* current_recv_slot(app_config_t* app_config,
+                                       int client_id)
+{
+    return unifyfs_shm_recv_slot(app_config->shm_recv_bufs[client_id],
+                                 app_config->recv_buf_sz,
+                                 app_config->recv_buf_slots,
+                                 app_config->recv_slots[client_id]);
+}
 
-    /* wait for client to set flag to 0 */
-    int max_sleep = 10000000; // 10s
-    volatile int* vip = (volatile int*)&(hdr->state);
-    while (*vip != SHMEM_REGION_EMPTY) {
-        /* not there yet, sleep for a while */
-        nanosleep(&shm_wait_tm, NULL);
-        /* TODO: MEM_FETCH */
-        max_sleep--;
-        if (0 == max_sleep) {
-            LOGERR("timed out waiting for empty");
-            rc = (int)UNIFYFS_ERROR_SHMEM;
-            break;
+/* reserve space for a read reply and its data in the client recv
+ * buffer, the reply must fit in one slot (see put_shmem_reply for
+ * larger ones). When the current slot is full, it is handed to the client
+ * and we move on to the next slot, only waiting if the client has
+ * not yet drained that one. */
+static shm_meta_t* reserve_shmem_meta(app_config_t* app_config,
+                                      int client_id,
+                                      size_t data_sz)
+{
+    shm_meta_t* meta = NULL;
+    char* region = app_config->shm_recv_bufs[client_id];
+    if (NULL == region) {
+        LOGERR("invalid header");
+        return NULL;
+    }
+
+    /* first slot header lock protects the slot index for all slots */
+    shm_header_t* ring_hdr = (shm_header_t*)region;
+    pthread_mutex_lock(&(ring_hdr->sync));
+
+    size_t slot_sz = unifyfs_shm_recv_slot_size(app_config->recv_buf_sz,
+                                                app_config->recv_buf_slots);
+    size_t meta_size = sizeof(shm_meta_t) + data_sz;
+    if (meta_size > (slot_sz - sizeof(shm_header_t))) {
+        LOGERR("read reply of %zu bytes exceeds recv buffer slot size %zu",
+               data_sz, slot_sz);
+        pthread_mutex_unlock(&(ring_hdr->sync));
+        return NULL;
+    }
+
+    shm_header_t* hdr = current_recv_slot(app_config, client_id);
+    LOGDBG("shm_header[%d](cnt=%zu, bytes=%zu)",
+           app_config->recv_slots[client_id], hdr->meta_cnt, hdr->bytes);
+    size_t remain_size = slot_sz - (sizeof(shm_header_t) + hdr->bytes);
+    if (meta_size > remain_size) {
+        /* current slot is full, inform client to start reading */
+        LOGDBG("need more space in client recv buffer");
+        client_signal(hdr, SHMEM_REGION_DATA_READY);
+
+        /* advance to next slot, and wait for client to have read
+         * any data still in it */
+        app_config->recv_slots[client_id] =
+            (app_config->recv_slots[client_id] + 1) %
+            app_config->recv_buf_slots;
+        hdr = current_recv_slot(app_config, client_id);
+        int rc = client_wait(hdr);
+        if (rc != (int)UNIFYFS_SUCCESS) {
+            LOGERR("wait for client recv buffer space failed");
+            pthread_mutex_unlock(&(ring_hdr->sync));
+            return NULL;
+        }
+    }
+    size_t shm_offset = hdr->bytes;
+    char* shm_buf = ((char*)hdr) + sizeof(shm_header_t);
+    meta = (shm_meta_t*)(shm_buf + shm_offset);
+    LOGDBG("reserved shm_meta[%zu] and %zu payload bytes",
+           hdr->meta_cnt, data_sz);
+    hdr->meta_cnt++;
+    hdr->bytes += meta_size;
+    pthread_mutex_unlock(&(ring_hdr->sync));
+    return meta;
+}
+
+/* copy a read reply, and its data when data is not NULL, into the
+ * client recv buffer. A reply with more data than fits in one slot is
+ * split into replies for consecutive parts of its extent, so a read
+ * reply may be as large as the whole recv buffer allows over time.
+ *
+ * @param app_config : app config of client
+ * @param client_id  : client id
+ * @param reply      : reply to copy (offset, length, source, etc.)
+ * @param data       : reply data, or NULL if it has no payload
+ * @return success/error code
+ */
+static int put_shmem_reply(app_config_t* app_config,
+                           int client_id,
+                           const shm_meta_t* reply,
+                           const char* data)
+{
+    size_t slot_sz = unifyfs_shm_recv_slot_size(app_config->recv_buf_sz,
+                                                app_config->recv_buf_slots);
+    size_t hdr_sz = sizeof(shm_header_t) + sizeof(shm_meta_t);
+    if (slot_sz <= hdr_sz) {
+        LOGERR("recv buffer slot size %zu too small for read replies",
+               slot_sz);
+        return (int)UNIFYFS_ERROR_SHMEM;
+    }
+    size_t max_payload = slot_sz - hdr_sz;
+
+    size_t done = 0;
+    do {
+        size_t len = reply->length - done;
+        size_t payload_sz = 0;
+        if (NULL != data) {
+            if (len > max_payload) {
+                len = max_payload;
+            }
+            payload_sz = len;
+        }
+
+        shm_meta_t* shm_meta = reserve_shmem_meta(app_config, client_id,
+                                                  payload_sz);
+        if (NULL == shm_meta) {
+            LOGERR("failed to reserve shmem space for read reply");
+            return (int)UNIFYFS_ERROR_SHMEM;
+        }
+        *shm_meta = *reply;
+        shm_meta->offset = reply->offset + done;
+        shm_meta->length = len;
+        shm_meta->src_offset = reply->src_offset + done;
+        if (payload_sz) {
+            char* shm_buf = (char*)shm_meta + sizeof(shm_meta_t);
+            memcpy(shm_buf, data + done, payload_sz);
+        }
+        done += len;
+    } while (done < reply->length);
+
+    return (int)UNIFYFS_SUCCESS;
+}
+
+/* mark the slot being filled as the last for the current read, and
+ * wait for the client to drain it. Since the client drains slots in
+ * order, all slots are empty on return, so the next read for this
+ * client will start from the first slot. */
+static int complete_recv_slots(app_config_t* app_config,
+                               int client_id)
+{
+    int slot;
+    shm_header_t* hdr = current_recv_slot(app_config, client_id);
+
+    /* signal client that we're now done writing data */
+    client_signal(hdr, SHMEM_REGION_DATA_COMPLETE);
+
+    /* wait for client to read data */
+    int rc = client_wait(hdr);
+
+    /* reset all slots for next read */
+    for (slot = 0; slot < app_config->recv_buf_slots; slot++) {
+        hdr = unifyfs_shm_recv_slot(app_config->shm_recv_bufs[client_id],
+                                    app_config->recv_buf_sz,
+                                    app_config->recv_buf_slots, slot);
+        hdr->meta_cnt = 0;
+        hdr->bytes = 0;
+    }
+    app_config->recv_slots[client_id] = 0;
+
+    return rc;
+}
+
+/* look up the extents of a read-ahead window and start its chunk reads
+ *
+ * @param thrd_ctrl : client request manager state
+ * @param req_ndx   : index of prefetch read request
+ * @return success/error code
+ */
+static int rm_prefetch_window(reqmgr_thrd_t* thrd_ctrl, int req_ndx)
+{
+    RM_LOCK(thrd_ctrl);
+    server_read_req_t* rdreq = thrd_ctrl->read_reqs + req_ndx;
+    uint64_t gfid = rdreq->extent.gfid;
+    size_t offset = rdreq->extent.offset;
+    size_t length = rdreq->extent.length;
+    RM_UNLOCK(thrd_ctrl);
+
+    /* extents stored from here on make the window stale */
+    unsigned long meta_gen = unifyfs_get_extents_gen(gfid);
+
+    /* only data of laminated files is known not to change */
+    unifyfs_file_attr_t attr;
+    int rc = unifyfs_get_file_attribute(gfid, &attr);
+    if ((rc != UNIFYFS_SUCCESS) || !attr.is_laminated) {
+        LOGDBG("no read-ahead for unlaminated gfid=%" PRIu64, gfid);
+        RM_LOCK(thrd_ctrl);
+        if (gfid == thrd_ctrl->seq_gfid) {
+            /* do not ask again while the client reads this file */
+            thrd_ctrl->seq_unlaminated = 1;
+        }
+        ra_window_reset(thrd_ctrl->ra_wins + rdreq->ra_ndx);
+        release_read_req(thrd_ctrl, rdreq);
+        RM_UNLOCK(thrd_ctrl);
+        return (int)UNIFYFS_SUCCESS;
+    }
+
+    /* lookup all key/value pairs for window range */
+    unifyfs_key_t key1, key2;
+    key1.fid    = gfid;
+    key1.offset = offset;
+    key2.fid    = gfid;
+    key2.offset = offset + length - 1;
+    unifyfs_key_t* unifyfs_keys[2] = {&key1, &key2};
+    int key_lens[2] = {sizeof(unifyfs_key_t), sizeof(unifyfs_key_t)};
+    int num_vals = 0;
+    unifyfs_keyval_t* keyvals = NULL;
+    rc = unifyfs_get_file_extents(2, unifyfs_keys, key_lens,
+                                  &num_vals, &keyvals);
+
+    RM_LOCK(thrd_ctrl);
+
+    rm_ra_window_t* win = thrd_ctrl->ra_wins + rdreq->ra_ndx;
+    win->meta_gen = meta_gen;
+    if ((rc == UNIFYFS_SUCCESS) && (num_vals > 0) &&
+        !thrd_ctrl->exit_flag) {
+        win->data = (char*) bufpool_alloc(length);
+        win->chunks = (rm_ra_chunk_t*)
+            bufpool_alloc((size_t)num_vals * sizeof(rm_ra_chunk_t));
+        win->max_chunks = num_vals;
+        if ((NULL != win->data) && (NULL != win->chunks)) {
+            if (num_vals > 1) {
+                /* sort keyvals by delegator */
+                qsort(keyvals, (size_t)num_vals, sizeof(unifyfs_keyval_t),
+                      compare_kv_gfid_rank);
+            }
+            rc = create_chunk_requests(thrd_ctrl, rdreq, num_vals, keyvals);
+        } else {
+            rc = (int)UNIFYFS_ERROR_NOMEM;
+        }
+    } else if (rc != UNIFYFS_SUCCESS) {
+        /* nothing to prefetch, e.g., past the end of the file */
+        rc = (int)UNIFYFS_SUCCESS;
+        num_vals = 0;
+    }
+    if ((rc != (int)UNIFYFS_SUCCESS) || (0 == num_vals) ||
+        thrd_ctrl->exit_flag) {
+        /* an empty window is kept so the data is not looked up
+         * again until the client reads past it */
+        int stale = win->stale;
+        ra_window_reset(win);
+        if (!stale && (rc == (int)UNIFYFS_SUCCESS)) {
+            win->status   = READREQ_COMPLETE;
+            win->meta_gen = meta_gen;
+            win->gfid     = gfid;
+            win->offset   = offset;
+            win->length   = length;
         }
+        release_read_req(thrd_ctrl, rdreq);
+    }
+
+    RM_UNLOCK(thrd_ctrl);
+
+    if (NULL != keyvals) {
+        free(keyvals);
+    }
+    return rc;
+}
+
+/* add a chunk read response of a prefetch to its read-ahead window,
+ * data is NULL for data left in place in a local superblock */
+static void ra_store_chunk(rm_ra_window_t* win, chunk_read_resp_t* resp,
+                           size_t data_sz, char* data)
+{
+    if ((resp->read_rc < 0) || (win->num_chunks >= win->max_chunks) ||
+        (resp->offset < win->offset) ||
+        ((resp->offset + data_sz) > (win->offset + win->length))) {
+        /* reads of this data are not served from the window */
+        return;
+    }
+    rm_ra_chunk_t* chk = win->chunks + win->num_chunks++;
+    chk->offset        = resp->offset;
+    chk->nbytes        = data_sz;
+    chk->errcode       = 0;
+    chk->log_app_id    = resp->log_app_id;
+    chk->log_client_id = resp->log_client_id;
+    chk->log_offset    = resp->log_offset;
+    if (NULL != data) {
+        memcpy(win->data + (resp->offset - win->offset), data, data_sz);
     }
+}
 
-    /* reset header to reflect empty state */
-    hdr->meta_cnt = 0;
-    hdr->bytes = 0;
-    return rc;
+/* mark a read-ahead window whose chunk reads are all done as ready */
+static void ra_window_complete(rm_ra_window_t* win)
+{
+    win->status = READREQ_COMPLETE;
+    if (win->stale) {
+        ra_window_reset(win);
+        return;
+    }
+    if (win->num_chunks > 1) {
+        qsort(win->chunks, (size_t)win->num_chunks, sizeof(rm_ra_chunk_t),
+              compare_ra_chunk);
+    }
 }
 
-static shm_meta_t* reserve_shmem_meta(app_config_t* app_config,
-                                      shm_header_t* hdr,
-                                      size_t data_sz)
+/* copy the data of a client read from a read-ahead window to the
+ * client recv buffer. The client lock is not held while writing to
+ * and waiting on the recv buffer, the window stays valid while we
+ * are one of its users.
+ *
+ * @param thrd_ctrl : client request manager state
+ * @param req_ndx   : index of read request
+ * @return success/error code
+ */
+static int rm_serve_readahead(reqmgr_thrd_t* thrd_ctrl, int req_ndx)
 {
-    shm_meta_t* meta = NULL;
-    if (NULL == hdr) {
-        LOGERR("invalid header");
-    } else {
-        pthread_mutex_lock(&(hdr->sync));
-        LOGDBG("shm_header(cnt=%zu, bytes=%zu)", hdr->meta_cnt, hdr->bytes);
-        size_t remain_size = app_config->recv_buf_sz -
-                             (sizeof(shm_header_t) + hdr->bytes);
-        size_t meta_size = sizeof(shm_meta_t) + data_sz;
-        if (meta_size > remain_size) {
-            /* client-side receive buffer is full,
-             * inform client to start reading */
-            LOGDBG("need more space in client recv buffer");
-            client_signal(hdr, SHMEM_REGION_DATA_READY);
-
-            /* wait for client to read data */
-            int rc = client_wait(hdr);
+    int i;
+    int ret = (int)UNIFYFS_SUCCESS;
+
+    pthread_mutex_lock(&(thrd_ctrl->shm_lock));
+    RM_LOCK(thrd_ctrl);
+
+    server_read_req_t* rdreq = thrd_ctrl->read_reqs + req_ndx;
+    rm_ra_window_t* win = thrd_ctrl->ra_wins + rdreq->ra_ndx;
+    if (!thrd_ctrl->exit_flag) {
+        app_config_t* app_config = (app_config_t*)
+            arraylist_get(app_config_list, rdreq->app_id);
+        assert(NULL != app_config);
+
+        int client_id = rdreq->client_id;
+        uint64_t gfid = rdreq->extent.gfid;
+        size_t offset = rdreq->extent.offset;
+        size_t end = offset + rdreq->extent.length;
+        LOGDBG("serving read gfid=%" PRIu64 " offset=%zu length=%zu "
+               "from read-ahead window %d", gfid, offset,
+               rdreq->extent.length, rdreq->ra_ndx);
+        RM_UNLOCK(thrd_ctrl);
+        for (i = 0; i < win->num_chunks; i++) {
+            rm_ra_chunk_t* chk = win->chunks + i;
+            size_t chk_end = chk->offset + chk->nbytes;
+            if ((chk_end <= offset) || (chk->offset >= end)) {
+                continue;
+            }
+
+            /* part of chunk within read extent */
+            size_t start = (chk->offset > offset) ? chk->offset : offset;
+            size_t stop = (chk_end < end) ? chk_end : end;
+            size_t data_sz = stop - start;
+            size_t delta = start - chk->offset;
+            int in_place = (chk->log_client_id >= 0);
+
+            shm_meta_t reply;
+            reply.offset = start;
+            reply.length = data_sz;
+            reply.gfid = gfid;
+            reply.errcode = chk->errcode;
+            reply.src_app = chk->log_app_id;
+            reply.src_client = chk->log_client_id;
+            reply.src_offset = chk->log_offset + delta;
+            int rc = put_shmem_reply(app_config, client_id, &reply,
+                                     (in_place ? NULL :
+                                      (win->data + (start - win->offset))));
             if (rc != (int)UNIFYFS_SUCCESS) {
-                LOGERR("wait for client recv buffer space failed");
-                return NULL;
+                ret = rc;
             }
         }
-        size_t shm_offset = hdr->bytes;
-        char* shm_buf = ((char*)hdr) + sizeof(shm_header_t);
-        meta = (shm_meta_t*)(shm_buf + shm_offset);
-        LOGDBG("reserved shm_meta[%zu] and %zu payload bytes",
-               hdr->meta_cnt, data_sz);
-        hdr->meta_cnt++;
-        hdr->bytes += meta_size;
-        pthread_mutex_unlock(&(hdr->sync));
+
+        /* signal client that we're done, and wait for it
+         * to read remaining data */
+        complete_recv_slots(app_config, client_id);
+
+        RM_LOCK(thrd_ctrl);
     }
-    return meta;
+
+    win->users--;
+    if (win->stale && ra_window_idle(win)) {
+        ra_window_reset(win);
+    }
+    release_read_req(thrd_ctrl, rdreq);
+
+    RM_UNLOCK(thrd_ctrl);
+    pthread_mutex_unlock(&(thrd_ctrl->shm_lock));
+
+    return ret;
 }
 
 int rm_post_chunk_read_responses(int app_id,
@@ -1249,40 +2758,53 @@ int rm_post_chunk_read_responses(int app_id,
 
     RM_LOCK(thrd_ctrl);
 
-    /* find read req associated with req_id */
-    rdreq = thrd_ctrl->read_reqs + req_id;
-    for (int i = 0; i < rdreq->num_remote_reads; i++) {
-        if (rdreq->remote_reads[i].rank == src_rank) {
-            del_reads = rdreq->remote_reads + i;
-            break;
-        }
+    /* find read req and chunk-read window associated with req_id */
+    int req_ndx = RM_CHUNK_READS_REQ(req_id);
+    int win_ndx = RM_CHUNK_READS_WIN(req_id);
+    rdreq = thrd_ctrl->read_reqs + req_ndx;
+    if (!thrd_ctrl->exit_flag &&
+        (win_ndx < rdreq->num_remote_reads) &&
+        (rdreq->remote_reads[win_ndx].rank == src_rank) &&
+        (rdreq->remote_reads[win_ndx].status == READREQ_STARTED) &&
+        (NULL == rdreq->remote_reads[win_ndx].resp)) {
+        /* a window already holding responses (e.g., errors posted
+         * after a failed request rpc) does not take late ones, and
+         * nothing is queued for a client once it has unmounted */
+        del_reads = rdreq->remote_reads + win_ndx;
     }
     if (NULL != del_reads) {
-        LOGDBG("posting chunk responses for req %d from delegator %d",
-               req_id, src_rank);
+        LOGDBG("posting chunk responses for req %d window %d "
+               "from delegator %d", req_ndx, win_ndx, src_rank);
         del_reads->resp = (chunk_read_resp_t*)resp_buf;
         if (del_reads->num_chunks != num_chks) {
             LOGERR("mismatch on request vs. response chunks");
             del_reads->num_chunks = num_chks;
         }
         del_reads->total_sz = bulk_sz;
-        rc = (int)UNIFYFS_SUCCESS;
+
+        /* hand off the responses to the workers */
+        rc = rm_submit_task(RM_TASK_CHUNK_RESPONSES, thrd_ctrl,
+                            req_ndx, win_ndx);
+        if (rc != (int)UNIFYFS_SUCCESS) {
+            /* caller still owns the buffer */
+            del_reads->resp = NULL;
+        }
     } else {
         LOGERR("failed to find matching chunk-reads request");
         rc = (int)UNIFYFS_FAILURE;
     }
 
-    /* inform the request manager thread we added responses */
-    signal_new_responses(thrd_ctrl);
-
     RM_UNLOCK(thrd_ctrl);
 
     return rc;
 }
 
-/* process the requested chunk data returned from service managers
+/* process the requested chunk data returned from service managers,
+ * called with the client shm_lock held and its thrd_lock not held,
+ * the thrd_lock is only taken while request state is updated, not
+ * while writing to or waiting on the client recv buffer
  *
- * @param thrd_ctrl  : request manager thread state
+ * @param thrd_ctrl  : client request manager state
  * @param rdreq      : server read request
  * @param del_reads  : remote server chunk reads
  * @return success/error code
@@ -1291,44 +2813,59 @@ int rm_handle_chunk_read_responses(reqmgr_thrd_t* thrd_ctrl,
                                    server_read_req_t* rdreq,
                                    remote_chunk_reads_t* del_reads)
 {
-    int errcode, gfid, i, num_chks, rc, thrd_id;
+    int errcode, i, num_chks, rc, thrd_id;
+    uint64_t gfid;
     int ret = (int)UNIFYFS_SUCCESS;
+    int client_done = 0;
+    int num_failed = 0;
+    client_read_req_t* failed = NULL;
     app_config_t* app_config = NULL;
     chunk_read_resp_t* responses = NULL;
-    shm_header_t* client_shm = NULL;
-    shm_meta_t* shm_meta = NULL;
-    void* shm_buf = NULL;
     char* data_buf = NULL;
     size_t data_sz, offset;
 
     assert((NULL != thrd_ctrl) &&
            (NULL != rdreq) &&
-           (NULL != del_reads) &&
-           (NULL != del_reads->resp));
+           (NULL != del_reads));
 
     /* look up client shared memory region */
     app_config = (app_config_t*) arraylist_get(app_config_list, rdreq->app_id);
     assert(NULL != app_config);
-    client_shm = (shm_header_t*) app_config->shm_recv_bufs[rdreq->client_id];
 
     RM_LOCK(thrd_ctrl);
 
     num_chks = del_reads->num_chunks;
     gfid = rdreq->extent.gfid;
-    if (del_reads->status != READREQ_STARTED) {
+    int client_id = rdreq->client_id;
+    if (NULL == del_reads->resp) {
+        LOGERR("no chunk read responses for req @ index=%d",
+               rdreq->req_ndx);
+        ret = (int32_t)UNIFYFS_ERROR_INVAL;
+    } else if (thrd_ctrl->exit_flag) {
+        /* client is gone, drop the data */
+        bufpool_free(del_reads->resp);
+        del_reads->resp = NULL;
+    } else if (del_reads->status != READREQ_STARTED) {
         LOGERR("chunk read response for non-started req @ index=%d",
                rdreq->req_ndx);
         ret = (int32_t)UNIFYFS_ERROR_INVAL;
     } else if (0 == del_reads->total_sz) {
-        LOGERR("empty chunk read response for gfid=%d", gfid);
+        LOGERR("empty chunk read response for gfid=%" PRIu64, gfid);
         ret = (int32_t)UNIFYFS_ERROR_INVAL;
     } else {
         LOGDBG("handling chunk read responses from server %d: "
-               "gfid=%d num_chunks=%d buf_size=%zu",
+               "gfid=%" PRIu64 " num_chunks=%d buf_size=%zu",
                del_reads->rank, gfid, num_chks,
                del_reads->total_sz);
+        /* we own the responses from here on */
         responses = del_reads->resp;
+        del_reads->resp = NULL;
         data_buf = (char*)(responses + num_chks);
+        int prefetch = rdreq->prefetch;
+        if (!prefetch) {
+            /* the window stays started, so nobody else touches it */
+            RM_UNLOCK(thrd_ctrl);
+        }
         for (i = 0; i < num_chks; i++) {
             chunk_read_resp_t* resp = responses + i;
             if (resp->read_rc < 0) {
@@ -1341,32 +2878,59 @@ int rm_handle_chunk_read_responses(reqmgr_thrd_t* thrd_ctrl,
             offset = resp->offset;
             LOGDBG("chunk response for offset=%zu: sz=%zu", offset, data_sz);
 
-            /* allocate and register local target buffer for bulk access */
-            shm_meta = reserve_shmem_meta(app_config, client_shm, data_sz);
-            if (NULL != shm_meta) {
-                shm_meta->offset = offset;
-                shm_meta->length = data_sz;
-                shm_meta->gfid = gfid;
-                shm_meta->errcode = errcode;
-                shm_buf = (void*)((char*)shm_meta + sizeof(shm_meta_t));
-                if (data_sz) {
-                    memcpy(shm_buf, data_buf, data_sz);
-                }
+            /* data left in place in a local superblock has no payload */
+            int in_place = (resp->log_client_id >= 0);
+
+            if (prefetch) {
+                /* keep data in read-ahead window */
+                ra_store_chunk(thrd_ctrl->ra_wins + rdreq->ra_ndx, resp,
+                               data_sz, (in_place ? NULL : data_buf));
             } else {
-                LOGERR("failed to reserve shmem space for read reply")
-                ret = (int32_t)UNIFYFS_ERROR_SHMEM;
+                /* copy reply into client recv buffer */
+                shm_meta_t reply;
+                reply.offset = offset;
+                reply.length = data_sz;
+                reply.gfid = resp->gfid;
+                reply.errcode = errcode;
+                reply.src_app = resp->log_app_id;
+                reply.src_client = resp->log_client_id;
+                reply.src_offset = resp->log_offset;
+                rc = put_shmem_reply(app_config, client_id, &reply,
+                                     ((in_place || (0 == data_sz)) ?
+                                      NULL : data_buf));
+                if (rc != (int)UNIFYFS_SUCCESS) {
+                    ret = rc;
+                }
+            }
+            /* responses always hold room for the requested size */
+            if (!in_place) {
+                data_buf += resp->nbytes;
             }
-            data_buf += data_sz;
         }
         /* cleanup */
-        free((void*)responses);
-        del_reads->resp = NULL;
+        bufpool_free((void*)responses);
+        if (!prefetch) {
+            RM_LOCK(thrd_ctrl);
+        }
 
         /* update request status */
         del_reads->status = READREQ_COMPLETE;
         if (rdreq->status == READREQ_STARTED) {
             rdreq->status = READREQ_PARTIAL_COMPLETE;
         }
+
+        /* send the window of this delegator that was waiting on us */
+        int next_ndx = (int)(del_reads - rdreq->remote_reads) + RECV_BUF_CNT;
+        if ((next_ndx < rdreq->num_remote_reads) &&
+            wait_chunk_window(rdreq, next_ndx)) {
+            rdreq->remote_reads[next_ndx].status = READREQ_STARTED;
+            rc = rm_submit_task(RM_TASK_SEND_CHUNKS, thrd_ctrl,
+                                rdreq->req_ndx, next_ndx);
+            if (rc != (int)UNIFYFS_SUCCESS) {
+                LOGERR("failed to send chunk-read window %d", next_ndx);
+                ret = rc;
+            }
+        }
         int completed_remote_reads = 0;
         for (i = 0; i < rdreq->num_remote_reads; i++) {
             if (rdreq->remote_reads[i].status != READREQ_COMPLETE) {
@@ -1377,11 +2941,16 @@ int rm_handle_chunk_read_responses(reqmgr_thrd_t* thrd_ctrl,
         if (completed_remote_reads == rdreq->num_remote_reads) {
             rdreq->status = READREQ_COMPLETE;
 
-            /* signal client that we're now done writing data */
-            client_signal(client_shm, SHMEM_REGION_DATA_COMPLETE);
-
-            /* wait for client to read data */
-            client_wait(client_shm);
+            if (rdreq->prefetch) {
+                /* read-ahead window is ready for client reads */
+                ra_window_complete(thrd_ctrl->ra_wins + rdreq->ra_ndx);
+            } else {
+                /* client is told once the lock is dropped */
+                client_done = 1;
+                failed = rdreq->failed_reads;
+                num_failed = rdreq->num_failed_reads;
+                rdreq->failed_reads = NULL;
+            }
 
             rc = release_read_req(thrd_ctrl, rdreq);
             if (rc != (int)UNIFYFS_SUCCESS) {
@@ -1392,80 +2961,546 @@ int rm_handle_chunk_read_responses(reqmgr_thrd_t* thrd_ctrl,
 
     RM_UNLOCK(thrd_ctrl);
 
+    if (client_done) {
+        /* fail requested extents that had no data */
+        for (i = 0; i < num_failed; i++) {
+            shm_meta_t reply;
+            memset(&reply, 0, sizeof(reply));
+            reply.offset = failed[i].offset;
+            reply.length = failed[i].length;
+            reply.gfid = failed[i].gfid;
+            reply.errcode = failed[i].errcode;
+            reply.src_client = -1;
+            rc = put_shmem_reply(app_config, client_id, &reply, NULL);
+            if (rc != (int)UNIFYFS_SUCCESS) {
+                ret = rc;
+            }
+        }
+        if (NULL != failed) {
+            free(failed);
+        }
+
+        /* signal client that we're done, and wait for it
+         * to read remaining data, shm_lock keeps the next read
+         * of the client out of the recv buffer until then */
+        complete_recv_slots(app_config, client_id);
+    }
+
     return ret;
 }
 
-/* Entry point for request manager thread. One thread is created
- * for each client process to retrieve remote data and notify the
- * client when data is ready.
+/* record the result of a ring read operation for the client, unless
+ * the client has unmounted or moved on to a newer operation, called
+ * with the ring poller lock held */
+static void rm_ring_reply(reqmgr_thrd_t* thrd_ctrl, uint64_t op, int rc)
+{
+    shm_req_ring_t* ring = thrd_ctrl->req_ring;
+    if ((NULL == ring) || (op != thrd_ctrl->ring_op)) {
+        LOGDBG("dropping result of stale ring read op=%" PRIu64, op);
+        return;
+    }
+    ring->rc = rc;
+    __atomic_store_n(&(ring->op_done), op, __ATOMIC_RELEASE);
+    unifyfs_shm_set_state(&(ring->hdr), SHMEM_REGION_EMPTY);
+}
+
+/* start the reads of an operation taken from the request ring, and
+ * tell the client they are under way, run by a worker */
+static int rm_ring_read(rm_task_t* task)
+{
+    reqmgr_thrd_t* thrd_ctrl = task->thrd_ctrl;
+
+    /* single reads go through read-ahead as the read rpc did */
+    int rc = task->ring_rc;
+    if (rc != (int)UNIFYFS_SUCCESS) {
+        /* already failed */
+    } else if (thrd_ctrl->exit_flag) {
+        rc = (int)UNIFYFS_FAILURE;
+    } else if (task->num_reqs == 1) {
+        rc = rm_cmd_read(thrd_ctrl->app_id, thrd_ctrl->client_id,
+                         task->reqs[0].gfid, task->reqs[0].offset,
+                         task->reqs[0].length);
+    } else {
+        rc = rm_read_extents(thrd_ctrl->app_id, thrd_ctrl->client_id,
+                             task->num_reqs, task->reqs);
+    }
+
+    pthread_mutex_lock(&(rm_ring.sync));
+    rm_ring_reply(thrd_ctrl, task->ring_op, rc);
+    pthread_mutex_unlock(&(rm_ring.sync));
+
+    return rc;
+}
+
+/* take new descriptors from the read request ring of a client, and
+ * hand the operation to a worker once its last descriptor is in,
+ * returns non-zero if any descriptors were taken, called by the ring
+ * poller with its lock held */
+static int rm_ring_poll_client(reqmgr_thrd_t* thrd_ctrl)
+{
+    shm_req_ring_t* ring = thrd_ctrl->req_ring;
+    if ((NULL == ring) || (0 == thrd_ctrl->ring_cap)) {
+        return 0;
+    }
+
+    /* we are the only writer of tail */
+    uint64_t head = __atomic_load_n(&(ring->head), __ATOMIC_ACQUIRE);
+    uint64_t tail = ring->tail;
+    if (head == tail) {
+        return 0;
+    }
+
+    /* copy descriptors out, so the client can reuse their entries */
+    shm_read_desc_t* descs = unifyfs_shm_req_ring_descs(ring);
+    int last = 0;
+    while ((tail != head) && !last) {
+        shm_read_desc_t* desc = descs + (tail % thrd_ctrl->ring_cap);
+        last = desc->last;
+        tail++;
+
+        /* a new operation replaces one the client gave up on
+         * before posting its last descriptor */
+        if (desc->op != thrd_ctrl->ring_op) {
+            if (thrd_ctrl->ring_num_reqs > 0) {
+                LOGERR("dropping %zu descriptors of incomplete "
+                       "ring read op=%" PRIu64,
+                       thrd_ctrl->ring_num_reqs, thrd_ctrl->ring_op);
+            }
+            thrd_ctrl->ring_op = desc->op;
+            thrd_ctrl->ring_num_reqs = 0;
+            thrd_ctrl->ring_rc = (int)UNIFYFS_SUCCESS;
+        }
+
+        if (thrd_ctrl->ring_num_reqs == thrd_ctrl->ring_max_reqs) {
+            size_t new_max = (thrd_ctrl->ring_max_reqs == 0) ?
+                             64 : (2 * thrd_ctrl->ring_max_reqs);
+            client_read_req_t* reqs = (client_read_req_t*)
+                realloc(thrd_ctrl->ring_reqs,
+                        new_max * sizeof(client_read_req_t));
+            if (NULL == reqs) {
+                /* drop rest of operation, but keep draining it */
+                LOGERR("failed to allocate read requests from ring");
+                thrd_ctrl->ring_rc = (int)UNIFYFS_ERROR_NOMEM;
+                continue;
+            }
+            thrd_ctrl->ring_reqs = reqs;
+            thrd_ctrl->ring_max_reqs = new_max;
+        }
+
+        client_read_req_t* req =
+            thrd_ctrl->ring_reqs + thrd_ctrl->ring_num_reqs;
+        req->gfid    = desc->gfid;
+        req->offset  = desc->offset;
+        req->length  = desc->length;
+        req->errcode = (int)UNIFYFS_SUCCESS;
+        thrd_ctrl->ring_num_reqs++;
+    }
+    __atomic_store_n(&(ring->tail), tail, __ATOMIC_RELEASE);
+
+    if (last) {
+        /* the task takes over the requests of the operation */
+        int rc = (int)UNIFYFS_ERROR_NOMEM;
+        rm_task_t* task = (rm_task_t*) calloc(1, sizeof(rm_task_t));
+        if (NULL != task) {
+            task->type      = RM_TASK_RING_READ;
+            task->thrd_ctrl = thrd_ctrl;
+            task->reqs      = thrd_ctrl->ring_reqs;
+            task->num_reqs  = thrd_ctrl->ring_num_reqs;
+            task->ring_op   = thrd_ctrl->ring_op;
+            task->ring_rc   = thrd_ctrl->ring_rc;
+            thrd_ctrl->ring_reqs = NULL;
+            thrd_ctrl->ring_max_reqs = 0;
+
+            void* reqs = task->reqs;
+            rc = rm_queue_task(task);
+            if (rc != (int)UNIFYFS_SUCCESS) {
+                free(reqs);
+            }
+        } else {
+            LOGERR("failed to allocate request manager task");
+        }
+        thrd_ctrl->ring_num_reqs = 0;
+        thrd_ctrl->ring_rc = (int)UNIFYFS_SUCCESS;
+
+        /* on success, the worker replies once the reads are started */
+        if (rc != (int)UNIFYFS_SUCCESS) {
+            rm_ring_reply(thrd_ctrl, thrd_ctrl->ring_op, rc);
+        }
+    }
+
+    return 1;
+}
+
+/* Entry point for the ring poller thread, which takes read requests
+ * that clients post to the rings in their request regions.  The
+ * poller sweeps all rings back to back while there is work, and
+ * sleeps between sweeps for up to RM_RING_POLL_MAX nanoseconds,
+ * doubling the sleep each idle sweep.  Once the sleep is at its
+ * maximum, it arms the doorbell, sweeps once more, and blocks on the
+ * bell until a client rings it (or RM_RING_PARK_MS pass).
  *
- * @param arg: pointer to RM thread control structure
+ * @param arg: unused
  * @return NULL */
-void* rm_delegate_request_thread(void* arg)
+static void* rm_ring_poller_thread(void* arg)
 {
-    /* get pointer to our thread control structure */
-    reqmgr_thrd_t* thrd_ctrl = (reqmgr_thrd_t*) arg;
+    long idle_ns = SHM_WAIT_INTERVAL;
+    int armed = 0;
 
-    LOGDBG("I am request manager thread!");
-
-    /* loop forever to handle read requests from the client,
-     * new requests are added to a list on a shared data structure
-     * with main thread, new items inserted by the rpc handler */
-    int rc;
     while (1) {
-        /* grab lock */
-        RM_LOCK(thrd_ctrl);
+        int busy = 0;
+        pthread_mutex_lock(&(rm_ring.sync));
+        if (rm_ring.exit_flag) {
+            pthread_mutex_unlock(&(rm_ring.sync));
+            break;
+        }
+        int i;
+        int num_thrds = arraylist_size(rm_thrd_list);
+        for (i = 0; i < num_thrds; i++) {
+            reqmgr_thrd_t* thrd_ctrl = rm_get_thread(i);
+            if (NULL != thrd_ctrl) {
+                busy |= rm_ring_poll_client(thrd_ctrl);
+            }
+        }
+        pthread_mutex_unlock(&(rm_ring.sync));
+
+        if (busy) {
+            idle_ns = SHM_WAIT_INTERVAL;
+            armed = 0;
+            continue;
+        }
+
+        if (armed) {
+            /* nothing was posted since the bell was armed */
+            unifyfs_shm_bell_wait(rm_ring.bell, RM_RING_PARK_MS);
+            armed = 0;
+            continue;
+        }
+        if ((idle_ns == RM_RING_POLL_MAX) && (NULL != rm_ring.bell)) {
+            /* a client that posts after this rings the bell */
+            armed = unifyfs_shm_bell_arm(rm_ring.bell);
+            if (armed) {
+                continue;
+            }
+        }
+
+        /* back off while clients are idle */
+        struct timespec ts = { 0, idle_ns };
+        nanosleep(&ts, NULL);
+        idle_ns *= 2;
+        if (idle_ns > RM_RING_POLL_MAX) {
+            idle_ns = RM_RING_POLL_MAX;
+        }
+    }
+
+    LOGDBG("request ring poller exiting");
+
+    return NULL;
+}
 
-        /* process any chunk read responses */
-        rc = rm_process_remote_chunk_responses(thrd_ctrl);
+/* run a task taken from the worker pool */
+static void rm_run_task(rm_task_t* task)
+{
+    int rc;
+    switch (task->type) {
+    case RM_TASK_SEND_CHUNKS:
+        rc = rm_request_remote_chunks(task->thrd_ctrl, task->req_ndx,
+                                      task->remote_ndx);
+        if (rc != UNIFYFS_SUCCESS) {
+            LOGERR("failed to request remote chunks");
+        }
+        break;
+    case RM_TASK_CHUNK_RESPONSES:
+        rc = rm_process_remote_chunk_responses(task->thrd_ctrl,
+                                               task->req_ndx,
+                                               task->remote_ndx);
         if (rc != UNIFYFS_SUCCESS) {
             LOGERR("failed to process remote chunk responses");
         }
+        break;
+    case RM_TASK_PREFETCH:
+        rc = rm_prefetch_window(task->thrd_ctrl, task->req_ndx);
+        if (rc != UNIFYFS_SUCCESS) {
+            LOGERR("failed to prefetch read-ahead window");
+        }
+        break;
+    case RM_TASK_READAHEAD:
+        rc = rm_serve_readahead(task->thrd_ctrl, task->req_ndx);
+        if (rc != UNIFYFS_SUCCESS) {
+            LOGERR("failed to serve read from read-ahead window");
+        }
+        break;
+    case RM_TASK_RING_READ:
+        rc = rm_ring_read(task);
+        if (rc != UNIFYFS_SUCCESS) {
+            LOGERR("failed to start read operation from request ring");
+        }
+        free(task->reqs);
+        break;
+    default:
+        LOGERR("invalid request manager task type %d", (int)task->type);
+        break;
+    }
+}
 
-        /* inform dispatcher that we're waiting for work
-         * inside the critical section */
-        thrd_ctrl->has_waiting_delegator = 1;
+/* returns 1 for tasks that write to the client recv buffer */
+static int rm_task_uses_shm(rm_task_t* task)
+{
+    return ((task->type == RM_TASK_CHUNK_RESPONSES) ||
+            (task->type == RM_TASK_READAHEAD));
+}
 
-        /* if dispatcher is waiting on us, signal it to go ahead,
-         * this coordination ensures that we'll be the next thread
-         * to grab the lock after the dispatcher has assigned us
-         * some work (rather than the dispatcher grabbing the lock
-         * and assigning yet more work) */
-        if (thrd_ctrl->has_waiting_dispatcher == 1) {
-            pthread_cond_signal(&thrd_ctrl->thrd_cond);
+/* run a task that writes to the client recv buffer, unless another
+ * worker is running one for the same client, in which case the task
+ * is chained for that worker, so workers do not pile up on the
+ * client shm_lock. The tasks chained meanwhile are run in order. */
+static void rm_run_shm_tasks(rm_task_t* task)
+{
+    reqmgr_thrd_t* thrd_ctrl = task->thrd_ctrl;
+
+    pthread_mutex_lock(&(thrd_ctrl->task_lock));
+    if (thrd_ctrl->shm_busy) {
+        /* still counted in num_tasks of the client */
+        task->next = NULL;
+        if (NULL != thrd_ctrl->shm_tail) {
+            thrd_ctrl->shm_tail->next = task;
+        } else {
+            thrd_ctrl->shm_head = task;
+        }
+        thrd_ctrl->shm_tail = task;
+        pthread_mutex_unlock(&(thrd_ctrl->task_lock));
+        return;
+    }
+    thrd_ctrl->shm_busy = 1;
+    pthread_mutex_unlock(&(thrd_ctrl->task_lock));
+
+    while (NULL != task) {
+        rm_run_task(task);
+
+        /* take the next task before this one stops counting, the
+         * client state may be freed once its count drops to zero */
+        pthread_mutex_lock(&(thrd_ctrl->task_lock));
+        rm_task_t* next = thrd_ctrl->shm_head;
+        if (NULL != next) {
+            thrd_ctrl->shm_head = next->next;
+            if (NULL == thrd_ctrl->shm_head) {
+                thrd_ctrl->shm_tail = NULL;
+            }
+        } else {
+            thrd_ctrl->shm_busy = 0;
         }
+        pthread_mutex_unlock(&(thrd_ctrl->task_lock));
 
-        /* release lock and wait to be signaled by dispatcher */
-        LOGDBG("RM[%d] waiting for work", thrd_ctrl->thrd_ndx);
-        pthread_cond_wait(&thrd_ctrl->thrd_cond, &thrd_ctrl->thrd_lock);
+        rm_count_tasks(thrd_ctrl, -1);
+        free(task);
+        task = next;
+    }
+}
 
-        /* set flag to indicate we're no longer waiting */
-        thrd_ctrl->has_waiting_delegator = 0;
+/* Entry point for request manager worker threads. Workers take
+ * tasks from their own deque, then try to steal from the deques
+ * of the other workers, and sleep when there are no tasks left.
+ *
+ * @param arg: index of worker within pool
+ * @return NULL */
+static void* rm_worker_thread(void* arg)
+{
+    int ndx = (int)(intptr_t)arg;
+    rm_worker_ndx = ndx;
 
-        /* go do work ... */
-        LOGDBG("RM[%d] got work", thrd_ctrl->thrd_ndx);
+    LOGDBG("I am request manager worker %d!", ndx);
 
-        /* release lock and bail out if we've been told to exit */
-        if (thrd_ctrl->exit_flag == 1) {
-            RM_UNLOCK(thrd_ctrl);
-            break;
+    while (1) {
+        /* newest task of our own deque first */
+        rm_task_t* task = rm_deque_pop(rm_pool.deques + ndx, 0);
+
+        /* otherwise steal the oldest task of another worker */
+        int i;
+        for (i = 1; (NULL == task) && (i < rm_pool.num_workers); i++) {
+            int victim = (ndx + i) % rm_pool.num_workers;
+            task = rm_deque_pop(rm_pool.deques + victim, 1);
         }
 
-        /* send chunk read requests to remote servers */
-        rc = rm_request_remote_chunks(thrd_ctrl);
-        if (rc != UNIFYFS_SUCCESS) {
-            LOGERR("failed to request remote chunks");
+        if (NULL != task) {
+            pthread_mutex_lock(&(rm_pool.sync));
+            rm_pool.num_tasks--;
+            pthread_mutex_unlock(&(rm_pool.sync));
+
+            if (rm_task_uses_shm(task)) {
+                rm_run_shm_tasks(task);
+                continue;
+            }
+            rm_run_task(task);
+            rm_count_tasks(task->thrd_ctrl, -1);
+            free(task);
+            continue;
         }
 
-        /* release lock */
-        RM_UNLOCK(thrd_ctrl);
+        /* wait for new tasks, remaining tasks are run before exit */
+        pthread_mutex_lock(&(rm_pool.sync));
+        while ((0 == rm_pool.num_tasks) && !rm_pool.exit_flag) {
+            pthread_cond_wait(&(rm_pool.cond), &(rm_pool.sync));
+        }
+        int done = (rm_pool.exit_flag && (0 == rm_pool.num_tasks));
+        pthread_mutex_unlock(&(rm_pool.sync));
+        if (done) {
+            break;
+        }
     }
 
-    LOGDBG("request manager thread exiting");
+    LOGDBG("request manager worker %d exiting", ndx);
 
     return NULL;
 }
 
+/* launch the pool of request manager worker threads */
+int rm_pool_init(unifyfs_cfg_t* cfg)
+{
+    int i, rc;
+
+    memset(&rm_pool, 0, sizeof(rm_pool));
+    pthread_mutex_init(&(rm_pool.sync), NULL);
+    pthread_cond_init(&(rm_pool.cond), NULL);
+
+    /* use one worker per online core unless configured */
+    long num_thrds = UNIFYFS_REQMGR_THREADS;
+    if (NULL != cfg) {
+        configurator_int_val(cfg->server_reqmgr_threads, &num_thrds);
+    }
+    if (num_thrds <= 0) {
+        num_thrds = sysconf(_SC_NPROCESSORS_ONLN);
+    }
+
+    long ra_size = UNIFYFS_READAHEAD_SIZE;
+    if (NULL != cfg) {
+        configurator_int_val(cfg->server_readahead_size, &ra_size);
+    }
+    rm_readahead_size = (ra_size > 0) ? (size_t)ra_size : 0;
+    if (num_thrds <= 0) {
+        num_thrds = 1;
+    } else if (num_thrds > RM_MAX_WORKERS) {
+        num_thrds = RM_MAX_WORKERS;
+    }
+
+    rm_pool.deques = (rm_deque_t*) calloc(num_thrds, sizeof(rm_deque_t));
+    rm_pool.thrds = (pthread_t*) calloc(num_thrds, sizeof(pthread_t));
+    if ((NULL == rm_pool.deques) || (NULL == rm_pool.thrds)) {
+        LOGERR("failed to allocate request manager worker pool");
+        rm_pool_fini();
+        return (int)UNIFYFS_ERROR_NOMEM;
+    }
+    for (i = 0; i < (int)num_thrds; i++) {
+        pthread_mutex_init(&(rm_pool.deques[i].lock), NULL);
+    }
+    rm_pool.num_deques = (int)num_thrds;
+
+    /* workers submit to their own deque, so all deques must exist
+     * before the first worker starts */
+    rm_pool.num_workers = (int)num_thrds;
+    for (i = 0; i < (int)num_thrds; i++) {
+        rc = pthread_create(&(rm_pool.thrds[i]), NULL,
+                            rm_worker_thread, (void*)(intptr_t)i);
+        if (rc != 0) {
+            LOGERR("failed to create request manager worker - rc=%d (%s)",
+                   rc, strerror(rc));
+            rm_pool.num_workers = i;
+            rm_pool_fini();
+            return (int)UNIFYFS_ERROR_THRDINIT;
+        }
+    }
+    LOGDBG("launched %d request manager workers", rm_pool.num_workers);
+
+    /* clients ring the bell to wake the idle poller, without it the
+     * poller keeps polling */
+    rm_ring.bell_id = (int) getpid();
+    snprintf(rm_ring.bell_name, sizeof(rm_ring.bell_name),
+             "%d-bell", rm_ring.bell_id);
+    rm_ring.bell = (shm_header_t*)
+        unifyfs_shm_alloc(rm_ring.bell_name, sizeof(shm_header_t));
+    if (NULL == rm_ring.bell) {
+        LOGERR("failed to create request ring doorbell");
+        rm_ring.bell_id = -1;
+    } else {
+        unifyfs_shm_set_state(rm_ring.bell, SHMEM_REGION_DATA_READY);
+    }
+
+    /* the poller submits tasks, so it starts after the workers */
+    rm_ring.exit_flag = 0;
+    rc = pthread_create(&(rm_ring.thrd), NULL, rm_ring_poller_thread, NULL);
+    if (rc != 0) {
+        LOGERR("failed to create request ring poller - rc=%d (%s)",
+               rc, strerror(rc));
+        rm_pool_fini();
+        return (int)UNIFYFS_ERROR_THRDINIT;
+    }
+    rm_ring.started = 1;
+
+    return (int)UNIFYFS_SUCCESS;
+}
+
+/* returns id of the request ring doorbell, or -1 if there is none */
+int rm_ring_bell_id(void)
+{
+    return rm_ring.bell_id;
+}
+
+/* stop and join the request manager worker threads */
+int rm_pool_fini(void)
+{
+    int i;
+
+    /* stop taking new reads before the workers go away */
+    if (rm_ring.started) {
+        pthread_mutex_lock(&(rm_ring.sync));
+        rm_ring.exit_flag = 1;
+        pthread_mutex_unlock(&(rm_ring.sync));
+        if (NULL != rm_ring.bell) {
+            unifyfs_shm_set_state(rm_ring.bell, SHMEM_REGION_DATA_READY);
+        }
+        pthread_join(rm_ring.thrd, NULL);
+        rm_ring.started = 0;
+    }
+    if (NULL != rm_ring.bell) {
+        unifyfs_shm_free(rm_ring.bell_name, sizeof(shm_header_t),
+                         (void**)&(rm_ring.bell));
+        rm_ring.bell_id = -1;
+    }
+
+    pthread_mutex_lock(&(rm_pool.sync));
+    rm_pool.exit_flag = 1;
+    pthread_cond_broadcast(&(rm_pool.cond));
+    pthread_mutex_unlock(&(rm_pool.sync));
+
+    for (i = 0; i < rm_pool.num_workers; i++) {
+        pthread_join(rm_pool.thrds[i], NULL);
+    }
+    rm_pool.num_workers = 0;
+
+    uint64_t ra_hits = __atomic_load_n(&rm_ra_hits, __ATOMIC_RELAXED);
+    uint64_t ra_misses = __atomic_load_n(&rm_ra_misses, __ATOMIC_RELAXED);
+    if ((ra_hits + ra_misses) > 0) {
+        LOGDBG("read-ahead: sequential reads=%llu hits=%llu windows=%llu",
+               (unsigned long long) (ra_hits + ra_misses),
+               (unsigned long long) ra_hits,
+               (unsigned long long) __atomic_load_n(&rm_ra_prefetches,
+                                                    __ATOMIC_RELAXED));
+    }
+
+    if (NULL != rm_pool.thrds) {
+        free(rm_pool.thrds);
+        rm_pool.thrds = NULL;
+    }
+    if (NULL != rm_pool.deques) {
+        for (i = 0; i < rm_pool.num_deques; i++) {
+            pthread_mutex_destroy(&(rm_pool.deques[i].lock));
+        }
+        free(rm_pool.deques);
+        rm_pool.deques = NULL;
+    }
+    rm_pool.num_deques = 0;
+
+    return (int)UNIFYFS_SUCCESS;
+}
+
 /* BEGIN MARGO SERVER-SERVER RPC INVOCATION FUNCTIONS */
 
 #if 0 // DISABLE UNUSED RPCS
@@ -1578,9 +3613,13 @@ int invoke_server_request_rpc(int dst_srvr_rank, int req_id, int tag,
 /* invokes the server_request rpc */
 int invoke_chunk_read_request_rpc(int dst_srvr_rank,
                                   server_read_req_t* rdreq,
+                                  int win_ndx,
                                   int num_chunks,
-                                  void* data_buf, size_t buf_sz)
+                                  void* data_buf, size_t buf_sz,
+                                  size_t resp_sz)
 {
+    int req_id = RM_CHUNK_READS_ID(rdreq->req_ndx, win_ndx);
+
     int rc = (int)UNIFYFS_SUCCESS;
     hg_handle_t handle;
     chunk_read_request_in_t in;
@@ -1594,7 +3633,7 @@ int invoke_chunk_read_request_rpc(int dst_srvr_rank,
         return sm_issue_chunk_reads(glb_pmi_rank,
                                     rdreq->app_id,
                                     rdreq->client_id,
-                                    rdreq->req_ndx,
+                                    req_id,
                                     num_chunks,
                                     (char*)data_buf);
     }
@@ -1611,7 +3650,7 @@ int invoke_chunk_read_request_rpc(int dst_srvr_rank,
     in.src_rank = (int32_t)glb_pmi_rank;
     in.app_id = (int32_t)rdreq->app_id;
     in.client_id = (int32_t)rdreq->client_id;
-    in.req_id = (int32_t)rdreq->req_ndx;
+    in.req_id = (int32_t)req_id;
     in.num_chks = (int32_t)num_chunks;
     in.bulk_size = bulk_sz;
 
@@ -1621,6 +3660,24 @@ int invoke_chunk_read_request_rpc(int dst_srvr_rank,
                              HG_BULK_READ_ONLY, &in.bulk_handle);
     assert(hret == HG_SUCCESS);
 
+    /* expose a buffer for the remote server to push the responses
+     * into, if we can't get one it will send them by response rpc */
+    void* resp_buf = bufpool_alloc(resp_sz);
+    hg_size_t resp_bulk_sz = (hg_size_t)resp_sz;
+    in.resp_size = 0;
+    in.resp_handle = HG_BULK_NULL;
+    if (NULL != resp_buf) {
+        hret = margo_bulk_create(unifyfsd_rpc_context->svr_mid, 1,
+                                 &resp_buf, &resp_bulk_sz,
+                                 HG_BULK_WRITE_ONLY, &in.resp_handle);
+        if (hret == HG_SUCCESS) {
+            in.resp_size = resp_bulk_sz;
+        } else {
+            bufpool_free(resp_buf);
+            resp_buf = NULL;
+        }
+    }
+
     LOGDBG("invoking the chunk-read-request rpc function");
     hret = margo_forward(handle, &in);
     if (hret != HG_SUCCESS) {
@@ -1632,12 +3689,29 @@ int invoke_chunk_read_request_rpc(int dst_srvr_rank,
             rc = (int)out.ret;
             LOGDBG("Got request rpc response from %d - ret=%d",
                    dst_srvr_rank, rc);
+            if ((rc == (int)UNIFYFS_SUCCESS) && (out.resp_size > 0)) {
+                /* responses were pushed into our buffer */
+                rc = rm_post_chunk_read_responses(rdreq->app_id,
+                                                  rdreq->client_id,
+                                                  dst_srvr_rank, req_id,
+                                                  num_chunks,
+                                                  (size_t)out.resp_size,
+                                                  (char*)resp_buf);
+                if (rc == (int)UNIFYFS_SUCCESS) {
+                    /* now owned by the read request */
+                    resp_buf = NULL;
+                }
+            }
             margo_free_output(handle, &out);
         } else {
             rc = (int)UNIFYFS_FAILURE;
         }
     }
 
+    if (in.resp_handle != HG_BULK_NULL) {
+        margo_bulk_free(in.resp_handle);
+    }
+    bufpool_free(resp_buf);
     margo_bulk_free(in.bulk_handle);
     margo_destroy(handle);
 
@@ -1646,6 +3720,98 @@ int invoke_chunk_read_request_rpc(int dst_srvr_rank,
 
 /* BEGIN MARGO SERVER-SERVER RPC HANDLER FUNCTIONS */
 
+/* handler for asynchronous fsync flush request
+ *
+ * returns once the asynchronous fsyncs of the app
+ * queued at this server have been published */
+static void fsync_flush_rpc(hg_handle_t handle)
+{
+    fsync_flush_in_t in;
+    fsync_flush_out_t out;
+
+    /* get input params */
+    hg_return_t hret = margo_get_input(handle, &in);
+    assert(hret == HG_SUCCESS);
+    LOGDBG("fsync flush for app_id=%d from server %d",
+           (int)in.app_id, (int)in.src_rank);
+
+    out.ret = (int32_t) rm_fsync_wait((int)in.app_id, -1);
+
+    /* send output back to caller */
+    hret = margo_respond(handle, &out);
+    assert(hret == HG_SUCCESS);
+
+    /* free margo resources */
+    margo_free_input(handle, &in);
+    margo_destroy(handle);
+}
+DEFINE_MARGO_RPC_HANDLER(fsync_flush_rpc)
+
+/* handler for extents invalidation request
+ *
+ * drops our cached extents of the files in the request */
+static void extents_invalidate_rpc(hg_handle_t handle)
+{
+    extents_invalidate_in_t in;
+    extents_invalidate_out_t out;
+
+    /* get input params */
+    hg_return_t hret = margo_get_input(handle, &in);
+    assert(hret == HG_SUCCESS);
+    LOGDBG("invalidating extents of %d files for server %d",
+           (int)in.num_gfids, (int)in.src_rank);
+
+    /* get margo info */
+    const struct hg_info* hgi = margo_get_info(handle);
+    assert(NULL != hgi);
+    margo_instance_id mid = margo_hg_info_get_instance(hgi);
+    assert(mid != MARGO_INSTANCE_NULL);
+
+    out.ret = (int32_t)UNIFYFS_SUCCESS;
+    size_t num_gfids = (size_t)in.num_gfids;
+    if ((num_gfids > 0) &&
+        (in.bulk_size == (hg_size_t)(num_gfids * sizeof(uint64_t)))) {
+        void* buf = malloc(in.bulk_size);
+        if (NULL == buf) {
+            out.ret = (int32_t)UNIFYFS_ERROR_NOMEM;
+        } else {
+            hg_bulk_t bulk_handle;
+            hret = margo_bulk_create(mid, 1, &buf, &in.bulk_size,
+                                     HG_BULK_WRITE_ONLY, &bulk_handle);
+            if (hret == HG_SUCCESS) {
+                /* pull file ids */
+                hret = margo_bulk_transfer(mid, HG_BULK_PULL, hgi->addr,
+                                           in.bulk_handle, 0,
+                                           bulk_handle, 0, in.bulk_size);
+                margo_bulk_free(bulk_handle);
+            }
+            if (hret == HG_SUCCESS) {
+                uint64_t* gfids = (uint64_t*)buf;
+                size_t i;
+                for (i = 0; i < num_gfids; i++) {
+                    unifyfs_invalidate_cached_extents(gfids[i]);
+                }
+            } else {
+                LOGERR("failed to pull file ids for extents invalidation");
+                out.ret = (int32_t)UNIFYFS_FAILURE;
+            }
+            free(buf);
+        }
+    } else if (num_gfids > 0) {
+        LOGERR("invalid extents invalidation request");
+        out.ret = (int32_t)UNIFYFS_ERROR_INVAL;
+    }
+
+    /* send output back to caller */
+    hret = margo_respond(handle, &out);
+    assert(hret == HG_SUCCESS);
+
+    /* free margo resources */
+    margo_free_input(handle, &in);
+    margo_destroy(handle);
+}
+DEFINE_MARGO_RPC_HANDLER(extents_invalidate_rpc)
+
 /* handler for remote read request response */
 static void chunk_read_response_rpc(hg_handle_t handle)
 {
@@ -1674,7 +3840,7 @@ static void chunk_read_response_rpc(hg_handle_t handle)
         LOGERR("empty response buffer");
         ret = (int32_t)UNIFYFS_ERROR_INVAL;
     } else {
-        resp_buf = malloc(bulk_sz);
+        resp_buf = bufpool_alloc(bulk_sz);
         if (NULL == resp_buf) {
             LOGERR("failed to allocate chunk read responses buffer");
             ret = (int32_t)UNIFYFS_ERROR_NOMEM;
@@ -32,6 +32,13 @@
 
 #include "unifyfs_global.h"
 
+/* id of a chunk-read window of a read request, this is sent to the
+ * service manager as the request id and comes back with the responses */
+#define RM_CHUNK_READS_ID(req_ndx, win_ndx) \
+    (((win_ndx) * RM_MAX_ACTIVE_REQUESTS) + (req_ndx))
+#define RM_CHUNK_READS_REQ(id) ((id) % RM_MAX_ACTIVE_REQUESTS)
+#define RM_CHUNK_READS_WIN(id) ((id) / RM_MAX_ACTIVE_REQUESTS)
+
 typedef struct {
     readreq_status_e status;   /* aggregate request status */
     int req_ndx;               /* index in reqmgr read_reqs array */
@@ -40,49 +47,108 @@ typedef struct {
     int num_remote_reads;      /* size of remote_reads array */
     client_read_req_t extent;  /* client read extent, includes gfid */
     chunk_read_req_t* chunks;  /* array of chunk-reads */
-    remote_chunk_reads_t* remote_reads; /* per-delegator remote reads array */
+    remote_chunk_reads_t* remote_reads; /* per-delegator windows of chunk
+                                         * reads, in delegator order */
+    client_read_req_t* failed_reads; /* requested extents of files
+                                      * without data, failed once the
+                                      * other chunk reads are done */
+    int num_failed_reads;      /* size of failed_reads array */
+    int prefetch;              /* non-zero for read-ahead requests */
+    int ra_ndx;                /* read-ahead window filled by prefetch,
+                                * or served to the client */
 } server_read_req_t;
 
-/* this structure is created by the main thread for each request
- * manager thread, contains shared data structures where main thread
- * issues read requests and request manager processes them, contains
- * condition variable and lock for coordination between threads */
+/* chunk of file data held in a read-ahead window */
+typedef struct {
+    size_t offset;      /* file offset of chunk */
+    size_t nbytes;      /* length of chunk */
+    int errcode;        /* read error of chunk, 0 on success */
+    int log_app_id;     /* app id of log holding in-place data */
+    int log_client_id;  /* client id of log holding in-place data,
+                         * or -1 when data is in the window buffer */
+    size_t log_offset;  /* log offset of in-place data */
+} rm_ra_chunk_t;
+
+/* file data prefetched for a client that reads sequentially */
+typedef struct {
+    readreq_status_e status; /* INIT (empty), STARTED or COMPLETE */
+    int stale;               /* set to drop data of a started window */
+    int users;               /* pending reads served from window */
+    unsigned long meta_gen;  /* extents generation of gfid the window
+                              * was looked up with, the window is stale
+                              * once new extents of gfid are stored */
+    uint64_t gfid;           /* file of window */
+    size_t offset;           /* file offset of window */
+    size_t length;           /* length of window */
+    char* data;              /* window data buffer (length bytes) */
+    int num_chunks;          /* number of chunks in window */
+    int max_chunks;          /* size of chunks array */
+    rm_ra_chunk_t* chunks;   /* chunks, sorted by offset when complete */
+} rm_ra_window_t;
+
+struct rm_task;
+
+/* this structure is created by the rpc handler for each client
+ * at mount, it holds the read requests of the client, which are
+ * served by the shared pool of request manager worker threads,
+ * and a lock to coordinate the rpc handlers and workers */
 typedef struct {
-    /* request manager thread */
-    pthread_t thrd;
-
-    /* condition variable to synchronize request manager thread
-     * and main thread delivering work */
-    pthread_cond_t  thrd_cond;
-
     /* lock for shared data structures (variables below) */
     pthread_mutex_t thrd_lock;
 
-    /* flag indicating that request manager thread is waiting
-     * for work inside of critical region */
-    int has_waiting_delegator;
-
-    /* flag indicating main thread is in critical section waiting
-     * for request manager thread */
-    int has_waiting_dispatcher;
+    /* serializes writers of the client recv buffer, taken before
+     * thrd_lock, so thrd_lock can be dropped while a worker waits
+     * for the client to drain the buffer */
+    pthread_mutex_t shm_lock;
+
+    /* number of worker pool tasks queued or running for the client,
+     * protected by task_lock, the client shared memory is not freed
+     * at unmount until this drops to zero */
+    pthread_mutex_t task_lock;
+    pthread_cond_t task_cond;
+    int num_tasks;
+
+    /* set while a worker runs a task that writes to the client recv
+     * buffer, such tasks taken by other workers meanwhile are chained
+     * here for it to run in order, protected by task_lock */
+    int shm_busy;
+    struct rm_task* shm_head;
+    struct rm_task* shm_tail;
 
     int num_read_reqs;
     int next_rdreq_ndx;
     server_read_req_t read_reqs[RM_MAX_ACTIVE_REQUESTS];
 
-    /* buffer to build read request messages */
-    char del_req_msg_buf[REQ_BUF_LEN];
-
-    /* flag set to indicate request manager thread should exit */
+    /* sequential read detection, the file and offset expected
+     * for the next read, and the number of sequential reads */
+    uint64_t seq_gfid;
+    size_t seq_offset;
+    int seq_reads;
+    int seq_unlaminated; /* seq_gfid found not laminated, no read-ahead */
+
+    /* read-ahead windows of prefetched file data */
+    rm_ra_window_t ra_wins[RM_READAHEAD_WINDOWS];
+
+    /* read request ring in the client request region, NULL once
+     * the client has unmounted, and the requests taken from it for
+     * the read operation being received (see rm_ring_poll_client),
+     * these are protected by the ring poller lock */
+    shm_req_ring_t* req_ring;
+    size_t ring_cap;
+    uint64_t ring_op;
+    client_read_req_t* ring_reqs;
+    size_t ring_num_reqs;
+    size_t ring_max_reqs;
+    int ring_rc;
+
+    /* flag set to indicate client has unmounted, pending
+     * work for it is dropped by the worker threads */
     int exit_flag;
 
-    /* flag set after thread has exited and join completed */
-    int exited;
-
-    /* app_id this thread is serving */
+    /* app_id this structure is serving */
     int app_id;
 
-    /* client_id this thread is serving */
+    /* client_id this structure is serving */
     int client_id;
 
     /* index within rm_thrd_list */
@@ -90,28 +156,31 @@ typedef struct {
 } reqmgr_thrd_t;
 
 
-/* create Request Manager thread for application client */
+/* create Request Manager state for application client */
 reqmgr_thrd_t* unifyfs_rm_thrd_create(int app_id,
                                       int client_id);
 
-/* lookup Request Manager thread by index */
+/* lookup Request Manager state by index */
 reqmgr_thrd_t* rm_get_thread(int thrd_id);
 
-/* Request Manager pthread main */
-void* rm_delegate_request_thread(void* arg);
+/* launch the pool of request manager worker threads */
+int rm_pool_init(unifyfs_cfg_t* cfg);
+
+/* stop and join the request manager worker threads */
+int rm_pool_fini(void);
 
-/* functions called by rpc handlers to assign work
- * to request manager threads */
-int rm_cmd_mread(int app_id, int client_id,
-                 size_t req_num, void* reqbuf);
+/* returns id of the doorbell clients ring after posting to their
+ * request ring, or -1 if there is none */
+int rm_ring_bell_id(void);
 
-int rm_cmd_read(int app_id, int client_id, int gfid,
+/* functions called to assign work to request manager threads */
+int rm_cmd_read(int app_id, int client_id, uint64_t gfid,
                 size_t offset, size_t length);
 
-int rm_cmd_filesize(int app_id, int client_id, int gfid, size_t* outsize);
+int rm_cmd_filesize(int app_id, int client_id, uint64_t gfid,
+                    size_t* outsize);
 
-/* function called by main thread to instruct
- * resource manager thread to exit,
+/* function called by main thread to stop serving a client,
  * returns UNIFYFS_SUCCESS on success */
 int rm_cmd_exit(reqmgr_thrd_t* thrd_ctrl);
 
@@ -119,9 +188,24 @@ int rm_cmd_exit(reqmgr_thrd_t* thrd_ctrl);
  * synchronize all the indices and file attributes
  * to the key-value store
  * @param sock_id: the connection id in poll_set of the delegator
+ * @param async: publish in the background after copying metadata
  * @return success/error code
  */
-int rm_cmd_fsync(int app_id, int client_side_id, int gfid);
+int rm_cmd_fsync(int app_id, int client_side_id, uint64_t gfid, int async);
+
+/* launch thread that publishes asynchronous fsync metadata */
+int rm_fsync_init(void);
+
+/* publish remaining asynchronous fsync metadata and join thread */
+int rm_fsync_fini(void);
+
+/* wait for asynchronous fsyncs of a client (or all clients if
+ * client_id is -1) to be published */
+int rm_fsync_wait(int app_id, int client_id);
+
+/* wait for asynchronous fsyncs of an app queued at any server
+ * to be published */
+int rm_fsync_flush_all(int app_id);
 
 /* update state for remote chunk reads with received response data */
 int rm_post_chunk_read_responses(int app_id,
@@ -132,7 +216,8 @@ int rm_post_chunk_read_responses(int app_id,
                                  size_t bulk_sz,
                                  char* resp_buf);
 
-/* process the requested chunk data returned from service managers */
+/* process the requested chunk data returned from service managers,
+ * called with the client shm_lock held and its thrd_lock not held */
 int rm_handle_chunk_read_responses(reqmgr_thrd_t* thrd_ctrl,
                                    server_read_req_t* rdreq,
                                    remote_chunk_reads_t* del_reads);
@@ -150,7 +235,9 @@ int invoke_server_request_rpc(int dst_srvr_rank,
 
 int invoke_chunk_read_request_rpc(int dst_srvr_rank,
                                   server_read_req_t* rdreq,
+                                  int win_ndx,
                                   int num_chunks,
-                                  void* data_buf, size_t buf_sz);
+                                  void* data_buf, size_t buf_sz,
+                                  size_t resp_sz);
 
 #endif
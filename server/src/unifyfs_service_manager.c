@@ -28,15 +28,52 @@
  */
 
 #include <aio.h>
+#include <sys/uio.h>
 #include <time.h>
 
 #include "unifyfs_global.h"
+#include "unifyfs_bufpool.h"
 #include "unifyfs_request_manager.h"
 #include "unifyfs_service_manager.h"
 #include "unifyfs_server_rpcs.h"
 #include "margo_server.h"
 
 
+/* max number of adjacent spillover reads merged into one preadv() */
+#define SPILL_READ_MAX_IOV 64
+
+/* read of a range of a client spillover file into a response buffer,
+ * a chunk read that starts in shared memory has its tail read here */
+typedef struct {
+    int fd;                  /* spillover file descriptor */
+    off_t offset;            /* offset within spillover file */
+    size_t length;           /* number of bytes to read */
+    char* buf;               /* destination buffer */
+    chunk_read_resp_t* resp; /* response updated with bytes read */
+} spill_read_t;
+
+/* tracks outstanding spill read batches of one chunk read request */
+typedef struct {
+    pthread_mutex_t sync;
+    pthread_cond_t cond;
+    int pending;
+} spill_wait_t;
+
+/* spill reads of adjacent file ranges, issued as a single preadv() */
+typedef struct spill_batch {
+    spill_read_t* reads;      /* first read of batch */
+    int count;                /* number of reads in batch */
+    spill_wait_t* wait;       /* signaled when batch completes */
+    struct spill_batch* next; /* next batch in worker queue */
+} spill_batch_t;
+
+/* chunk read responses queued for the SM thread to send */
+typedef struct sm_response {
+    remote_chunk_reads_t* rcr; /* chunk reads with response buffer */
+    uint64_t ready_ns;         /* time response was queued */
+    struct sm_response* next;  /* next response in queue */
+} sm_response_t;
+
 /* Service Manager (SM) state */
 typedef struct {
     /* the SM thread */
@@ -45,21 +82,64 @@ typedef struct {
     /* state synchronization mutex */
     pthread_mutex_t sync;
 
+    /* signaled when responses are queued or SM thread should exit */
+    pthread_cond_t cond;
+
     /* thread status */
     int initialized;
-    volatile int time_to_exit;
+    int time_to_exit;
 
     /* thread return status code */
     int sm_exit_rc;
 
-    /* list of chunk read requests from remote delegators */
-    arraylist_t* chunk_reads;
-
-    /* tracks running total of bytes in current read burst */
-    size_t burst_data_sz;
+    /* queue of chunk read responses for remote delegators */
+    sm_response_t* resp_head;
+    sm_response_t* resp_tail;
+
+    /* chunk read response latency histograms */
+    svcmgr_stats_t stats;
+
+    /* pool of threads serving spillover reads, batches are queued
+     * under spill_sync and workers wait on spill_cond */
+    pthread_t* spill_thrds;
+    int num_spill_thrds;
+    pthread_mutex_t spill_sync;
+    pthread_cond_t spill_cond;
+    spill_batch_t* spill_head;
+    spill_batch_t* spill_tail;
+    int spill_exit;
 } svcmgr_state_t;
 svcmgr_state_t* sm; // = NULL
 
+/* return current time in nanoseconds */
+static inline uint64_t sm_now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+/* record a latency in histogram, bucket i > 0 counts latencies
+ * of [2^(i-1), 2^i) microseconds, and bucket 0 those below 1 us */
+static void sm_latency_record(sm_latency_hist_t* hist, uint64_t ns)
+{
+    int b = 0;
+    uint64_t us = ns / 1000;
+    while (us && (b < (SM_LATENCY_BUCKETS - 1))) {
+        us >>= 1;
+        b++;
+    }
+    __atomic_add_fetch(&(hist->buckets[b]), 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&(hist->count), 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&(hist->total_ns), ns, __ATOMIC_RELAXED);
+    uint64_t max_ns = __atomic_load_n(&(hist->max_ns), __ATOMIC_RELAXED);
+    while ((ns > max_ns) &&
+           !__atomic_compare_exchange_n(&(hist->max_ns), &max_ns, ns, 0,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        /* max_ns updated with current value on failure, try again */
+    }
+}
+
 /* lock macro for debugging SM locking */
 #define SM_LOCK() \
 do { \
@@ -74,7 +154,201 @@ do { \
     pthread_mutex_unlock(&(sm->sync)); \
 } while (0)
 
-/* Decode and issue chunk-reads received from request manager
+/* order spill reads by file descriptor, then file offset */
+static int compare_spill_read(const void* a, const void* b)
+{
+    const spill_read_t* ra = a;
+    const spill_read_t* rb = b;
+    if (ra->fd != rb->fd) {
+        return (ra->fd < rb->fd) ? -1 : 1;
+    }
+    if (ra->offset != rb->offset) {
+        return (ra->offset < rb->offset) ? -1 : 1;
+    }
+    return 0;
+}
+
+/* read data for a batch of spill reads covering one contiguous range
+ * of a spillover file, and record bytes read in their responses */
+static void spill_batch_read(spill_batch_t* batch)
+{
+    struct iovec iov[SPILL_READ_MAX_IOV];
+    int i;
+    size_t total = 0;
+    for (i = 0; i < batch->count; i++) {
+        iov[i].iov_base = batch->reads[i].buf;
+        iov[i].iov_len  = batch->reads[i].length;
+        total += batch->reads[i].length;
+    }
+
+    /* read until done, handling short reads by advancing the vector */
+    int fd = batch->reads[0].fd;
+    off_t offset = batch->reads[0].offset;
+    struct iovec* vec = iov;
+    int vcnt = batch->count;
+    size_t nread = 0;
+    int err = 0;
+    while (nread < total) {
+        ssize_t n = preadv(fd, vec, vcnt, offset);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            err = errno;
+            break;
+        } else if (n == 0) {
+            /* end of file */
+            break;
+        }
+        nread  += (size_t)n;
+        offset += (off_t)n;
+        while ((vcnt > 0) && ((size_t)n >= vec->iov_len)) {
+            n -= vec->iov_len;
+            vec++;
+            vcnt--;
+        }
+        if (vcnt > 0) {
+            vec->iov_base = (char*)vec->iov_base + n;
+            vec->iov_len -= n;
+        }
+    }
+
+    /* split bytes read among the reads in order */
+    for (i = 0; i < batch->count; i++) {
+        spill_read_t* sread = batch->reads + i;
+        size_t got = sread->length;
+        if (nread < got) {
+            got = nread;
+        }
+        nread -= got;
+        if (err && (got < sread->length)) {
+            sread->resp->read_rc = (ssize_t)(-err);
+        } else {
+            sread->resp->read_rc += got;
+        }
+        if (got < sread->length) {
+            /* data past end of spill file reads as zeros */
+            memset(sread->buf + got, 0, sread->length - got);
+        }
+    }
+
+    /* tell request handler this batch is done */
+    spill_wait_t* wait = batch->wait;
+    pthread_mutex_lock(&(wait->sync));
+    wait->pending--;
+    if (wait->pending == 0) {
+        pthread_cond_signal(&(wait->cond));
+    }
+    pthread_mutex_unlock(&(wait->sync));
+}
+
+/* entry point for spillover read threads, serves queued batches
+ * until the service manager shuts down */
+static void* spill_read_thread(void* arg)
+{
+    pthread_mutex_lock(&(sm->spill_sync));
+    while (1) {
+        spill_batch_t* batch = sm->spill_head;
+        if (NULL == batch) {
+            if (sm->spill_exit) {
+                break;
+            }
+            pthread_cond_wait(&(sm->spill_cond), &(sm->spill_sync));
+            continue;
+        }
+
+        /* dequeue batch and read it without holding the lock */
+        sm->spill_head = batch->next;
+        if (NULL == sm->spill_head) {
+            sm->spill_tail = NULL;
+        }
+        pthread_mutex_unlock(&(sm->spill_sync));
+        spill_batch_read(batch);
+        pthread_mutex_lock(&(sm->spill_sync));
+    }
+    pthread_mutex_unlock(&(sm->spill_sync));
+    return NULL;
+}
+
+/* sort spill reads, merge reads of adjacent file ranges into batches,
+ * and read them using the spill read threads, returns once all data
+ * has been read */
+static int sm_read_spill(spill_read_t* sreads, int num_sreads)
+{
+    qsort(sreads, num_sreads, sizeof(spill_read_t), compare_spill_read);
+
+    spill_batch_t* batches = (spill_batch_t*)
+        calloc(num_sreads, sizeof(spill_batch_t));
+    if (NULL == batches) {
+        LOGERR("failed to allocate spill read batches");
+        return (int)UNIFYFS_ERROR_NOMEM;
+    }
+
+    spill_wait_t wait;
+    pthread_mutex_init(&(wait.sync), NULL);
+    pthread_cond_init(&(wait.cond), NULL);
+
+    /* each batch holds reads of one file whose ranges abut */
+    int i;
+    int num_batches = 0;
+    spill_batch_t* batch = NULL;
+    for (i = 0; i < num_sreads; i++) {
+        spill_read_t* sread = sreads + i;
+        if ((NULL != batch) &&
+            (batch->count < SPILL_READ_MAX_IOV) &&
+            (sread->fd == batch->reads[0].fd)) {
+            spill_read_t* last = batch->reads + (batch->count - 1);
+            if (sread->offset == (last->offset + (off_t)last->length)) {
+                batch->count++;
+                continue;
+            }
+        }
+        batch = batches + num_batches;
+        batch->reads = sread;
+        batch->count = 1;
+        batch->wait  = &wait;
+        num_batches++;
+    }
+    wait.pending = num_batches;
+    LOGDBG("reading %d spill ranges in %d batches", num_sreads, num_batches);
+
+    /* queue all but the first batch for the read threads,
+     * then read the first batch ourselves */
+    if ((sm->num_spill_thrds > 0) && (num_batches > 1)) {
+        pthread_mutex_lock(&(sm->spill_sync));
+        for (i = 1; i < num_batches; i++) {
+            batch = batches + i;
+            if (NULL == sm->spill_tail) {
+                sm->spill_head = batch;
+            } else {
+                sm->spill_tail->next = batch;
+            }
+            sm->spill_tail = batch;
+        }
+        pthread_cond_broadcast(&(sm->spill_cond));
+        pthread_mutex_unlock(&(sm->spill_sync));
+        spill_batch_read(batches);
+    } else {
+        for (i = 0; i < num_batches; i++) {
+            spill_batch_read(batches + i);
+        }
+    }
+
+    /* wait for the read threads to finish our batches */
+    pthread_mutex_lock(&(wait.sync));
+    while (wait.pending > 0) {
+        pthread_cond_wait(&(wait.cond), &(wait.sync));
+    }
+    pthread_mutex_unlock(&(wait.sync));
+
+    pthread_cond_destroy(&(wait.cond));
+    pthread_mutex_destroy(&(wait.sync));
+    free(batches);
+    return (int)UNIFYFS_SUCCESS;
+}
+
+/* Decode chunk-reads received from request manager and read
+ * their data into a response buffer
  *
  * @param src_rank      : source delegator rank
  * @param src_app_id    : app id at source delegator
@@ -82,15 +356,19 @@ do { \
  * @param src_req_id    : request id at source delegator
  * @param num_chks      : number of chunk requests
  * @param msg_buf       : message buffer containing request(s)
+ * @param out_rcr       : chunk reads with filled response buffer
  * @return success/error code
  */
-int sm_issue_chunk_reads(int src_rank,
-                         int src_app_id,
-                         int src_client_id,
-                         int src_req_id,
-                         int num_chks,
-                         char* msg_buf)
+static int sm_read_chunks(int src_rank,
+                          int src_app_id,
+                          int src_client_id,
+                          int src_req_id,
+                          int num_chks,
+                          char* msg_buf,
+                          remote_chunk_reads_t** out_rcr)
 {
+    uint64_t start_ns = sm_now_ns();
+
     /* get pointer to start of receive buffer */
     char* ptr = msg_buf;
 
@@ -121,18 +399,44 @@ int sm_issue_chunk_reads(int src_rank,
     rcr->num_chunks = num_chks;
     rcr->reqs = NULL;
 
+    /* for requests from our own clients, data in the superblock of
+     * a local client is left in place, and the reading client copies
+     * it straight from that superblock into the user buffer */
+    int local_req = (src_rank == glb_pmi_rank);
+
+    int i;
+    int last_app = -1;
+    app_config_t* app_config = NULL;
+    if (local_req) {
+        for (i = 0; i < num_chks; i++) {
+            chunk_read_req_t* rreq = reqs + i;
+            if (rreq->log_app_id != last_app) {
+                app_config = (app_config_t*)
+                    arraylist_get(app_config_list, rreq->log_app_id);
+                assert(app_config);
+                last_app = rreq->log_app_id;
+            }
+            if ((rreq->log_offset + rreq->nbytes) <= app_config->data_size) {
+                total_data_sz -= rreq->nbytes;
+            }
+        }
+        last_app = -1;
+    }
+
     size_t resp_sz = sizeof(chunk_read_resp_t) * num_chks;
     size_t buf_sz = resp_sz + total_data_sz;
     rcr->total_sz = buf_sz;
 
-    // NOTE: calloc() is required here, don't use malloc
-    char* crbuf = (char*) calloc(1, buf_sz);
+    /* pooled buffer is not zeroed, every response field is set below,
+     * and data not filled by short spill reads is zeroed by them */
+    char* crbuf = (char*) bufpool_alloc(buf_sz);
     if (NULL == crbuf) {
         LOGERR("failed to allocate chunk_read_reqs");
         free(rcr);
         return UNIFYFS_ERROR_NOMEM;
     }
     chunk_read_resp_t* resp = (chunk_read_resp_t*)crbuf;
+    memset(resp, 0, resp_sz);
     rcr->resp = resp;
 
     char* databuf = crbuf + resp_sz;
@@ -140,12 +444,13 @@ int sm_issue_chunk_reads(int src_rank,
     LOGDBG("issuing %d requests, total data size = %zu",
            num_chks, total_data_sz);
 
+    /* spillover reads are collected and issued after the loop */
+    spill_read_t* sreads = NULL;
+    int num_sreads = 0;
+
     /* points to offset in read reply buffer */
     size_t buf_cursor = 0;
 
-    int i;
-    int last_app = -1;
-    app_config_t* app_config = NULL;
     for (i = 0; i < num_chks; i++) {
         chunk_read_req_t* rreq = reqs + i;
         chunk_read_resp_t* rresp = resp + i;
@@ -155,8 +460,10 @@ int sm_issue_chunk_reads(int src_rank,
         size_t offset = rreq->log_offset;
 
         /* record request metadata in response */
+        rresp->gfid = rreq->gfid;
         rresp->nbytes = size;
         rresp->offset = rreq->offset;
+        rresp->log_client_id = -1;
         LOGDBG("reading chunk(offset=%zu, size=%zu)", rreq->offset, size);
 
         /* get app id and client id for this read task,
@@ -170,6 +477,16 @@ int sm_issue_chunk_reads(int src_rank,
             assert(app_config);
             last_app = app_id;
         }
+
+        if (local_req && ((offset + size) <= app_config->data_size)) {
+            /* leave data in place, just describe where it is */
+            rresp->log_app_id = app_id;
+            rresp->log_client_id = cli_id;
+            rresp->log_offset = app_config->data_offset + offset;
+            rresp->read_rc = size;
+            continue;
+        }
+
         int spillfd = app_config->spill_log_fds[cli_id];
         char* log_ptr = app_config->shm_superblocks[cli_id] +
                         app_config->data_offset + offset;
@@ -196,35 +513,112 @@ int sm_issue_chunk_reads(int src_rank,
             rresp->read_rc = sz_from_mem;
         }
         if (sz_from_spill > 0) {
-            /* read data from spillover file */
-            ssize_t nread = pread(spillfd, (buf_ptr + sz_from_mem),
-                                  sz_from_spill, 0);
-            if (-1 == nread) {
-                rresp->read_rc = (ssize_t)(-errno);
-            } else {
-                rresp->read_rc += nread;
+            /* defer read of data from spillover file, offsets past
+             * the shared memory data region map into the spill file */
+            if (NULL == sreads) {
+                sreads = (spill_read_t*)
+                    calloc(num_chks, sizeof(spill_read_t));
+                if (NULL == sreads) {
+                    LOGERR("failed to allocate spill reads");
+                    bufpool_free(crbuf);
+                    free(rcr);
+                    return UNIFYFS_ERROR_NOMEM;
+                }
             }
+            spill_read_t* sread = sreads + num_sreads;
+            sread->fd     = spillfd;
+            sread->offset = (off_t)(offset + sz_from_mem -
+                                    app_config->data_size);
+            sread->length = sz_from_spill;
+            sread->buf    = buf_ptr + sz_from_mem;
+            sread->resp   = rresp;
+            num_sreads++;
         }
         buf_cursor += size;
+    }
 
-        /* update accounting for burst size */
-        sm->burst_data_sz += size;
+    if (num_sreads > 0) {
+        int rc = sm_read_spill(sreads, num_sreads);
+        free(sreads);
+        if (rc != (int)UNIFYFS_SUCCESS) {
+            bufpool_free(crbuf);
+            free(rcr);
+            return rc;
+        }
+    }
+
+    sm_latency_record(&(sm->stats.read), sm_now_ns() - start_ns);
+
+    *out_rcr = rcr;
+    return UNIFYFS_SUCCESS;
+}
+
+/* queue the chunk read responses for a remote server and wake up
+ * the SM thread to send them by response rpc, the responses are
+ * freed on failure
+ *
+ * @param rcr : chunk read responses
+ * @return success/error code
+ */
+static int sm_queue_chunk_responses(remote_chunk_reads_t* rcr)
+{
+    sm_response_t* smr = (sm_response_t*) calloc(1, sizeof(sm_response_t));
+    if (NULL == smr) {
+        LOGERR("failed to allocate chunk read response");
+        bufpool_free(rcr->resp);
+        free(rcr);
+        return UNIFYFS_ERROR_NOMEM;
+    }
+    smr->rcr = rcr;
+    smr->ready_ns = sm_now_ns();
+    LOGDBG("adding to svcmgr responses");
+    assert(NULL != sm);
+    SM_LOCK();
+    if (NULL == sm->resp_tail) {
+        sm->resp_head = smr;
+    } else {
+        sm->resp_tail->next = smr;
+    }
+    sm->resp_tail = smr;
+    pthread_cond_signal(&(sm->cond));
+    SM_UNLOCK();
+    return UNIFYFS_SUCCESS;
+}
+
+/* Decode and issue chunk-reads received from request manager,
+ * the responses are sent back by the SM thread, or handed to the
+ * request manager directly for our own requests
+ *
+ * @param src_rank      : source delegator rank
+ * @param src_app_id    : app id at source delegator
+ * @param src_client_id : client id at source delegator
+ * @param src_req_id    : request id at source delegator
+ * @param num_chks      : number of chunk requests
+ * @param msg_buf       : message buffer containing request(s)
+ * @return success/error code
+ */
+int sm_issue_chunk_reads(int src_rank,
+                         int src_app_id,
+                         int src_client_id,
+                         int src_req_id,
+                         int num_chks,
+                         char* msg_buf)
+{
+    remote_chunk_reads_t* rcr = NULL;
+    int rc = sm_read_chunks(src_rank, src_app_id, src_client_id,
+                            src_req_id, num_chks, msg_buf, &rcr);
+    if (rc != (int)UNIFYFS_SUCCESS) {
+        return rc;
     }
 
     if (src_rank != glb_pmi_rank) {
-        /* add chunk_reads to svcmgr response list */
-        LOGDBG("adding to svcmgr chunk_reads");
-        assert(NULL != sm);
-        SM_LOCK();
-        arraylist_add(sm->chunk_reads, rcr);
-        SM_UNLOCK();
-        LOGDBG("done adding to svcmgr chunk_reads");
-        return UNIFYFS_SUCCESS;
+        return sm_queue_chunk_responses(rcr);
     } else { /* response is for myself */
         LOGDBG("responding to myself");
-        int rc = rm_post_chunk_read_responses(src_app_id, src_client_id,
-                                              src_rank, src_req_id,
-                                              num_chks, buf_sz, crbuf);
+        rc = rm_post_chunk_read_responses(src_app_id, src_client_id,
+                                          src_rank, src_req_id,
+                                          rcr->num_chunks, rcr->total_sz,
+                                          (char*)rcr->resp);
         if (rc != (int)UNIFYFS_SUCCESS) {
             LOGERR("failed to handle chunk read responses");
         }
@@ -234,8 +628,80 @@ int sm_issue_chunk_reads(int src_rank,
     }
 }
 
+/* Read chunks for a request whose responses are pushed by bulk
+ * transfer straight into the buffer exposed by the requesting
+ * server, rather than being sent by a response rpc. If the push
+ * fails, the responses are sent by response rpc instead and
+ * pushed_sz is left zero.
+ *
+ * @param mid       : margo instance of request rpc
+ * @param dst_addr  : address of requesting server
+ * @param in        : chunk read request rpc input
+ * @param msg_buf   : message buffer containing request(s)
+ * @param pushed_sz : size of pushed responses
+ * @return success/error code
+ */
+static int sm_push_chunk_reads(margo_instance_id mid,
+                               hg_addr_t dst_addr,
+                               chunk_read_request_in_t* in,
+                               char* msg_buf,
+                               hg_size_t* pushed_sz)
+{
+    *pushed_sz = 0;
+
+    remote_chunk_reads_t* rcr = NULL;
+    int rc = sm_read_chunks((int)in->src_rank, (int)in->app_id,
+                            (int)in->client_id, (int)in->req_id,
+                            (int)in->num_chks, msg_buf, &rcr);
+    if (rc != (int)UNIFYFS_SUCCESS) {
+        return rc;
+    }
+
+    void* buf = (void*)rcr->resp;
+    hg_size_t buf_sz = (hg_size_t)rcr->total_sz;
+    if (buf_sz > in->resp_size) {
+        LOGERR("chunk read responses (%zu bytes) exceed target "
+               "buffer (%zu bytes)", (size_t)buf_sz, (size_t)in->resp_size);
+        rc = (int)UNIFYFS_FAILURE;
+    } else {
+        /* push responses into target buffer */
+        uint64_t push_ns = sm_now_ns();
+        hg_bulk_t bulk_handle;
+        hg_return_t hret = margo_bulk_create(mid, 1, &buf, &buf_sz,
+                                             HG_BULK_READ_ONLY,
+                                             &bulk_handle);
+        if (hret == HG_SUCCESS) {
+            hret = margo_bulk_transfer(mid, HG_BULK_PUSH, dst_addr,
+                                       in->resp_handle, 0,
+                                       bulk_handle, 0, buf_sz);
+            margo_bulk_free(bulk_handle);
+        }
+        sm_latency_record(&(sm->stats.send), sm_now_ns() - push_ns);
+        if (hret != HG_SUCCESS) {
+            LOGERR("failed to push chunk read responses to server %d",
+                   (int)in->src_rank);
+            rc = (int)UNIFYFS_FAILURE;
+        } else {
+            *pushed_sz = buf_sz;
+        }
+    }
+
+    if (rc != (int)UNIFYFS_SUCCESS) {
+        /* fall back to sending the responses we already read by
+         * response rpc, the requester waits for them when nothing
+         * was pushed */
+        LOGDBG("sending chunk read responses to server %d by rpc",
+               (int)in->src_rank);
+        return sm_queue_chunk_responses(rcr);
+    }
+
+    bufpool_free(rcr->resp);
+    free(rcr);
+    return rc;
+}
+
 /* initialize and launch service manager thread */
-int svcmgr_init(void)
+int svcmgr_init(unifyfs_cfg_t* cfg)
 {
     sm = (svcmgr_state_t*)calloc(1, sizeof(svcmgr_state_t));
     if (NULL == sm) {
@@ -243,26 +709,48 @@ int svcmgr_init(void)
         return (int)UNIFYFS_ERROR_NOMEM;
     }
 
-    /* tracks how much data we process in each burst */
-    sm->burst_data_sz = 0;
-
-    /* allocate a list to track chunk read requests */
-    sm->chunk_reads = arraylist_create();
-    if (sm->chunk_reads == NULL) {
-        LOGERR("failed to allocate service manager chunk_reads!");
+    int rc = pthread_mutex_init(&(sm->sync), NULL);
+    if (0 != rc) {
+        LOGERR("failed to initialize service manager mutex!");
         svcmgr_fini();
-        return (int)UNIFYFS_ERROR_NOMEM;
+        return (int)UNIFYFS_ERROR_THRDINIT;
     }
 
-    int rc = pthread_mutex_init(&(sm->sync), NULL);
+    rc = pthread_cond_init(&(sm->cond), NULL);
     if (0 != rc) {
-        LOGERR("failed to initialize service manager mutex!");
+        LOGERR("failed to initialize service manager condition!");
+        pthread_mutex_destroy(&(sm->sync));
         svcmgr_fini();
         return (int)UNIFYFS_ERROR_THRDINIT;
     }
 
     sm->initialized = 1;
 
+    /* launch threads serving spillover reads */
+    pthread_mutex_init(&(sm->spill_sync), NULL);
+    pthread_cond_init(&(sm->spill_cond), NULL);
+    long num_thrds = UNIFYFS_SPILLOVER_READ_THREADS;
+    configurator_int_val(cfg->spillover_read_threads, &num_thrds);
+    if (num_thrds > 0) {
+        sm->spill_thrds = (pthread_t*) calloc(num_thrds, sizeof(pthread_t));
+        if (NULL == sm->spill_thrds) {
+            LOGERR("failed to allocate spill read threads!");
+            svcmgr_fini();
+            return (int)UNIFYFS_ERROR_NOMEM;
+        }
+        int i;
+        for (i = 0; i < (int)num_thrds; i++) {
+            rc = pthread_create(&(sm->spill_thrds[i]), NULL,
+                                spill_read_thread, NULL);
+            if (rc != 0) {
+                LOGERR("failed to create spill read thread");
+                svcmgr_fini();
+                return (int)UNIFYFS_ERROR_THRDINIT;
+            }
+            sm->num_spill_thrds++;
+        }
+    }
+
     rc = pthread_create(&(sm->thrd), NULL,
                         sm_service_reads, (void*)sm);
     if (rc != 0) {
@@ -279,17 +767,41 @@ int svcmgr_fini(void)
 {
     if (NULL != sm) {
         if (sm->thrd) {
+            SM_LOCK();
             sm->time_to_exit = 1;
+            pthread_cond_signal(&(sm->cond));
+            SM_UNLOCK();
             pthread_join(sm->thrd, NULL);
         }
+
+        /* stop spill read threads once they drain their queue */
         if (sm->initialized) {
-            SM_LOCK();
+            pthread_mutex_lock(&(sm->spill_sync));
+            sm->spill_exit = 1;
+            pthread_cond_broadcast(&(sm->spill_cond));
+            pthread_mutex_unlock(&(sm->spill_sync));
+            int i;
+            for (i = 0; i < sm->num_spill_thrds; i++) {
+                pthread_join(sm->spill_thrds[i], NULL);
+            }
+            free(sm->spill_thrds);
+            pthread_cond_destroy(&(sm->spill_cond));
+            pthread_mutex_destroy(&(sm->spill_sync));
         }
 
-        arraylist_free(sm->chunk_reads);
+        /* drop any responses that were not sent */
+        while (NULL != sm->resp_head) {
+            sm_response_t* smr = sm->resp_head;
+            sm->resp_head = smr->next;
+            bufpool_free(smr->rcr->resp);
+            free(smr->rcr);
+            free(smr);
+        }
+        sm->resp_tail = NULL;
 
         if (sm->initialized) {
-            SM_UNLOCK();
+            svcmgr_log_stats();
+            pthread_cond_destroy(&(sm->cond));
             pthread_mutex_destroy(&(sm->sync));
         }
 
@@ -299,35 +811,11 @@ int svcmgr_fini(void)
     return (int)UNIFYFS_SUCCESS;
 }
 
-/* iterate over list of chunk reads and send responses */
-static int send_chunk_read_responses(void)
-{
-    int rc = (int)UNIFYFS_SUCCESS;
-    arraylist_t* chunk_reads = NULL;
-    pthread_mutex_lock(&(sm->sync));
-    int num_chunk_reads = arraylist_size(sm->chunk_reads);
-    if (num_chunk_reads) {
-        LOGDBG("processing %d chunk read responses", num_chunk_reads);
-        chunk_reads = sm->chunk_reads;
-        sm->chunk_reads = arraylist_create();
-    }
-    pthread_mutex_unlock(&(sm->sync));
-    for (int i = 0; i < num_chunk_reads; i++) {
-        /* get data structure */
-        remote_chunk_reads_t* rcr = (remote_chunk_reads_t*)
-            arraylist_get(chunk_reads, i);
-        rc = invoke_chunk_read_response_rpc(rcr);
-    }
-    if (NULL != chunk_reads) {
-        arraylist_free(chunk_reads);
-    }
-    return rc;
-}
-
 /* Entry point for service manager thread. The SM thread
- * runs in a loop processing read request replies until
- * the main server thread asks it to exit. The read requests
- * themselves are handled by Margo RPC threads.
+ * waits for chunk read responses to be queued by the Margo RPC
+ * threads that handle the read requests, and sends each response
+ * as soon as it is ready, until the main server thread asks it
+ * to exit.
  *
  * @param arg: pointer to SM thread control structure
  * @return NULL */
@@ -338,47 +826,39 @@ void* sm_service_reads(void* arg)
     LOGDBG("I am service manager thread!");
     assert(sm == (svcmgr_state_t*)arg);
 
-    /* handle chunk reads until signaled to exit */
+    /* handle chunk read responses until signaled to exit */
+    SM_LOCK();
     while (1) {
-        rc = send_chunk_read_responses();
-        if (rc != UNIFYFS_SUCCESS) {
-            LOGERR("failed to send chunk read responses");
+        while ((NULL == sm->resp_head) && !sm->time_to_exit) {
+            pthread_cond_wait(&(sm->cond), &(sm->sync));
         }
-
-        pthread_mutex_lock(&(sm->sync));
-
-        if (sm->time_to_exit) {
-            pthread_mutex_unlock(&(sm->sync));
+        if (NULL == sm->resp_head) {
+            /* queue is drained and we've been told to exit */
             break;
         }
 
-#ifdef BURSTY_WAIT // REVISIT WHETHER BURSTY WAIT STILL DESIRABLE
-        /* determine how long to wait next time based on
-         * how much data we just processed in this burst */
-        size_t bursty_interval;
-        if (sm->burst_data_sz >= LARGE_BURSTY_DATA) {
-            /* for large bursts above a threshold,
-             * wait for a fixed amount of time */
-            bursty_interval = MAX_BURSTY_INTERVAL;
-        } else {
-            /* for smaller bursts, set delay proportionally
-             * to burst size we just processed */
-            bursty_interval =
-                (SLEEP_SLICE_PER_UNIT * sm->burst_data_sz) / MIB;
-        }
-        if (bursty_interval > MIN_SLEEP_INTERVAL) {
-            usleep(SLEEP_INTERVAL); /* wait an interval */
+        /* dequeue next response */
+        sm_response_t* smr = sm->resp_head;
+        sm->resp_head = smr->next;
+        if (NULL == sm->resp_head) {
+            sm->resp_tail = NULL;
         }
-#else
-        /* wait an interval */
-        usleep(MIN_SLEEP_INTERVAL);
-#endif // REVISIT WHETHER BURSTY WAIT STILL DESIRABLE
+        SM_UNLOCK();
 
-        /* reset our burst size counter */
-        sm->burst_data_sz = 0;
+        /* send response, the response buffer is freed by the rpc */
+        uint64_t send_ns = sm_now_ns();
+        sm_latency_record(&(sm->stats.wait), send_ns - smr->ready_ns);
+        rc = invoke_chunk_read_response_rpc(smr->rcr);
+        if (rc != UNIFYFS_SUCCESS) {
+            LOGERR("failed to send chunk read responses");
+        }
+        sm_latency_record(&(sm->stats.send), sm_now_ns() - send_ns);
+        free(smr->rcr);
+        free(smr);
 
-        pthread_mutex_unlock(&(sm->sync));
+        SM_LOCK();
     }
+    SM_UNLOCK();
 
     LOGDBG("service manager thread exiting");
 
@@ -386,6 +866,74 @@ void* sm_service_reads(void* arg)
     return NULL;
 }
 
+/* copy current chunk read response latency histograms into stats */
+void svcmgr_get_stats(svcmgr_stats_t* stats)
+{
+    if ((NULL == stats) || (NULL == sm)) {
+        return;
+    }
+    sm_latency_hist_t* src[3] = {
+        &(sm->stats.read), &(sm->stats.wait), &(sm->stats.send)
+    };
+    sm_latency_hist_t* dst[3] = {
+        &(stats->read), &(stats->wait), &(stats->send)
+    };
+    int h, b;
+    for (h = 0; h < 3; h++) {
+        dst[h]->count = __atomic_load_n(&(src[h]->count), __ATOMIC_RELAXED);
+        dst[h]->total_ns = __atomic_load_n(&(src[h]->total_ns),
+                                           __ATOMIC_RELAXED);
+        dst[h]->max_ns = __atomic_load_n(&(src[h]->max_ns),
+                                         __ATOMIC_RELAXED);
+        for (b = 0; b < SM_LATENCY_BUCKETS; b++) {
+            dst[h]->buckets[b] = __atomic_load_n(&(src[h]->buckets[b]),
+                                                 __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/* write one latency histogram to log */
+static void sm_latency_log(const char* name, sm_latency_hist_t* hist)
+{
+    if (0 == hist->count) {
+        return;
+    }
+    LOGDBG("svcmgr %s latency: count=%llu avg=%lluns max=%lluns",
+           name,
+           (unsigned long long) hist->count,
+           (unsigned long long) (hist->total_ns / hist->count),
+           (unsigned long long) hist->max_ns);
+    int b;
+    for (b = 0; b < SM_LATENCY_BUCKETS; b++) {
+        if (0 == hist->buckets[b]) {
+            continue;
+        }
+        if (0 == b) {
+            LOGDBG("svcmgr %s latency:        < 1us : %llu", name,
+                   (unsigned long long) hist->buckets[b]);
+        } else if (b == (SM_LATENCY_BUCKETS - 1)) {
+            LOGDBG("svcmgr %s latency: >= %8lluus : %llu", name,
+                   (1ULL << (b - 1)),
+                   (unsigned long long) hist->buckets[b]);
+        } else {
+            LOGDBG("svcmgr %s latency:  < %8lluus : %llu", name,
+                   (1ULL << b),
+                   (unsigned long long) hist->buckets[b]);
+        }
+    }
+}
+
+/* write chunk read response latency histograms to log */
+void svcmgr_log_stats(void)
+{
+    svcmgr_stats_t stats;
+    memset(&stats, 0, sizeof(stats));
+    svcmgr_get_stats(&stats);
+    sm_latency_log("read", &(stats.read));
+    sm_latency_log("queue", &(stats.wait));
+    sm_latency_log("send", &(stats.send));
+}
+
 /* BEGIN MARGO SERVER-SERVER RPC INVOCATION FUNCTIONS */
 
 /* invokes the chunk_read_response rpc */
@@ -443,8 +991,8 @@ int invoke_chunk_read_response_rpc(remote_chunk_reads_t* rcr)
     margo_bulk_free(in.bulk_handle);
     margo_destroy(handle);
 
-    /* free response data buffer */
-    free(data_buf);
+    /* return response data buffer to pool */
+    bufpool_free(data_buf);
     rcr->resp = NULL;
 
     return rc;
@@ -615,12 +1163,19 @@ static void chunk_read_request_rpc(hg_handle_t handle)
         }
     }
     /* verify this is a request for data */
+    out.resp_size = 0;
     if (reqcmd == (int)SVC_CMD_RDREQ_CHK) {
         LOGDBG("request command: SVC_CMD_RDREQ_CHK");
         /* chunk read request */
-        sm_issue_chunk_reads(src_rank, app_id, client_id, req_id,
-                             num_chks, (char*)reqbuf);
-        ret = (int32_t)UNIFYFS_SUCCESS;
+        if (in.resp_size > 0) {
+            ret = (int32_t)sm_push_chunk_reads(mid, hgi->addr, &in,
+                                               (char*)reqbuf,
+                                               &out.resp_size);
+        } else {
+            sm_issue_chunk_reads(src_rank, app_id, client_id, req_id,
+                                 num_chks, (char*)reqbuf);
+            ret = (int32_t)UNIFYFS_SUCCESS;
+        }
     } else {
         LOGERR("invalid chunk read request command %d from server %d",
                reqcmd, src_rank);
@@ -32,15 +32,41 @@
 
 #include "unifyfs_global.h"
 
+/* number of log2 microsecond buckets in latency histograms */
+#define SM_LATENCY_BUCKETS 24
+
+/* latency histogram, bucket i > 0 counts latencies of
+ * [2^(i-1), 2^i) us, bucket 0 counts those below 1 us,
+ * and the last bucket counts all larger latencies */
+typedef struct {
+    uint64_t count;
+    uint64_t total_ns;
+    uint64_t max_ns;
+    uint64_t buckets[SM_LATENCY_BUCKETS];
+} sm_latency_hist_t;
+
+/* chunk read response latencies of service manager */
+typedef struct {
+    sm_latency_hist_t read; /* request received to response ready */
+    sm_latency_hist_t wait; /* response ready to start of send */
+    sm_latency_hist_t send; /* response rpc */
+} svcmgr_stats_t;
+
 /* service manager pthread routine */
 void* sm_service_reads(void* ctx);
 
 /* initialize and launch service manager */
-int svcmgr_init(void);
+int svcmgr_init(unifyfs_cfg_t* cfg);
 
 /* join service manager thread and cleanup its state */
 int svcmgr_fini(void);
 
+/* copy current chunk read response latency histograms into stats */
+void svcmgr_get_stats(svcmgr_stats_t* stats);
+
+/* write chunk read response latency histograms to log */
+void svcmgr_log_stats(void);
+
 /* decode and issue chunk reads contained in message buffer */
 int sm_issue_chunk_reads(int src_rank,
                          int src_app_id,
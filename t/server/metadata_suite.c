@@ -33,6 +33,7 @@ int main(int argc, char* argv[])
     // keep the following two calls in order
     unifyfs_set_file_attribute_test();
     unifyfs_get_file_attribute_test();
+    unifyfs_large_gfid_file_attribute_test();
 
 
     /*
@@ -1,3 +1,4 @@
+#include <inttypes.h>
 #include <sys/types.h>
 
 #include "metadata_suite.h"
@@ -9,6 +10,10 @@
 #define TEST_META_FID_VALUE  0xfeed
 #define TEST_META_FILE "/unifyfs/filename/to/nowhere"
 
+/* gfids are 64-bit hashes, so exercise a key past the 31-bit slice range */
+#define TEST_META_LARGE_GFID_VALUE 0xFEDCBA9876543210ULL
+#define TEST_META_LARGE_FILE "/unifyfs/filename/to/somewhere"
+
 int unifyfs_set_file_attribute_test(void)
 {
     int rc;
@@ -37,8 +42,40 @@ int unifyfs_get_file_attribute_test(void)
         TEST_META_GFID_VALUE == fattr.gfid &&
         TEST_META_FID_VALUE == fattr.fid &&
         (0 == strcmp(fattr.filename, TEST_META_FILE)),
-        "Retrieve file attributes (rc = %d, gfid = 0x%02X, fid = 0x%02X)",
-        rc, fattr.gfid, fattr.fid
+        "Retrieve file attributes (rc = %d, gfid = 0x%02" PRIX64
+        ", fid = 0x%02X)", rc, fattr.gfid, fattr.fid
+    );
+    return 0;
+}
+
+int unifyfs_large_gfid_file_attribute_test(void)
+{
+    int rc;
+    unifyfs_file_attr_t fattr = {0};
+
+    fattr.gfid = TEST_META_LARGE_GFID_VALUE;
+    fattr.fid = TEST_META_FID_VALUE;
+    snprintf(fattr.filename, sizeof(fattr.filename), TEST_META_LARGE_FILE);
+
+    rc = unifyfs_set_file_attribute(&fattr);
+    ok(UNIFYFS_SUCCESS == rc,
+        "Stored file attribute with large gfid (rc = %d)", rc);
+
+    memset(&fattr, 0, sizeof(fattr));
+    rc = unifyfs_get_file_attribute(TEST_META_LARGE_GFID_VALUE, &fattr);
+    ok(UNIFYFS_SUCCESS == rc &&
+        TEST_META_LARGE_GFID_VALUE == fattr.gfid &&
+        (0 == strcmp(fattr.filename, TEST_META_LARGE_FILE)),
+        "Retrieve file attributes with large gfid (rc = %d, gfid = 0x%"
+        PRIX64 ")", rc, fattr.gfid
+    );
+
+    /* the small gfid stored earlier must still be distinct */
+    rc = unifyfs_get_file_attribute(TEST_META_GFID_VALUE, &fattr);
+    ok(UNIFYFS_SUCCESS == rc &&
+        TEST_META_GFID_VALUE == fattr.gfid &&
+        (0 == strcmp(fattr.filename, TEST_META_FILE)),
+        "Small gfid attributes unaffected (rc = %d)", rc
     );
     return 0;
 }
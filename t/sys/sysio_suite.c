@@ -83,6 +83,8 @@ int main(int argc, char* argv[])
 
     write_read_test(unifyfs_root);
 
+    writev_readv_test(unifyfs_root);
+
     MPI_Finalize();
 
     done_testing();
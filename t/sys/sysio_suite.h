@@ -47,4 +47,7 @@ int open64_test(char* unifyfs_root);
 
 int write_read_test(char* unifyfs_root);
 
+/* Tests for UNIFYFS_WRAP(writev), readv, pwritev and preadv */
+int writev_readv_test(char* unifyfs_root);
+
 #endif /* SYSIO_SUITE_H */
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2019, Lawrence Livermore National Security, LLC.
+ * Produced at the Lawrence Livermore National Laboratory.
+ *
+ * Copyright 2019, UT-Battelle, LLC.
+ *
+ * LLNL-CODE-741539
+ * All rights reserved.
+ *
+ * This is the license for UnifyFS.
+ * For details, see https://github.com/LLNL/UnifyFS.
+ * Please read https://github.com/LLNL/UnifyFS/LICENSE for full license text.
+ */
+
+ /*
+  * Test writev/readv/pwritev/preadv with more than one buffer
+  */
+#include <fcntl.h>
+#include <string.h>
+#include <errno.h>
+#include <linux/limits.h>
+#include <stdio.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "t/lib/tap.h"
+#include "t/lib/testutil.h"
+
+int writev_readv_test(char* unifyfs_root)
+{
+    char path[64];
+    char buf0[8], buf1[8], buf2[8];
+    char all[32];
+    struct iovec iov[3];
+    ssize_t rc;
+    int fd;
+
+    testutil_rand_path(path, sizeof(path), unifyfs_root);
+
+    fd = open(path, O_RDWR | O_CREAT, 0644);
+    ok(fd != -1, "%s: open(%s) (fd=%d): %s", __FILE__, path, fd,
+        strerror(errno));
+
+    /* Write three buffers in one call */
+    iov[0].iov_base = "abcd";
+    iov[0].iov_len  = 4;
+    iov[1].iov_base = "efghij";
+    iov[1].iov_len  = 6;
+    iov[2].iov_base = "klm";
+    iov[2].iov_len  = 3;
+    rc = writev(fd, iov, 3);
+    ok(rc == 13, "%s: writev() (rc=%zd): %s", __FILE__, rc, strerror(errno));
+
+    /* Overwrite the middle of the file at an explicit offset */
+    iov[0].iov_base = "XY";
+    iov[0].iov_len  = 2;
+    iov[1].iov_base = "Z";
+    iov[1].iov_len  = 1;
+    rc = pwritev(fd, iov, 2, 5);
+    ok(rc == 3, "%s: pwritev() (rc=%zd): %s", __FILE__, rc, strerror(errno));
+
+    rc = fsync(fd);
+    ok(rc == 0, "%s: fsync() (rc=%zd): %s", __FILE__, rc, strerror(errno));
+
+    /* Read the whole file back with one read */
+    memset(all, 0, sizeof(all));
+    rc = pread(fd, all, sizeof(all), 0);
+    ok(rc == 13, "%s: pread() (rc=%zd): %s", __FILE__, rc, strerror(errno));
+    is(all, "abcdeXYZijklm", "%s: pread() data matches", __FILE__);
+
+    /* Read it back into three buffers */
+    memset(buf0, 0, sizeof(buf0));
+    memset(buf1, 0, sizeof(buf1));
+    memset(buf2, 0, sizeof(buf2));
+    iov[0].iov_base = buf0;
+    iov[0].iov_len  = 3;
+    iov[1].iov_base = buf1;
+    iov[1].iov_len  = 7;
+    iov[2].iov_base = buf2;
+    iov[2].iov_len  = 7;
+    rc = preadv(fd, iov, 3, 0);
+    ok(rc == 13, "%s: preadv() (rc=%zd): %s", __FILE__, rc, strerror(errno));
+    is(buf0, "abc", "%s: preadv() first buffer matches", __FILE__);
+    is(buf1, "deXYZij", "%s: preadv() second buffer matches", __FILE__);
+    is(buf2, "klm", "%s: preadv() third buffer matches", __FILE__);
+
+    /* readv() reads from and advances the file position */
+    rc = lseek(fd, 4, SEEK_SET);
+    ok(rc == 4, "%s: lseek() (rc=%zd): %s", __FILE__, rc, strerror(errno));
+    memset(buf0, 0, sizeof(buf0));
+    memset(buf1, 0, sizeof(buf1));
+    iov[0].iov_base = buf0;
+    iov[0].iov_len  = 2;
+    iov[1].iov_base = buf1;
+    iov[1].iov_len  = 3;
+    rc = readv(fd, iov, 2);
+    ok(rc == 5, "%s: readv() (rc=%zd): %s", __FILE__, rc, strerror(errno));
+    is(buf0, "eX", "%s: readv() first buffer matches", __FILE__);
+    is(buf1, "YZi", "%s: readv() second buffer matches", __FILE__);
+
+    rc = lseek(fd, 0, SEEK_CUR);
+    ok(rc == 9, "%s: file position after readv() is %zd", __FILE__, rc);
+
+    close(fd);
+
+    return 0;
+}